@@ -0,0 +1,163 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <rsc/misc/langutils.h>
+#include <rsc/threading/OrderedQueueDispatcherPool.h>
+
+using namespace std;
+using namespace rsc::misc;
+using namespace rsc::threading;
+
+class Receiver {
+};
+
+typedef OrderedQueueDispatcherPool<int, Receiver> Pool;
+
+/**
+ * Counts deliveries and signals once all expected deliveries happened.
+ */
+class CountingHandler: public Pool::DeliveryHandler {
+public:
+
+    CountingHandler(const boost::uint64_t& expected) :
+            expected(expected), delivered(0) {
+    }
+
+    void deliver(boost::shared_ptr<Receiver>& /*receiver*/,
+            const int& /*message*/) {
+        if (delivered.fetch_add(1) + 1 == expected) {
+            boost::mutex::scoped_lock lock(mutex);
+            condition.notify_all();
+        }
+    }
+
+    void waitDone() {
+        boost::mutex::scoped_lock lock(mutex);
+        while (delivered.load() < expected) {
+            condition.wait(lock);
+        }
+    }
+
+private:
+
+    const boost::uint64_t expected;
+    boost::atomic<boost::uint64_t> delivered;
+    boost::mutex mutex;
+    boost::condition_variable condition;
+
+};
+
+/**
+ * Pushes @a messages messages to a pool with @a workers workers and
+ * @a receivers receivers and returns the achieved deliveries per second.
+ * The push duration is returned in @a pushMicros.
+ */
+double run(const Pool::SchedulingMode& mode, const Pool::MessageStorage& storage,
+        unsigned int workers, unsigned int receivers, unsigned int messages,
+        double& pushMicros) {
+
+    boost::shared_ptr<CountingHandler> handler(
+            new CountingHandler(boost::uint64_t(messages) * receivers));
+    Pool pool(workers, Pool::DeliveryHandlerPtr(handler));
+    pool.setSchedulingMode(mode);
+    pool.setMessageStorage(storage);
+    for (unsigned int i = 0; i < receivers; ++i) {
+        pool.registerReceiver(boost::shared_ptr<Receiver>(new Receiver));
+    }
+    pool.start();
+
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < messages; ++i) {
+        pool.push(i);
+    }
+    pushMicros = double(currentTimeMicros() - start) / messages;
+    handler->waitDone();
+    const boost::uint64_t duration = currentTimeMicros() - start;
+
+    pool.stop();
+
+    return double(messages) * receivers * 1000000.0
+            / double(max(duration, boost::uint64_t(1)));
+
+}
+
+/**
+ * Measures how OrderedQueueDispatcherPool scales with 1 to 32 workers and 1
+ * to 10000 receivers for all scheduling modes and message storages.
+ *
+ * Usage: DispatcherPoolBenchmark [deliveries per run]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int deliveries = 200000;
+    if (argc > 1) {
+        deliveries = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+
+    const Pool::SchedulingMode modes[] = { Pool::SCHEDULING_SHARED,
+            Pool::SCHEDULING_WORK_STEALING };
+    const char* modeNames[] = { "shared", "work-stealing" };
+    const Pool::MessageStorage storages[] = { Pool::STORAGE_PER_RECEIVER,
+            Pool::STORAGE_SHARED_LOG };
+    const char* storageNames[] = { "queues", "log" };
+
+    cout << setw(16) << left << "mode" << setw(8) << "storage" << setw(9)
+            << right << "workers" << setw(11) << "receivers" << setw(16)
+            << "deliveries/s" << setw(12) << "push us" << endl;
+
+    for (unsigned int workers = 1; workers <= 32; workers *= 2) {
+        for (unsigned int receivers = 1; receivers <= 10000; receivers *= 10) {
+            const unsigned int messages = max(deliveries / receivers, 1u);
+            for (unsigned int m = 0; m < 2; ++m) {
+                for (unsigned int s = 0; s < 2; ++s) {
+                    double pushMicros = 0;
+                    const double rate = run(modes[m], storages[s], workers,
+                            receivers, messages, pushMicros);
+                    cout << setw(16) << left << modeNames[m] << setw(8)
+                            << storageNames[s] << setw(9) << right
+                            << workers << setw(11) << receivers << setw(16)
+                            << fixed << setprecision(0) << rate << setw(12)
+                            << setprecision(2) << pushMicros << endl;
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,136 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <rsc/misc/langutils.h>
+#include <rsc/threading/Future.h>
+
+using namespace std;
+using namespace rsc::misc;
+using namespace rsc::threading;
+
+typedef boost::shared_ptr<Future<int> > FuturePtr;
+
+void report(const string& name, const boost::uint64_t& durationMicros,
+        const unsigned int& operations) {
+    cout << setw(24) << left << name << right << setw(12) << fixed
+            << setprecision(1)
+            << double(durationMicros) * 1000.0 / double(operations) << endl;
+}
+
+/**
+ * Measures #get on a completed future, which does not lock.
+ */
+void benchmarkCompletedGet(const unsigned int& operations) {
+    Future<int> future;
+    future.set(42);
+    volatile int sink = 0;
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < operations; ++i) {
+        sink += future.get();
+    }
+    report("get completed", currentTimeMicros() - start, operations);
+}
+
+/**
+ * Measures creating, completing and reading a future in one thread.
+ */
+void benchmarkSetGet(const unsigned int& operations) {
+    volatile int sink = 0;
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < operations; ++i) {
+        Future<int> future;
+        future.set(i);
+        sink += future.get();
+    }
+    report("create, set, get", currentTimeMicros() - start, operations);
+}
+
+void respond(const vector<FuturePtr>* requests,
+        const vector<FuturePtr>* replies) {
+    for (size_t i = 0; i < requests->size(); ++i) {
+        (*replies)[i]->set((*requests)[i]->get() + 1);
+    }
+}
+
+/**
+ * Measures the round trip of completing a future waited for by another
+ * thread which answers with another future.
+ */
+void benchmarkRoundTrip(const unsigned int& operations) {
+
+    vector<FuturePtr> requests;
+    vector<FuturePtr> replies;
+    for (unsigned int i = 0; i < operations; ++i) {
+        requests.push_back(FuturePtr(new Future<int>));
+        replies.push_back(FuturePtr(new Future<int>));
+    }
+
+    boost::thread responder(boost::bind(&respond, &requests, &replies));
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < operations; ++i) {
+        requests[i]->set(i);
+        replies[i]->get();
+    }
+    report("cross-thread round trip", currentTimeMicros() - start,
+            operations);
+    responder.join();
+
+}
+
+/**
+ * Measures the latency of Future operations.
+ *
+ * Usage: FutureBenchmark [operations]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int operations = 1000000;
+    if (argc > 1) {
+        operations = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+
+    cout << setw(24) << left << "operation" << right << setw(12) << "ns/op"
+            << endl;
+
+    benchmarkCompletedGet(operations);
+    benchmarkSetGet(operations);
+    benchmarkRoundTrip(std::min(operations, 100000u));
+
+    return EXIT_SUCCESS;
+
+}
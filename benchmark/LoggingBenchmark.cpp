@@ -0,0 +1,220 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <rsc/logging/BinaryLoggingSystem.h>
+#include <rsc/logging/Logger.h>
+#include <rsc/logging/LoggerProxy.h>
+#include <rsc/misc/langutils.h>
+
+using namespace std;
+using namespace rsc::logging;
+using namespace rsc::misc;
+
+static boost::atomic<boost::uint64_t> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, boost::memory_order_relaxed);
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) throw () {
+    free(memory);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* memory, size_t /*size*/) throw () {
+    free(memory);
+}
+#endif
+
+/**
+ * Discards all messages after touching them, like a backend writing them
+ * somewhere.
+ */
+class NullLogger: public Logger {
+public:
+
+    NullLogger() :
+            level(LEVEL_INFO), characters(0) {
+    }
+
+    Level getLevel() const {
+        return level;
+    }
+
+    void setLevel(const Level& level) {
+        this->level = level;
+    }
+
+    string getName() const {
+        return "null";
+    }
+
+    void setName(const string& /*name*/) {
+    }
+
+    void log(const Level& /*level*/, const string& msg) {
+        characters += msg.size();
+    }
+
+    void logView(const Level& /*level*/, const char* /*msg*/,
+            const size_t& length) {
+        characters += length;
+    }
+
+    Level level;
+    volatile size_t characters;
+
+};
+
+/**
+ * The formatting of the logging macros before they used MessageBuffer.
+ */
+#define STRINGSTREAM_RSCINFO(logger, msg) \
+    if (logger->isInfoEnabled()) { \
+        std::stringstream s; \
+        s << msg; \
+        logger->info(s.str()); \
+    }
+
+/**
+ * The level check of the logging macros before LoggerProxy cached the level.
+ */
+#define LOCKED_RSCDEBUG(proxy, msg) \
+    if (proxy->getLogger()->isDebugEnabled()) \
+        RSC_LOG_MESSAGE_(proxy, rsc::logging::Logger::LEVEL_DEBUG, msg)
+
+template<class Statement>
+void run(const string& name, const unsigned int& iterations,
+        Statement statement) {
+    const boost::uint64_t allocationsBefore = allocations.load();
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < iterations; ++i) {
+        statement(i);
+    }
+    const boost::uint64_t duration = currentTimeMicros() - start;
+    const boost::uint64_t allocated = allocations.load() - allocationsBefore;
+    cout << setw(24) << left << name << right << setw(12) << fixed
+            << setprecision(1) << double(duration) * 1000.0 / iterations
+            << setw(16) << setprecision(2) << double(allocated) / iterations
+            << endl;
+}
+
+boost::shared_ptr<NullLogger> logger(new NullLogger);
+
+void enabled(const unsigned int& i) {
+    RSCINFO(logger, "processed message " << i << " of " << "queue");
+}
+
+void enabledStringStream(const unsigned int& i) {
+    STRINGSTREAM_RSCINFO(logger, "processed message " << i << " of " << "queue");
+}
+
+void disabled(const unsigned int& i) {
+    RSCDEBUG(logger, "processed message " << i << " of " << "queue");
+}
+
+LoggerProxyPtr factoryLogger(
+        boost::dynamic_pointer_cast<LoggerProxy>(
+                Logger::getLogger("rsc.benchmark.logging")));
+
+void disabledFactory(const unsigned int& i) {
+    RSCDEBUG(factoryLogger, "processed message " << i << " of " << "queue");
+}
+
+void disabledFactoryLocked(const unsigned int& i) {
+    LOCKED_RSCDEBUG(factoryLogger,
+            "processed message " << i << " of " << "queue");
+}
+
+LoggerPtr binaryLogger;
+
+void enabledBinary(const unsigned int& i) {
+    RSCINFO(binaryLogger, "processed message " << i << " of " << "queue");
+}
+
+void oversized(const unsigned int& i) {
+    static const string payload(2 * MessageBuffer::CAPACITY, 'x');
+    RSCINFO(logger, payload << i);
+}
+
+/**
+ * Measures the cost of enabled and disabled log statements with a backend
+ * discarding the messages and with the binary logging system.
+ *
+ * Usage: LoggingBenchmark [iterations]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int iterations = 1000000;
+    if (argc > 1) {
+        iterations = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+
+    cout << setw(24) << left << "statement" << right << setw(12) << "ns/op"
+            << setw(16) << "allocs/op" << endl;
+
+    factoryLogger->setLevel(Logger::LEVEL_INFO);
+
+    run("disabled", iterations, &disabled);
+    run("disabled factory", iterations, &disabledFactory);
+    run("disabled factory locked", iterations, &disabledFactoryLocked);
+    run("enabled", iterations, &enabled);
+    run("enabled stringstream", iterations, &enabledStringStream);
+
+    const string binaryFile = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("rsc-logging-benchmark-%%%%.bin"))
+            .string();
+    {
+        BinaryLoggingSystem binary(binaryFile, iterations * 64 + 4096);
+        binaryLogger = binary.createLogger("rsc.benchmark.logging");
+        run("enabled binary", iterations, &enabledBinary);
+        binaryLogger.reset();
+    }
+    boost::filesystem::remove(binaryFile);
+
+    run("enabled oversized", iterations, &oversized);
+
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,252 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <rsc/misc/langutils.h>
+#include <rsc/threading/OrderedQueueDispatcherPool.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
+using namespace std;
+using namespace rsc::misc;
+using namespace rsc::threading;
+
+/**
+ * A receiver with some state which is updated on every delivery.
+ */
+class Receiver {
+public:
+
+    explicit Receiver(const unsigned int& stateSize) :
+            state(stateSize, 0) {
+    }
+
+    vector<boost::uint64_t> state;
+
+};
+
+typedef OrderedQueueDispatcherPool<int, Receiver> Pool;
+
+/**
+ * Touches the whole state of the receiver for every message.
+ */
+class StateHandler: public Pool::DeliveryHandler {
+public:
+
+    StateHandler(const boost::uint64_t& expected) :
+            expected(expected), delivered(0) {
+    }
+
+    void deliver(boost::shared_ptr<Receiver>& receiver, const int& message) {
+        vector<boost::uint64_t>& state = receiver->state;
+        for (size_t i = 0; i < state.size(); i += 8) {
+            state[i] += message;
+        }
+        if (delivered.fetch_add(1) + 1 == expected) {
+            boost::mutex::scoped_lock lock(mutex);
+            condition.notify_all();
+        }
+    }
+
+    void waitDone() {
+        boost::mutex::scoped_lock lock(mutex);
+        while (delivered.load() < expected) {
+            condition.wait(lock);
+        }
+    }
+
+private:
+
+    const boost::uint64_t expected;
+    boost::atomic<boost::uint64_t> delivered;
+    boost::mutex mutex;
+    boost::condition_variable condition;
+
+};
+
+/**
+ * Counts the hardware cache misses of this process and all threads created
+ * after construction. Reports -1 if counters are not available.
+ */
+class CacheMissCounter {
+public:
+
+    CacheMissCounter() :
+            fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    long long read() {
+#ifdef __linux__
+        long long count = 0;
+        if (fd >= 0 && ::read(fd, &count, sizeof(count)) == sizeof(count)) {
+            return count;
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int fd;
+
+};
+
+struct Result {
+    double deliveriesPerSecond;
+    long long cacheMisses;
+};
+
+Result run(const vector<unsigned int>& cpus, const bool& numaAware,
+        unsigned int workers, unsigned int receivers, unsigned int messages,
+        unsigned int stateSize) {
+
+    Result result;
+    // counts threads created from now on
+    CacheMissCounter counter;
+
+    boost::shared_ptr<StateHandler> handler(
+            new StateHandler(boost::uint64_t(messages) * receivers));
+    Pool pool(workers, Pool::DeliveryHandlerPtr(handler));
+    pool.setSchedulingMode(Pool::SCHEDULING_WORK_STEALING);
+    pool.setWorkerAffinity(cpus);
+    pool.setNumaAware(numaAware);
+    pool.setWorkerNamePrefix("bench-");
+    for (unsigned int i = 0; i < receivers; ++i) {
+        pool.registerReceiver(
+                boost::shared_ptr<Receiver>(new Receiver(stateSize)));
+    }
+    pool.start();
+
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < messages; ++i) {
+        pool.push(i);
+    }
+    handler->waitDone();
+    const boost::uint64_t duration = currentTimeMicros() - start;
+    pool.stop();
+
+    result.cacheMisses = counter.read();
+    result.deliveriesPerSecond = double(messages) * receivers * 1000000.0
+            / double(max(duration, boost::uint64_t(1)));
+    return result;
+
+}
+
+void print(const string& name, const Result& result) {
+    cout << setw(24) << left << name << setw(16) << right << fixed
+            << setprecision(0) << result.deliveriesPerSecond << setw(18);
+    if (result.cacheMisses < 0) {
+        cout << "n/a";
+    } else {
+        cout << result.cacheMisses;
+    }
+    cout << endl;
+}
+
+/**
+ * Compares unpinned workers with workers pinned to one CPU each, with and
+ * without NUMA-aware receiver placement. Each delivery touches the state of
+ * the receiver so that moving receivers between CPUs causes cache misses.
+ * Cache misses are counted with perf events on Linux if permitted.
+ *
+ * Usage: PlacementBenchmark [workers] [receivers] [messages] [state words]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int workers = max(boost::thread::hardware_concurrency(), 1u);
+    unsigned int receivers = 64;
+    unsigned int messages = 5000;
+    unsigned int stateSize = 4096;
+    if (argc > 1) {
+        workers = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+    if (argc > 2) {
+        receivers = boost::lexical_cast<unsigned int>(argv[2]);
+    }
+    if (argc > 3) {
+        messages = boost::lexical_cast<unsigned int>(argv[3]);
+    }
+    if (argc > 4) {
+        stateSize = boost::lexical_cast<unsigned int>(argv[4]);
+    }
+
+    vector<unsigned int> cpus;
+    const unsigned int numCpus = max(boost::thread::hardware_concurrency(), 1u);
+    for (unsigned int i = 0; i < workers; ++i) {
+        cpus.push_back(i % numCpus);
+    }
+
+    cout << workers << " workers, " << receivers << " receivers, "
+            << messages << " messages, " << stateSize * 8
+            << " bytes state per receiver" << endl;
+    cout << setw(24) << left << "placement" << setw(16) << right
+            << "deliveries/s" << setw(18) << "cache misses" << endl;
+
+    print("unpinned",
+            run(vector<unsigned int>(), false, workers, receivers, messages,
+                    stateSize));
+    print("pinned",
+            run(cpus, false, workers, receivers, messages, stateSize));
+    print("pinned, NUMA-aware",
+            run(cpus, true, workers, receivers, messages, stateSize));
+
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,151 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <rsc/misc/langutils.h>
+#include <rsc/threading/RingBufferQueue.h>
+#include <rsc/threading/SynchronizedQueue.h>
+
+using namespace std;
+using namespace rsc::misc;
+using namespace rsc::threading;
+
+/**
+ * Result of a single benchmark run.
+ */
+struct Result {
+    double messagesPerSecond;
+    boost::uint64_t latencyP50;
+    boost::uint64_t latencyP99;
+    boost::uint64_t latencyMax;
+};
+
+template<class Queue>
+void produce(Queue* queue, unsigned int messages) {
+    for (unsigned int i = 0; i < messages; ++i) {
+        queue->push(currentTimeMicros());
+    }
+}
+
+template<class Queue>
+void consume(Queue* queue, unsigned int messages,
+        vector<boost::uint64_t>* latencies) {
+    latencies->reserve(messages);
+    for (unsigned int i = 0; i < messages; ++i) {
+        const boost::uint64_t sent = queue->pop();
+        latencies->push_back(currentTimeMicros() - sent);
+    }
+}
+
+/**
+ * Runs @a pairs producer/consumer pairs on @a queue, each producer pushing
+ * @a messages timestamps which are popped by an arbitrary consumer.
+ */
+template<class Queue>
+Result run(Queue& queue, unsigned int pairs, unsigned int messages) {
+
+    vector<vector<boost::uint64_t> > latencies(pairs);
+
+    const boost::uint64_t start = currentTimeMicros();
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < pairs; ++i) {
+        threads.create_thread(
+                boost::bind(&consume<Queue>, &queue, messages,
+                        &latencies[i]));
+        threads.create_thread(
+                boost::bind(&produce<Queue>, &queue, messages));
+    }
+    threads.join_all();
+    const boost::uint64_t duration = currentTimeMicros() - start;
+
+    vector<boost::uint64_t> all;
+    all.reserve(pairs * messages);
+    for (unsigned int i = 0; i < pairs; ++i) {
+        all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    }
+    sort(all.begin(), all.end());
+
+    Result result;
+    result.messagesPerSecond = double(all.size()) * 1000000.0
+            / double(max(duration, boost::uint64_t(1)));
+    result.latencyP50 = all[all.size() / 2];
+    result.latencyP99 = all[(all.size() * 99) / 100];
+    result.latencyMax = all.back();
+    return result;
+
+}
+
+void print(const string& name, unsigned int pairs, const Result& result) {
+    cout << setw(20) << left << name << setw(6) << right << pairs
+            << setw(14) << fixed << setprecision(0)
+            << result.messagesPerSecond << setw(10) << result.latencyP50
+            << setw(10) << result.latencyP99 << setw(10)
+            << result.latencyMax << endl;
+}
+
+/**
+ * Compares the throughput and latency of SynchronizedQueue and
+ * RingBufferQueue for 1, 2, 4, 8 and 16 producer/consumer pairs.
+ *
+ * Usage: QueueBenchmark [messages per producer]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int messages = 100000;
+    if (argc > 1) {
+        messages = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+
+    cout << setw(20) << left << "queue" << setw(6) << right << "pairs"
+            << setw(14) << "msgs/s" << setw(10) << "p50 us" << setw(10)
+            << "p99 us" << setw(10) << "max us" << endl;
+
+    for (unsigned int pairs = 1; pairs <= 16; pairs *= 2) {
+        {
+            SynchronizedQueue<boost::uint64_t> queue;
+            print("SynchronizedQueue", pairs, run(queue, pairs, messages));
+        }
+        {
+            // large enough to never drop so that consumers terminate
+            RingBufferQueue<boost::uint64_t> queue(pairs * messages);
+            print("RingBufferQueue", pairs, run(queue, pairs, messages));
+        }
+    }
+
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,236 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <rsc/misc/Histogram.h>
+#include <rsc/misc/langutils.h>
+#include <rsc/threading/PeriodicTask.h>
+#include <rsc/threading/PooledTaskExecutor.h>
+#include <rsc/threading/SimpleTask.h>
+#include <rsc/threading/ThreadedTaskExecutor.h>
+
+using namespace std;
+using namespace rsc::misc;
+using namespace rsc::threading;
+
+/**
+ * Collects the scheduling latencies of all tasks of a run.
+ */
+class LatencyRecorder {
+public:
+
+    explicit LatencyRecorder(const unsigned int& expected) :
+            expected(expected) {
+    }
+
+    void record(const boost::uint64_t& latency) {
+        boost::mutex::scoped_lock lock(mutex);
+        latencies.record(latency);
+        if (latencies.getCount() == expected) {
+            condition.notify_all();
+        }
+    }
+
+    void waitDone() {
+        boost::mutex::scoped_lock lock(mutex);
+        while (latencies.getCount() < expected) {
+            condition.wait(lock);
+        }
+    }
+
+    Histogram getLatencies() {
+        boost::mutex::scoped_lock lock(mutex);
+        return latencies;
+    }
+
+private:
+
+    const unsigned int expected;
+    boost::mutex mutex;
+    boost::condition condition;
+    Histogram latencies;
+
+};
+
+/**
+ * Records the time from when it should have started until it started.
+ */
+class LatencyTask: public SimpleTask {
+public:
+
+    LatencyTask(LatencyRecorder& recorder, const boost::uint64_t& due) :
+            recorder(recorder), due(due) {
+    }
+
+    void run() {
+        const boost::uint64_t now = currentTimeMicros();
+        recorder.record(now > due ? now - due : 0);
+        markDone();
+    }
+
+private:
+
+    LatencyRecorder& recorder;
+    const boost::uint64_t due;
+
+};
+
+/**
+ * A periodic task without work.
+ */
+class IdlePeriodicTask: public PeriodicTask {
+public:
+
+    explicit IdlePeriodicTask(const unsigned int& cycleTime) :
+            PeriodicTask(cycleTime) {
+    }
+
+    void execute() {
+    }
+
+};
+
+void runPeriodic(const string& name, TaskExecutor& executor,
+        const unsigned int& numTasks, const unsigned int& cycleTime) {
+
+    vector<boost::shared_ptr<PeriodicTask> > tasks;
+    for (unsigned int i = 0; i < numTasks; ++i) {
+        tasks.push_back(
+                boost::shared_ptr<PeriodicTask>(
+                        new IdlePeriodicTask(cycleTime)));
+        executor.schedule(tasks.back());
+    }
+    boost::this_thread::sleep(boost::posix_time::seconds(1));
+    Histogram jitter;
+    for (unsigned int i = 0; i < numTasks; ++i) {
+        tasks[i]->cancel();
+        tasks[i]->waitDone();
+        jitter.merge(tasks[i]->getJitter());
+    }
+
+    cout << setw(22) << left << name << setw(10) << right << numTasks
+            << setw(10) << cycleTime * 1000 << setw(14) << jitter.getCount()
+            << setw(14) << "" << setw(14) << fixed << setprecision(0)
+            << jitter.getMean() << setw(14) << jitter.getQuantile(0.99)
+            << endl;
+
+}
+
+void run(const string& name, TaskExecutor& executor,
+        const unsigned int& numTasks, const boost::uint64_t& delayMus) {
+
+    LatencyRecorder recorder(numTasks);
+    const boost::uint64_t start = currentTimeMicros();
+    for (unsigned int i = 0; i < numTasks; ++i) {
+        TaskPtr task(
+                new LatencyTask(recorder, currentTimeMicros() + delayMus));
+        executor.schedule(task, delayMus);
+    }
+    const boost::uint64_t scheduled = currentTimeMicros();
+    recorder.waitDone();
+    const boost::uint64_t duration = currentTimeMicros() - start;
+
+    const Histogram latencies = recorder.getLatencies();
+    cout << setw(22) << left << name << setw(10) << right << numTasks
+            << setw(10) << delayMus << setw(14) << fixed << setprecision(0)
+            << numTasks * 1000000.0 / max(duration, boost::uint64_t(1))
+            << setw(14) << setprecision(2)
+            << double(scheduled - start) / numTasks << setw(14)
+            << setprecision(0) << latencies.getMean() << setw(14)
+            << latencies.getQuantile(0.99) << endl;
+
+}
+
+/**
+ * Compares ThreadedTaskExecutor with PooledTaskExecutor for immediate and
+ * delayed tasks. Reports tasks per second until all tasks ran, the time to
+ * schedule a task and the latency from the intended start until the task
+ * ran. Afterwards, periodic tasks run for one second and the number of
+ * iterations and their jitter are reported.
+ *
+ * Usage: TaskExecutorBenchmark [tasks] [delay us]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int numTasks = 5000;
+    boost::uint64_t delay = 10000;
+    if (argc > 1) {
+        numTasks = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+    if (argc > 2) {
+        delay = boost::lexical_cast<boost::uint64_t>(argv[2]);
+    }
+
+    const unsigned int cores = max(boost::thread::hardware_concurrency(), 1u);
+
+    cout << setw(22) << left << "executor" << setw(10) << right << "tasks"
+            << setw(10) << "delay us" << setw(14) << "tasks/s" << setw(14)
+            << "schedule us" << setw(14) << "mean lat us" << setw(14)
+            << "p99 lat us" << endl;
+
+    const boost::uint64_t delays[] = { 0, delay };
+    for (unsigned int d = 0; d < 2; ++d) {
+        {
+            ThreadedTaskExecutor executor;
+            run("threaded", executor, numTasks, delays[d]);
+        }
+        {
+            PooledTaskExecutor executor(cores);
+            run("pooled fixed", executor, numTasks, delays[d]);
+        }
+        {
+            PooledTaskExecutor executor(1, 4 * cores);
+            run("pooled elastic", executor, numTasks, delays[d]);
+        }
+    }
+
+    cout << endl << setw(22) << left << "executor" << setw(10) << right
+            << "periodic" << setw(10) << "cycle us" << setw(14)
+            << "iterations" << setw(14) << "" << setw(14) << "mean jit us"
+            << setw(14) << "p99 jit us" << endl;
+    const unsigned int numPeriodic = 200;
+    {
+        ThreadedTaskExecutor executor;
+        runPeriodic("threaded", executor, numPeriodic, 10);
+    }
+    {
+        PooledTaskExecutor executor(cores);
+        runPeriodic("pooled fixed", executor, numPeriodic, 10);
+    }
+
+    return EXIT_SUCCESS;
+
+}
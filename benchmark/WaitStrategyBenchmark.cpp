@@ -0,0 +1,121 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <rsc/misc/langutils.h>
+#include <rsc/threading/SynchronizedQueue.h>
+
+using namespace std;
+using namespace rsc::misc;
+using namespace rsc::threading;
+
+template<class Queue>
+void consume(Queue* queue, unsigned int messages,
+        vector<boost::uint64_t>* latencies) {
+    latencies->reserve(messages);
+    for (unsigned int i = 0; i < messages; ++i) {
+        const boost::uint64_t sent = queue->pop();
+        latencies->push_back(currentTimeMicros() - sent);
+    }
+}
+
+boost::uint64_t percentile(const vector<boost::uint64_t>& sorted,
+        double fraction) {
+    return sorted[std::min(sorted.size() - 1,
+            (size_t) (double(sorted.size()) * fraction))];
+}
+
+/**
+ * Measures the time between pushing an element on an empty queue and a
+ * waiting consumer returning from pop. The producer pauses between pushes so
+ * that the consumer is always waiting.
+ */
+template<class WaitStrategy>
+void run(const string& name, unsigned int messages,
+        unsigned int pauseMicros) {
+
+    typedef SynchronizedQueue<boost::uint64_t, WaitStrategy> Queue;
+    Queue queue;
+
+    vector<boost::uint64_t> latencies;
+    boost::thread consumer(
+            boost::bind(&consume<Queue>, &queue, messages, &latencies));
+    for (unsigned int i = 0; i < messages; ++i) {
+        boost::this_thread::sleep(boost::posix_time::microseconds(pauseMicros));
+        queue.push(currentTimeMicros());
+    }
+    consumer.join();
+
+    sort(latencies.begin(), latencies.end());
+    cout << setw(16) << left << name << right << setw(10)
+            << percentile(latencies, 0.5) << setw(10)
+            << percentile(latencies, 0.9) << setw(10)
+            << percentile(latencies, 0.99) << setw(10)
+            << percentile(latencies, 0.999) << setw(10) << latencies.back()
+            << endl;
+
+}
+
+/**
+ * Compares the wake-up latency percentiles of the SynchronizedQueue waiting
+ * strategies.
+ *
+ * Usage: WaitStrategyBenchmark [messages] [pause between pushes in us]
+ */
+int main(int argc, char* argv[]) {
+
+    unsigned int messages = 10000;
+    unsigned int pauseMicros = 100;
+    if (argc > 1) {
+        messages = boost::lexical_cast<unsigned int>(argv[1]);
+    }
+    if (argc > 2) {
+        pauseMicros = boost::lexical_cast<unsigned int>(argv[2]);
+    }
+
+    cout << setw(16) << left << "strategy" << right << setw(10) << "p50 us"
+            << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(10)
+            << "p99.9 us" << setw(10) << "max us" << endl;
+
+    run<BlockingWaitStrategy>("blocking", messages, pauseMicros);
+    run<SpinThenBlockWaitStrategy<> >("spin-then-block", messages,
+            pauseMicros);
+    run<BusyPollWaitStrategy>("busy-poll", messages, pauseMicros);
+
+    return EXIT_SUCCESS;
+
+}
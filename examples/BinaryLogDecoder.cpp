@@ -0,0 +1,79 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <rsc/logging/BinaryLogReader.h>
+
+using namespace std;
+using namespace rsc::logging;
+
+/**
+ * Renders a log file written by the "binary" logging system as text, one
+ * line per message:
+ *
+ * <time> <logger> [<level>]: <message> (<file>:<line>)
+ *
+ * Usage: BinaryLogDecoder <file>
+ */
+int main(int argc, char* argv[]) {
+
+    if (argc != 2) {
+        cerr << "Usage: " << argv[0] << " <file>" << endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+
+        BinaryLogReader reader(argv[1]);
+        const boost::posix_time::ptime epoch(
+                boost::gregorian::date(1970, 1, 1));
+
+        BinaryLogReader::Entry entry;
+        while (reader.next(entry)) {
+            cout << boost::posix_time::to_iso_extended_string(
+                    epoch + boost::posix_time::microseconds(entry.timestamp))
+                    << " " << entry.logger << " [" << entry.level << "]: "
+                    << entry.message;
+            if (!entry.file.empty()) {
+                cout << " (" << entry.file << ":" << entry.line << ")";
+            }
+            cout << '\n';
+        }
+
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+
+}
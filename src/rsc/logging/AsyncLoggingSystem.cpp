@@ -0,0 +1,380 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "AsyncLoggingSystem.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition.hpp>
+
+#include "../misc/langutils.h"
+#include "../threading/RingBufferQueue.h"
+
+using namespace std;
+
+namespace rsc {
+namespace logging {
+
+const size_t AsyncLoggingSystem::DEFAULT_CAPACITY = 8192;
+const size_t AsyncLoggingSystem::BATCH_SIZE = 256;
+
+/**
+ * Owns the ring buffer and the background thread writing it to the stream.
+ *
+ * @author jwienke
+ */
+class AsyncLoggingSystem::Writer: private boost::noncopyable {
+public:
+
+    Writer(const size_t& capacity, const OverflowPolicy& overflowPolicy,
+            ostream& stream) :
+            queue(capacity), overflowPolicy(overflowPolicy), stream(stream), dropped(
+                    0), unreported(0), blockedProducers(0), thread(
+                    boost::bind(&Writer::run, this)) {
+    }
+
+    ~Writer() {
+        // the writer thread drains the remaining records before exiting
+        queue.interrupt();
+        thread.join();
+    }
+
+    /**
+     * Queues a log record which is formatted by the writer thread.
+     *
+     * @param time milliseconds since epoch when the record was logged
+     * @param level level of the record
+     * @param logger name of the logger
+     * @param msg first character of the message, not null-terminated
+     * @param length number of characters in the message
+     */
+    void write(const boost::uint64_t& time, const Logger::Level& level,
+            const boost::shared_ptr<const string>& logger, const char* msg,
+            const size_t& length) {
+        Record record;
+        record.time = time;
+        record.level = level;
+        record.logger = logger;
+        record.message.assign(msg, length);
+        const bool fatal = level == Logger::LEVEL_FATAL;
+        enqueue(record, !fatal);
+        if (fatal) {
+            flush();
+        }
+    }
+
+    void flush() {
+        Record record;
+        record.flush.reset(new FlushRequest);
+        enqueue(record, false);
+        boost::mutex::scoped_lock lock(record.flush->mutex);
+        while (!record.flush->done) {
+            record.flush->condition.wait(lock);
+        }
+    }
+
+    boost::uint64_t getDroppedCount() const {
+        return dropped.load(boost::memory_order_relaxed);
+    }
+
+private:
+
+    struct FlushRequest {
+        FlushRequest() :
+                done(false) {
+        }
+        boost::mutex mutex;
+        boost::condition condition;
+        bool done;
+    };
+
+    /**
+     * Either an unformatted log record or a request to flush.
+     */
+    struct Record {
+        Record() :
+                time(0), level(Logger::LEVEL_OFF) {
+        }
+        boost::uint64_t time;
+        Logger::Level level;
+        boost::shared_ptr<const string> logger;
+        string message;
+        boost::shared_ptr<FlushRequest> flush;
+    };
+
+    typedef vector<boost::shared_ptr<FlushRequest> > FlushRequests;
+
+    void enqueue(const Record& record, const bool& mayDrop) {
+
+        if (queue.tryPush(record)) {
+            return;
+        }
+
+        if (mayDrop && overflowPolicy != OVERFLOW_BLOCK) {
+            dropped.fetch_add(1, boost::memory_order_relaxed);
+            if (overflowPolicy == OVERFLOW_COUNT_AND_DROP) {
+                unreported.fetch_add(1, boost::memory_order_relaxed);
+            }
+            return;
+        }
+
+        boost::mutex::scoped_lock lock(spaceMutex);
+        blockedProducers.fetch_add(1);
+        // pairs with the fence in wakeUpProducers
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        while (!queue.tryPush(record)) {
+            spaceCondition.wait(lock);
+        }
+        blockedProducers.fetch_sub(1);
+
+    }
+
+    void wakeUpProducers() {
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (blockedProducers.load(boost::memory_order_relaxed) > 0) {
+            {
+                boost::mutex::scoped_lock lock(spaceMutex);
+            }
+            spaceCondition.notify_all();
+        }
+    }
+
+    void append(Record& record, string& buffer, FlushRequests& flushes) {
+        if (record.flush) {
+            flushes.push_back(record.flush);
+            return;
+        }
+        // formatting happens here so that logging threads only copy the
+        // message
+        header.str("");
+        header << record.time << " " << *record.logger << " [" << record.level
+                << "]: ";
+        buffer += header.str();
+        buffer += record.message;
+        buffer += '\n';
+    }
+
+    void writeOut(string& buffer, FlushRequests& flushes) {
+
+        const boost::uint64_t lost = unreported.exchange(0,
+                boost::memory_order_relaxed);
+        if (lost > 0) {
+            buffer += boost::str(
+                    boost::format(
+                            "%1% rsc.logging.AsyncLoggingSystem [WARN]: Dropped %2% log records because the queue was full\n")
+                            % rsc::misc::currentTimeMillis() % lost);
+        }
+
+        stream.write(buffer.data(), buffer.size());
+        stream.flush();
+        buffer.clear();
+
+        for (FlushRequests::const_iterator it = flushes.begin();
+                it != flushes.end(); ++it) {
+            boost::mutex::scoped_lock lock((*it)->mutex);
+            (*it)->done = true;
+            (*it)->condition.notify_all();
+        }
+        flushes.clear();
+
+    }
+
+    void run() {
+
+        string buffer;
+        FlushRequests flushes;
+        Record record;
+        while (true) {
+
+            try {
+                record = queue.pop();
+            } catch (const rsc::threading::InterruptedException& e) {
+                break;
+            }
+
+            size_t batch = 0;
+            do {
+                append(record, buffer, flushes);
+            } while (++batch < BATCH_SIZE && queue.tryPop(record));
+            wakeUpProducers();
+            writeOut(buffer, flushes);
+
+        }
+
+        while (queue.tryPop(record)) {
+            append(record, buffer, flushes);
+        }
+        writeOut(buffer, flushes);
+
+    }
+
+    rsc::threading::RingBufferQueue<Record> queue;
+    OverflowPolicy overflowPolicy;
+    ostream& stream;
+
+    /**
+     * Reused by the writer thread for formatting record headers.
+     */
+    ostringstream header;
+
+    boost::atomic<boost::uint64_t> dropped;
+    /**
+     * Dropped records not yet reported in the output.
+     */
+    boost::atomic<boost::uint64_t> unreported;
+
+    boost::atomic<unsigned int> blockedProducers;
+    boost::mutex spaceMutex;
+    boost::condition spaceCondition;
+
+    boost::thread thread;
+
+};
+
+/**
+ * Passes records to the Writer, which formats them in its thread.
+ *
+ * @author jwienke
+ */
+class AsyncLoggingSystem::AsyncLogger: public Logger {
+public:
+
+    AsyncLogger(const string& name, boost::shared_ptr<Writer> writer) :
+            name(new string(name)), level(LEVEL_INFO), writer(writer) {
+    }
+
+    Level getLevel() const {
+        boost::mutex::scoped_lock lock(mutex);
+        return level;
+    }
+
+    void setLevel(const Level& level) {
+        boost::mutex::scoped_lock lock(mutex);
+        this->level = level;
+    }
+
+    string getName() const {
+        boost::mutex::scoped_lock lock(mutex);
+        return *name;
+    }
+
+    void setName(const string& name) {
+        boost::shared_ptr<const string> newName(new string(name));
+        boost::mutex::scoped_lock lock(mutex);
+        this->name = newName;
+    }
+
+    void log(const Level& level, const string& msg) {
+        logView(level, msg.data(), msg.size());
+    }
+
+    void logView(const Level& level, const char* msg, const size_t& length) {
+        boost::shared_ptr<const string> currentName;
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            if (level > this->level) {
+                return;
+            }
+            currentName = name;
+        }
+        writer->write(rsc::misc::currentTimeMillis(), level, currentName, msg,
+                length);
+    }
+
+    void logAt(const Level& level, const CallSite& /*site*/, const char* msg,
+            const size_t& length) {
+        logView(level, msg, length);
+    }
+
+private:
+    mutable boost::mutex mutex;
+    /**
+     * Shared with queued records, which are formatted later on.
+     */
+    boost::shared_ptr<const string> name;
+    Level level;
+    boost::shared_ptr<Writer> writer;
+};
+
+AsyncLoggingSystem::AsyncLoggingSystem(const size_t& capacity,
+        const OverflowPolicy& overflowPolicy, ostream& stream) :
+        writer(new Writer(capacity, overflowPolicy, stream)) {
+}
+
+AsyncLoggingSystem::~AsyncLoggingSystem() {
+}
+
+const string AsyncLoggingSystem::getName() const {
+    return "AsyncLoggingSystem";
+}
+
+LoggerPtr AsyncLoggingSystem::createLogger(const string& name) {
+    return LoggerPtr(new AsyncLogger(name, writer));
+}
+
+void AsyncLoggingSystem::flush() {
+    writer->flush();
+}
+
+boost::uint64_t AsyncLoggingSystem::getDroppedCount() const {
+    return writer->getDroppedCount();
+}
+
+AsyncLoggingSystem* AsyncLoggingSystem::create(
+        const runtime::Properties& properties) {
+
+    const size_t capacity = properties.getAs<size_t>("capacity",
+            DEFAULT_CAPACITY);
+
+    const string overflow = properties.getAs<string>("overflow", "block");
+    OverflowPolicy overflowPolicy;
+    if (overflow == "block") {
+        overflowPolicy = OVERFLOW_BLOCK;
+    } else if (overflow == "drop") {
+        overflowPolicy = OVERFLOW_DROP;
+    } else if (overflow == "count") {
+        overflowPolicy = OVERFLOW_COUNT_AND_DROP;
+    } else {
+        throw invalid_argument(
+                boost::str(
+                        boost::format(
+                                "Unknown overflow policy '%1%', expected block, drop or count")
+                                % overflow));
+    }
+
+    return new AsyncLoggingSystem(capacity, overflowPolicy);
+
+}
+
+}
+}
@@ -0,0 +1,150 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "../runtime/Properties.h"
+
+#include "LoggingSystem.h"
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace logging {
+
+/**
+ * A logging system which writes to a stream, by default std::cerr, from a
+ * background thread. Loggers only format the record in the calling thread
+ * and push it into a lock-free ring buffer. The background thread writes the
+ * queued records in batches, flushing the stream once per batch instead of
+ * once per line.
+ *
+ * The OverflowPolicy decides what happens to records while the ring buffer
+ * is full. Records of level FATAL are never dropped, and logging them blocks
+ * until they and all records queued before them have been written.
+ *
+ * Available as "async" in the LoggingSystemFactory with the properties
+ * "capacity" (number of records) and "overflow" ("block", "drop" or
+ * "count").
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT AsyncLoggingSystem: public LoggingSystem {
+public:
+
+    /**
+     * Strategies for logging while the ring buffer is full.
+     */
+    enum OverflowPolicy {
+        /**
+         * Blocks the logging thread until space is available.
+         */
+        OVERFLOW_BLOCK,
+        /**
+         * Silently discards new records.
+         */
+        OVERFLOW_DROP,
+        /**
+         * Discards new records and writes the number of discarded records to
+         * the output once space is available again.
+         */
+        OVERFLOW_COUNT_AND_DROP
+    };
+
+    /**
+     * Default number of records the ring buffer can hold.
+     */
+    static const std::size_t DEFAULT_CAPACITY;
+
+    /**
+     * Maximum number of records written with a single flush.
+     */
+    static const std::size_t BATCH_SIZE;
+
+    /**
+     * Creates a new logging system and starts the background thread.
+     *
+     * @param capacity number of records the ring buffer can hold, rounded up
+     *                 to a power of two
+     * @param overflowPolicy strategy for logging while the buffer is full
+     * @param stream stream to write to, must outlive all loggers of this
+     *               system
+     * @throw std::invalid_argument capacity is 0
+     */
+    explicit AsyncLoggingSystem(const std::size_t& capacity = DEFAULT_CAPACITY,
+            const OverflowPolicy& overflowPolicy = OVERFLOW_BLOCK,
+            std::ostream& stream = std::cerr);
+    virtual ~AsyncLoggingSystem();
+
+    const std::string getName() const;
+
+    LoggerPtr createLogger(const std::string& name);
+
+    /**
+     * Blocks until all records logged so far have been written and the
+     * stream has been flushed.
+     */
+    void flush();
+
+    /**
+     * Returns the number of records discarded because the ring buffer was
+     * full.
+     *
+     * @return number of dropped records
+     */
+    boost::uint64_t getDroppedCount() const;
+
+    /**
+     * Creates a new instance configured with the "capacity" and "overflow"
+     * properties.
+     *
+     * @param properties configuration
+     * @return new instance
+     * @throw std::invalid_argument invalid property value
+     */
+    static AsyncLoggingSystem* create(const runtime::Properties& properties);
+
+private:
+
+    class Writer;
+    class AsyncLogger;
+
+    /**
+     * Shared with the created loggers, which may outlive this instance. The
+     * background thread stops once the last of them is destroyed.
+     */
+    boost::shared_ptr<Writer> writer;
+
+};
+
+}
+}
@@ -0,0 +1,139 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+namespace rsc {
+namespace logging {
+
+/**
+ * Layout of the files written by BinaryLoggingSystem and read by
+ * BinaryLogReader. All values use the byte order of the writing machine.
+ *
+ * A file starts with a FileHeader followed by records, each starting with a
+ * RecordHeader and padded to a multiple of ALIGNMENT bytes. A record size of
+ * 0 marks the end of the written data. Writers store the size of a record
+ * when reserving its space and publish the record by setting its type last.
+ * Records of type RECORD_PENDING were not completely written, e.g. because
+ * the process crashed, and must be skipped. Definition records for loggers
+ * and call sites always precede the message records referring to them. A
+ * logger may be defined again with the same id after it was renamed.
+ */
+namespace binarylog {
+
+const char MAGIC[8] = { 'R', 'S', 'C', 'B', 'L', 'O', 'G', '\0' };
+
+const boost::uint32_t VERSION = 1;
+
+const std::size_t ALIGNMENT = 8;
+
+enum RecordType {
+    /**
+     * A record whose space was reserved but whose contents were not
+     * completely written yet.
+     */
+    RECORD_PENDING = 0,
+    /**
+     * A DefinitionRecord assigning a name to a logger id.
+     */
+    RECORD_LOGGER = 1,
+    /**
+     * A DefinitionRecord assigning a file name and line to a call site id.
+     */
+    RECORD_CALL_SITE = 2,
+    /**
+     * A MessageRecord.
+     */
+    RECORD_MESSAGE = 3
+};
+
+struct FileHeader {
+    char magic[8];
+    boost::uint32_t version;
+    boost::uint32_t headerSize;
+    /**
+     * Creation time of the file in microseconds since the epoch.
+     */
+    boost::uint64_t created;
+};
+
+struct RecordHeader {
+    /**
+     * Size of the record in bytes including this header and padding.
+     */
+    boost::uint32_t size;
+    boost::uint32_t type;
+};
+
+/**
+ * Followed by @c length characters of the name or file name.
+ */
+struct DefinitionRecord {
+    RecordHeader header;
+    boost::uint32_t id;
+    /**
+     * Line of a call site, 0 for loggers.
+     */
+    boost::uint32_t line;
+    boost::uint32_t length;
+    boost::uint32_t reserved;
+};
+
+/**
+ * Followed by @c length characters of the message.
+ */
+struct MessageRecord {
+    RecordHeader header;
+    /**
+     * Microseconds since the epoch.
+     */
+    boost::uint64_t timestamp;
+    boost::uint32_t logger;
+    boost::uint32_t level;
+    /**
+     * Id of the CallSite or CallSite::UNKNOWN_ID.
+     */
+    boost::uint32_t callSite;
+    boost::uint32_t length;
+};
+
+/**
+ * Returns the size of a record with a fixed part of @a fixedSize bytes
+ * followed by @a length characters, including padding.
+ */
+inline std::size_t recordSize(const std::size_t& fixedSize,
+        const std::size_t& length) {
+    return (fixedSize + length + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+}
+
+}
+}
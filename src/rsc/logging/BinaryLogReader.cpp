@@ -0,0 +1,178 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "BinaryLogReader.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "BinaryLogFormat.h"
+
+using namespace std;
+
+namespace rsc {
+namespace logging {
+
+using namespace binarylog;
+
+namespace {
+
+runtime_error malformedRecord(const string& fileName) {
+    return runtime_error(
+            boost::str(
+                    boost::format("Malformed record in binary log file '%1%'")
+                            % fileName));
+}
+
+}
+
+BinaryLogReader::BinaryLogReader(const string& fileName) :
+        fileName(fileName), stream(fileName.c_str(), ios_base::binary), created(
+                0) {
+
+    if (!stream) {
+        throw runtime_error(
+                boost::str(
+                        boost::format("Unable to open binary log file '%1%'")
+                                % fileName));
+    }
+
+    FileHeader header;
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (stream.gcount() != sizeof(header)
+            || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw runtime_error(
+                boost::str(
+                        boost::format("'%1%' is not a binary log file")
+                                % fileName));
+    }
+    if (header.version != VERSION || header.headerSize < sizeof(header)) {
+        throw runtime_error(
+                boost::str(
+                        boost::format(
+                                "Binary log file '%1%' has unsupported version %2%")
+                                % fileName % header.version));
+    }
+    created = header.created;
+    stream.seekg(header.headerSize);
+
+}
+
+BinaryLogReader::~BinaryLogReader() {
+}
+
+boost::uint64_t BinaryLogReader::getCreationTime() const {
+    return created;
+}
+
+bool BinaryLogReader::next(Entry& entry) {
+
+    while (true) {
+
+        RecordHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        // a size of 0 marks the end of the written data, a partial record is
+        // the result of an aborted writer
+        if (stream.gcount() != sizeof(header) || header.size == 0) {
+            return false;
+        }
+        if (header.size < sizeof(header) || header.size % ALIGNMENT != 0) {
+            throw malformedRecord(fileName);
+        }
+
+        record.resize(header.size);
+        memcpy(&record[0], &header, sizeof(header));
+        const streamsize remaining = header.size - sizeof(header);
+        stream.read(&record[0] + sizeof(header), remaining);
+        if (stream.gcount() != remaining) {
+            return false;
+        }
+
+        if (header.type == RECORD_LOGGER || header.type == RECORD_CALL_SITE) {
+
+            DefinitionRecord definition;
+            if (header.size < sizeof(definition)) {
+                throw malformedRecord(fileName);
+            }
+            memcpy(&definition, &record[0], sizeof(definition));
+            if (definition.length > header.size - sizeof(definition)) {
+                throw malformedRecord(fileName);
+            }
+            const string text(&record[0] + sizeof(definition),
+                    definition.length);
+            if (header.type == RECORD_LOGGER) {
+                loggers[definition.id] = text;
+            } else {
+                callSites[definition.id] = make_pair(text, definition.line);
+            }
+
+        } else if (header.type == RECORD_MESSAGE) {
+
+            MessageRecord message;
+            if (header.size < sizeof(message)) {
+                throw malformedRecord(fileName);
+            }
+            memcpy(&message, &record[0], sizeof(message));
+            if (message.length > header.size - sizeof(message)) {
+                throw malformedRecord(fileName);
+            }
+
+            entry.timestamp = message.timestamp;
+            entry.logger = lookupLogger(message.logger);
+            entry.level = Logger::Level(message.level);
+            map<boost::uint32_t, pair<string, unsigned int> >::const_iterator site =
+                    callSites.find(message.callSite);
+            if (site != callSites.end()) {
+                entry.file = site->second.first;
+                entry.line = site->second.second;
+            } else {
+                entry.file.clear();
+                entry.line = 0;
+            }
+            entry.message.assign(&record[0] + sizeof(message), message.length);
+            return true;
+
+        }
+        // pending records of a writer which did not finish them and records
+        // of unknown types are skipped
+
+    }
+
+}
+
+string BinaryLogReader::lookupLogger(const boost::uint32_t& id) const {
+    map<boost::uint32_t, string>::const_iterator it = loggers.find(id);
+    if (it == loggers.end()) {
+        return "<logger " + boost::lexical_cast<string>(id) + ">";
+    }
+    return it->second;
+}
+
+}
+}
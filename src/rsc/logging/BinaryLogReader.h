@@ -0,0 +1,126 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "Logger.h"
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace logging {
+
+/**
+ * Reads files written by BinaryLoggingSystem and resolves the logger and
+ * call site ids of the contained messages.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT BinaryLogReader: private boost::noncopyable {
+public:
+
+    /**
+     * A logged message with resolved ids.
+     */
+    struct Entry {
+
+        /**
+         * Time of logging in microseconds since the epoch.
+         */
+        boost::uint64_t timestamp;
+
+        std::string logger;
+
+        Logger::Level level;
+
+        /**
+         * Source file of the logging statement, empty if the message was not
+         * logged through the logging macros.
+         */
+        std::string file;
+
+        /**
+         * Line of the logging statement, 0 if unknown.
+         */
+        unsigned int line;
+
+        std::string message;
+
+    };
+
+    /**
+     * Opens a file and reads its header.
+     *
+     * @param fileName name of the file to read
+     * @throw std::runtime_error the file cannot be opened or is not a binary
+     *                           log file of a supported version
+     */
+    explicit BinaryLogReader(const std::string& fileName);
+    virtual ~BinaryLogReader();
+
+    /**
+     * Returns the time the file was created.
+     *
+     * @return creation time in microseconds since the epoch
+     */
+    boost::uint64_t getCreationTime() const;
+
+    /**
+     * Reads the next message.
+     *
+     * @param entry filled with the message
+     * @return @c true if a message was read, @c false at the end of the
+     *         written data
+     * @throw std::runtime_error the file contains a malformed record
+     */
+    bool next(Entry& entry);
+
+private:
+
+    std::string lookupLogger(const boost::uint32_t& id) const;
+
+    std::string fileName;
+    std::ifstream stream;
+    boost::uint64_t created;
+
+    std::vector<char> record;
+
+    std::map<boost::uint32_t, std::string> loggers;
+    std::map<boost::uint32_t, std::pair<std::string, unsigned int> > callSites;
+
+};
+
+}
+}
@@ -0,0 +1,359 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "BinaryLoggingSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/atomic.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "../misc/langutils.h"
+#include "../os/ProcessInfo.h"
+#include "BinaryLogFormat.h"
+#include "CallSite.h"
+
+using namespace std;
+
+namespace rsc {
+namespace logging {
+
+using namespace binarylog;
+
+const size_t BinaryLoggingSystem::DEFAULT_SIZE = 64 * 1024 * 1024;
+
+/**
+ * Owns the mapped file. Producers reserve space for their records by
+ * atomically advancing the write offset and immediately store the size of
+ * the record so that readers can skip it. A record is published by writing
+ * its type last.
+ *
+ * @author jwienke
+ */
+class BinaryLoggingSystem::Writer: private boost::noncopyable {
+public:
+
+    Writer(const string& fileName, const size_t& size) :
+            fileName(fileName), capacity(size), offset(sizeof(FileHeader)), dropped(
+                    0), loggerIds(0), definedSites(CallSite::UNKNOWN_ID) {
+
+        if (size < sizeof(FileHeader)) {
+            throw invalid_argument(
+                    boost::str(
+                            boost::format(
+                                    "Size %1% is too small for a binary log file")
+                                    % size));
+        }
+
+        try {
+            {
+                filebuf file;
+                if (!file.open(fileName.c_str(),
+                        ios_base::in | ios_base::out | ios_base::trunc
+                                | ios_base::binary)) {
+                    throw runtime_error("cannot create file");
+                }
+            }
+            // extending the file fills it with zeros
+            boost::filesystem::resize_file(fileName, size);
+            boost::interprocess::file_mapping mapping(fileName.c_str(),
+                    boost::interprocess::read_write);
+            boost::interprocess::mapped_region(mapping,
+                    boost::interprocess::read_write, 0, size).swap(region);
+        } catch (const exception& e) {
+            throw runtime_error(
+                    boost::str(
+                            boost::format(
+                                    "Unable to map binary log file '%1%': %2%")
+                                    % fileName % e.what()));
+        }
+        base = static_cast<char*>(region.get_address());
+
+        FileHeader* header = reinterpret_cast<FileHeader*>(base);
+        memcpy(header->magic, MAGIC, sizeof(MAGIC));
+        header->version = VERSION;
+        header->headerSize = sizeof(FileHeader);
+        header->created = rsc::misc::currentTimeMicros();
+
+    }
+
+    ~Writer() {
+        const size_t end = min<boost::uint64_t>(offset.load(), capacity);
+        region.flush(0, 0, false);
+        boost::interprocess::mapped_region().swap(region);
+        try {
+            boost::filesystem::resize_file(fileName, end);
+        } catch (const exception& /*e*/) {
+            // the reader stops at the zeros behind the written data anyway
+        }
+    }
+
+    boost::uint32_t defineLogger(const string& name) {
+        const boost::uint32_t id = loggerIds.fetch_add(1) + 1;
+        writeDefinition(RECORD_LOGGER, id, 0, name);
+        return id;
+    }
+
+    void renameLogger(const boost::uint32_t& id, const string& name) {
+        writeDefinition(RECORD_LOGGER, id, 0, name);
+    }
+
+    /**
+     * Ensures that the location of the call site with the given id is
+     * written before messages referring to it.
+     */
+    void defineCallSite(const boost::uint32_t& id) {
+
+        if (id <= definedSites.load(boost::memory_order_acquire)) {
+            return;
+        }
+
+        boost::mutex::scoped_lock lock(definitionMutex);
+        const boost::uint32_t maxId = CallSite::getMaxId();
+        for (boost::uint32_t next = definedSites.load(
+                boost::memory_order_relaxed) + 1; next <= maxId; ++next) {
+            const pair<string, unsigned int> location = CallSite::getLocation(
+                    next);
+            writeDefinition(RECORD_CALL_SITE, next, location.second,
+                    location.first);
+        }
+        definedSites.store(maxId, boost::memory_order_release);
+
+    }
+
+    void writeMessage(const boost::uint32_t& logger, const Logger::Level& level,
+            const boost::uint32_t& callSite, const char* msg,
+            const size_t& length) {
+
+        const boost::uint64_t timestamp = rsc::misc::currentTimeMicros();
+        const size_t size = recordSize(sizeof(MessageRecord), length);
+        char* record = reserve(size);
+        if (!record) {
+            return;
+        }
+
+        MessageRecord* message = reinterpret_cast<MessageRecord*>(record);
+        message->timestamp = timestamp;
+        message->logger = logger;
+        message->level = level;
+        message->callSite = callSite;
+        message->length = length;
+        memcpy(record + sizeof(MessageRecord), msg, length);
+        commit(record, RECORD_MESSAGE);
+
+    }
+
+    void flush() {
+        region.flush(0, 0, false);
+    }
+
+    boost::uint64_t getDroppedCount() const {
+        return dropped.load(boost::memory_order_relaxed);
+    }
+
+private:
+
+    /**
+     * Returns the memory for a record of @a size bytes or 0 if the file is
+     * full. The record is marked as pending until #commit is called so that
+     * a record which is never completed does not hide the following ones.
+     */
+    char* reserve(const size_t& size) {
+        const boost::uint64_t position = offset.fetch_add(size,
+                boost::memory_order_relaxed);
+        if (position + size > capacity) {
+            dropped.fetch_add(1, boost::memory_order_relaxed);
+            return 0;
+        }
+        RecordHeader* header = reinterpret_cast<RecordHeader*>(base + position);
+        header->type = RECORD_PENDING;
+        header->size = size;
+        return base + position;
+    }
+
+    void commit(char* record, const RecordType& type) {
+        RecordHeader* header = reinterpret_cast<RecordHeader*>(record);
+        // readers of a live file must not see the type before the contents
+        boost::atomic_thread_fence(boost::memory_order_release);
+        header->type = type;
+    }
+
+    void writeDefinition(const RecordType& type, const boost::uint32_t& id,
+            const unsigned int& line, const string& text) {
+
+        const size_t size = recordSize(sizeof(DefinitionRecord), text.size());
+        char* record = reserve(size);
+        if (!record) {
+            return;
+        }
+
+        DefinitionRecord* definition =
+                reinterpret_cast<DefinitionRecord*>(record);
+        definition->id = id;
+        definition->line = line;
+        definition->length = text.size();
+        definition->reserved = 0;
+        memcpy(record + sizeof(DefinitionRecord), text.data(), text.size());
+        commit(record, type);
+
+    }
+
+    string fileName;
+    size_t capacity;
+    boost::interprocess::mapped_region region;
+    char* base;
+
+    boost::atomic<boost::uint64_t> offset;
+    boost::atomic<boost::uint64_t> dropped;
+
+    boost::atomic<boost::uint32_t> loggerIds;
+
+    /**
+     * All call sites up to this id have been written.
+     */
+    boost::atomic<boost::uint32_t> definedSites;
+    boost::mutex definitionMutex;
+
+};
+
+/**
+ * Passes records to the Writer without formatting them.
+ *
+ * @author jwienke
+ */
+class BinaryLoggingSystem::BinaryLogger: public Logger {
+public:
+
+    BinaryLogger(const string& name, boost::shared_ptr<Writer> writer) :
+            name(name), id(writer->defineLogger(name)), level(LEVEL_INFO), writer(
+                    writer) {
+    }
+
+    Level getLevel() const {
+        return Level(level.load(boost::memory_order_relaxed));
+    }
+
+    void setLevel(const Level& level) {
+        this->level.store(level, boost::memory_order_relaxed);
+    }
+
+    string getName() const {
+        boost::mutex::scoped_lock lock(nameMutex);
+        return name;
+    }
+
+    void setName(const string& name) {
+        boost::mutex::scoped_lock lock(nameMutex);
+        this->name = name;
+        writer->renameLogger(id, name);
+    }
+
+    void log(const Level& level, const string& msg) {
+        logView(level, msg.data(), msg.size());
+    }
+
+    void logView(const Level& level, const char* msg, const size_t& length) {
+        if (enabled(level)) {
+            write(level, CallSite::UNKNOWN_ID, msg, length);
+        }
+    }
+
+    void logAt(const Level& level, const CallSite& site, const char* msg,
+            const size_t& length) {
+        if (enabled(level)) {
+            writer->defineCallSite(site.getId());
+            write(level, site.getId(), msg, length);
+        }
+    }
+
+private:
+
+    bool enabled(const Level& level) const {
+        return level <= this->level.load(boost::memory_order_relaxed);
+    }
+
+    void write(const Level& level, const boost::uint32_t& callSite,
+            const char* msg, const size_t& length) {
+        writer->writeMessage(id, level, callSite, msg, length);
+        if (level == LEVEL_FATAL) {
+            writer->flush();
+        }
+    }
+
+    mutable boost::mutex nameMutex;
+    string name;
+    boost::uint32_t id;
+    boost::atomic<int> level;
+    boost::shared_ptr<Writer> writer;
+
+};
+
+BinaryLoggingSystem::BinaryLoggingSystem(const string& fileName,
+        const size_t& size) :
+        writer(new Writer(fileName, size)) {
+}
+
+BinaryLoggingSystem::~BinaryLoggingSystem() {
+}
+
+const string BinaryLoggingSystem::getName() const {
+    return "BinaryLoggingSystem";
+}
+
+LoggerPtr BinaryLoggingSystem::createLogger(const string& name) {
+    return LoggerPtr(new BinaryLogger(name, writer));
+}
+
+void BinaryLoggingSystem::flush() {
+    writer->flush();
+}
+
+boost::uint64_t BinaryLoggingSystem::getDroppedCount() const {
+    return writer->getDroppedCount();
+}
+
+BinaryLoggingSystem* BinaryLoggingSystem::create(
+        const runtime::Properties& properties) {
+    const string fileName = properties.getAs<string>("file",
+            "rsc-log-"
+                    + boost::lexical_cast<string>(
+                            rsc::os::currentProcessId()) + ".bin");
+    const size_t size = properties.getAs<size_t>("size", DEFAULT_SIZE);
+    return new BinaryLoggingSystem(fileName, size);
+}
+
+}
+}
@@ -0,0 +1,124 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "../runtime/Properties.h"
+
+#include "LoggingSystem.h"
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace logging {
+
+/**
+ * A logging system which appends binary records to a memory-mapped file
+ * instead of formatting text. A log call only copies the logger id, the
+ * level, the current time in microseconds, the id of the logging statement
+ * (CallSite) and the message characters into the mapped file. Logger names
+ * and call site locations are written once as definition records.
+ * Timestamps are formatted and ids resolved later by BinaryLogReader, e.g.
+ * using the BinaryLogDecoder example.
+ *
+ * The file has a fixed size. Records which do not fit anymore are dropped
+ * and counted. Logging FATAL records synchronizes the file with the disk.
+ * The file is truncated to the written data when the system and all its
+ * loggers have been destroyed.
+ *
+ * Available as "binary" in the LoggingSystemFactory with the properties
+ * "file" (name of the file, by default rsc-log-<pid>.bin in the working
+ * directory) and "size" (size of the file in bytes).
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT BinaryLoggingSystem: public LoggingSystem {
+public:
+
+    /**
+     * Default size of the log file in bytes.
+     */
+    static const std::size_t DEFAULT_SIZE;
+
+    /**
+     * Creates the file, replacing an existing one, and maps it into memory.
+     *
+     * @param fileName name of the log file
+     * @param size size of the log file in bytes
+     * @throw std::invalid_argument size is too small for the file header
+     * @throw std::runtime_error the file cannot be created or mapped
+     */
+    explicit BinaryLoggingSystem(const std::string& fileName,
+            const std::size_t& size = DEFAULT_SIZE);
+    virtual ~BinaryLoggingSystem();
+
+    const std::string getName() const;
+
+    LoggerPtr createLogger(const std::string& name);
+
+    /**
+     * Synchronizes the records written so far with the file on disk.
+     */
+    void flush();
+
+    /**
+     * Returns the number of records discarded because the file was full.
+     *
+     * @return number of dropped records
+     */
+    boost::uint64_t getDroppedCount() const;
+
+    /**
+     * Creates a new instance configured with the "file" and "size"
+     * properties.
+     *
+     * @param properties configuration
+     * @return new instance
+     * @throw std::invalid_argument invalid property value
+     * @throw std::runtime_error the file cannot be created or mapped
+     */
+    static BinaryLoggingSystem* create(const runtime::Properties& properties);
+
+private:
+
+    class Writer;
+    class BinaryLogger;
+
+    /**
+     * Shared with the created loggers, which may outlive this instance. The
+     * file is unmapped once the last of them is destroyed.
+     */
+    boost::shared_ptr<Writer> writer;
+
+};
+
+}
+}
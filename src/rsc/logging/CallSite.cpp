@@ -0,0 +1,105 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "CallSite.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/thread/mutex.hpp>
+
+using namespace std;
+
+namespace rsc {
+namespace logging {
+
+namespace {
+
+/**
+ * Locations of all call sites, indexed by id - 1.
+ */
+struct Registry {
+
+    Registry() :
+            maxId(CallSite::UNKNOWN_ID) {
+    }
+
+    boost::mutex mutex;
+    vector<pair<string, unsigned int> > locations;
+    boost::atomic<boost::uint32_t> maxId;
+
+};
+
+Registry& registry() {
+    // never destroyed so that statements logging during static
+    // destruction can still register
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+}
+
+const boost::uint32_t CallSite::UNKNOWN_ID = 0;
+
+CallSite::CallSite(const char* file, const unsigned int& line) :
+        file(file), line(line) {
+    Registry& sites = registry();
+    boost::mutex::scoped_lock lock(sites.mutex);
+    sites.locations.push_back(make_pair(string(file), line));
+    id = sites.locations.size();
+    sites.maxId.store(id, boost::memory_order_release);
+}
+
+boost::uint32_t CallSite::getId() const {
+    return id;
+}
+
+const char* CallSite::getFile() const {
+    return file;
+}
+
+unsigned int CallSite::getLine() const {
+    return line;
+}
+
+boost::uint32_t CallSite::getMaxId() {
+    return registry().maxId.load(boost::memory_order_acquire);
+}
+
+pair<string, unsigned int> CallSite::getLocation(const boost::uint32_t& id) {
+    Registry& sites = registry();
+    boost::mutex::scoped_lock lock(sites.mutex);
+    if (id == UNKNOWN_ID || id > sites.locations.size()) {
+        throw out_of_range(
+                boost::str(boost::format("No call site with id %1%") % id));
+    }
+    return sites.locations[id - 1];
+}
+
+}
+}
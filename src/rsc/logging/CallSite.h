@@ -0,0 +1,98 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace logging {
+
+/**
+ * Identifies a logging statement in the source code. The logging macros
+ * create a static instance for each statement when it is executed for the
+ * first time. Every instance receives a unique id, starting at 1, and its
+ * location is registered so that logging systems can refer to a statement by
+ * its id and resolve the location later.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT CallSite: private boost::noncopyable {
+public:
+
+    /**
+     * Id used for messages not logged through the logging macros.
+     */
+    static const boost::uint32_t UNKNOWN_ID;
+
+    /**
+     * Creates and registers a new call site.
+     *
+     * @param file source file of the statement, must be a string literal or
+     *             outlive the instance
+     * @param line line of the statement
+     */
+    CallSite(const char* file, const unsigned int& line);
+
+    boost::uint32_t getId() const;
+    const char* getFile() const;
+    unsigned int getLine() const;
+
+    /**
+     * Returns the highest id assigned so far.
+     *
+     * @return highest id or #UNKNOWN_ID if no call site exists
+     */
+    static boost::uint32_t getMaxId();
+
+    /**
+     * Returns the location of the call site with the given id. Locations
+     * remain available even if the library containing the call site has been
+     * unloaded.
+     *
+     * @param id id of the call site
+     * @return file name and line of the call site
+     * @throw std::out_of_range no call site with this id exists
+     */
+    static std::pair<std::string, unsigned int> getLocation(
+            const boost::uint32_t& id);
+
+private:
+
+    const char* file;
+    unsigned int line;
+    boost::uint32_t id;
+
+};
+
+}
+}
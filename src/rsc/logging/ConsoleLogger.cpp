@@ -68,15 +68,26 @@ ostream& ConsoleLogger::printHeader(ostream& stream, const Level& level) {
 
 std::ostream& ConsoleLogger::printBody(std::ostream&      stream,
                                        const Level&       /*level*/,
-                                       const std::string& msg) {
-    return stream << msg << endl;
+                                       const char*        msg,
+                                       const std::size_t& length) {
+    return stream.write(msg, length) << endl;
 }
 
 void ConsoleLogger::log(const Level& level, const string& msg) {
+    logView(level, msg.data(), msg.size());
+}
+
+void ConsoleLogger::logAt(const Level& level, const CallSite& /*site*/,
+        const char* msg, const std::size_t& length) {
+    logView(level, msg, length);
+}
+
+void ConsoleLogger::logView(const Level& level, const char* msg,
+        const std::size_t& length) {
     boost::recursive_mutex::scoped_lock lock(mutex);
     if (isEnabledFor(level)) {
         std::ostream& stream = printHeader(cerr, level);
-        printBody(stream, level, msg);
+        printBody(stream, level, msg, length);
     }
 }
 
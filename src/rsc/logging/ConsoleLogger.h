@@ -59,6 +59,10 @@ public:
     void setName(const std::string& name);
 
     void log(const Level& level, const std::string& msg);
+    void logView(const Level& level, const char* msg,
+            const std::size_t& length);
+    void logAt(const Level& level, const CallSite& site, const char* msg,
+            const std::size_t& length);
 
 protected:
 
@@ -79,12 +83,15 @@ protected:
      *
      * @param stream Stream to print to
      * @param level The level of the log message
-     * @param msg The body string of the log message
+     * @param msg The first character of the body of the log message, not
+     *            null-terminated
+     * @param length The number of characters in the body
      * @return @a stream
      */
     virtual std::ostream& printBody(std::ostream&      stream,
                                     const Level&       level,
-                                    const std::string& msg);
+                                    const char*        msg,
+                                    const std::size_t& length);
 
     std::string                    name;
     Level                          level;
@@ -26,6 +26,8 @@
 
 #include "Logger.h"
 
+#include <boost/static_assert.hpp>
+
 #include "LoggerFactory.h"
 
 using namespace std;
@@ -33,6 +35,19 @@ using namespace std;
 namespace rsc {
 namespace logging {
 
+BOOST_STATIC_ASSERT(Logger::LEVEL_ALL == RSC_LOGGING_LEVEL_ALL);
+BOOST_STATIC_ASSERT(Logger::LEVEL_TRACE == RSC_LOGGING_LEVEL_TRACE);
+BOOST_STATIC_ASSERT(Logger::LEVEL_DEBUG == RSC_LOGGING_LEVEL_DEBUG);
+BOOST_STATIC_ASSERT(Logger::LEVEL_INFO == RSC_LOGGING_LEVEL_INFO);
+BOOST_STATIC_ASSERT(Logger::LEVEL_WARN == RSC_LOGGING_LEVEL_WARN);
+BOOST_STATIC_ASSERT(Logger::LEVEL_ERROR == RSC_LOGGING_LEVEL_ERROR);
+BOOST_STATIC_ASSERT(Logger::LEVEL_FATAL == RSC_LOGGING_LEVEL_FATAL);
+BOOST_STATIC_ASSERT(Logger::LEVEL_OFF == RSC_LOGGING_LEVEL_OFF);
+
+Logger::Logger() :
+        cachedLevel(NO_CACHED_LEVEL) {
+}
+
 Logger::~Logger() {
 }
 
@@ -64,6 +79,37 @@ void Logger::fatal(const string& msg) {
     this->log(LEVEL_FATAL, msg);
 }
 
+void Logger::logView(const Level& level, const char* msg,
+        const size_t& length) {
+    this->log(level, string(msg, length));
+}
+
+void Logger::logAt(const Level& level, const CallSite& /*site*/,
+        const char* msg, const size_t& length) {
+    switch (level) {
+    case LEVEL_TRACE:
+        this->trace(string(msg, length));
+        break;
+    case LEVEL_DEBUG:
+        this->debug(string(msg, length));
+        break;
+    case LEVEL_INFO:
+        this->info(string(msg, length));
+        break;
+    case LEVEL_WARN:
+        this->warn(string(msg, length));
+        break;
+    case LEVEL_ERROR:
+        this->error(string(msg, length));
+        break;
+    case LEVEL_FATAL:
+        this->fatal(string(msg, length));
+        break;
+    default:
+        this->logView(level, msg, length);
+    }
+}
+
 bool Logger::isTraceEnabled() const {
     return isEnabledFor(LEVEL_TRACE);
 }
@@ -92,6 +138,33 @@ bool Logger::isEnabledFor(const Level& level) const {
     return level <= getLevel();
 }
 
+bool Logger::checkLevel(const Level& level) const {
+    switch (level) {
+    case LEVEL_TRACE:
+        return isTraceEnabled();
+    case LEVEL_DEBUG:
+        return isDebugEnabled();
+    case LEVEL_INFO:
+        return isInfoEnabled();
+    case LEVEL_WARN:
+        return isWarnEnabled();
+    case LEVEL_ERROR:
+        return isErrorEnabled();
+    case LEVEL_FATAL:
+        return isFatalEnabled();
+    default:
+        return isEnabledFor(level);
+    }
+}
+
+void Logger::cacheLevel(const Level& level) {
+    cachedLevel.store(level, boost::memory_order_relaxed);
+}
+
+Logger::Level Logger::getCachedLevel() const {
+    return Level(cachedLevel.load(boost::memory_order_relaxed));
+}
+
 ostream& operator<<(ostream& stream, const Logger::Level& level) {
     switch (level) {
     case Logger::LEVEL_ALL:
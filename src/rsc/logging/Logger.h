@@ -30,9 +30,13 @@
 #include <ostream>
 #include <sstream>
 
+#include <boost/atomic.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include "CallSite.h"
+#include "MessageBuffer.h"
+
 #include "rsc/rscexports.h"
 
 namespace rsc {
@@ -124,7 +128,9 @@ public:
     /**
      * @name level-based logging functions
      *
-     * Default implementations of this method map to #log calls.
+     * Default implementations of this method map to #log calls. The default
+     * #logAt used by the logging macros maps to these methods, hence
+     * overriding them also affects the macros.
      */
     //@{
 
@@ -180,10 +186,41 @@ public:
      */
     virtual void log(const Level& level, const std::string& msg) = 0;
 
+    /**
+     * Logs a message given as a range of characters with the given level if
+     * it is enabled. Used by the logging macros to pass messages without
+     * copying them into a string. The default implementation creates a
+     * string and calls #log. Override this to avoid the allocation.
+     *
+     * @param level level for the message
+     * @param msg first character of the message, not null-terminated
+     * @param length number of characters in the message
+     */
+    virtual void logView(const Level& level, const char* msg,
+            const std::size_t& length);
+
+    /**
+     * Logs a message emitted by a logging statement with the given level if
+     * it is enabled. Used by the logging macros. The default implementation
+     * ignores the call site and calls the level-based logging function for
+     * @a level, e.g. #info, which requires a string, or #logView for other
+     * levels. Implementations which do not override the level-based
+     * functions should override this method to call #logView directly.
+     *
+     * @param level level for the message
+     * @param site the logging statement emitting the message
+     * @param msg first character of the message, not null-terminated
+     * @param length number of characters in the message
+     */
+    virtual void logAt(const Level& level, const CallSite& site,
+            const char* msg, const std::size_t& length);
+
     /**
      * @name level checks
      *
-     * Methods are mapped to calls on #getLevel.
+     * Methods are mapped to calls on #getLevel. Unless the implementation
+     * publishes its level via #cacheLevel, the logging macros use these
+     * methods.
      */
     //@{
     virtual bool isTraceEnabled() const;
@@ -195,6 +232,57 @@ public:
     virtual bool isEnabledFor(const Level& level) const;
     //@}
 
+    /**
+     * Checks whether @a level is enabled for this logger. Used by the logging
+     * macros. If the implementation publishes its level via #cacheLevel, this
+     * is a single relaxed atomic load without virtual calls or locking.
+     * Otherwise it is mapped to the level check for @a level, e.g.
+     * #isInfoEnabled, or #isEnabledFor for other levels.
+     *
+     * @param level level to check
+     * @return @c true if messages with @a level are logged
+     */
+    bool isLevelEnabled(const Level& level) const {
+        const int cached = cachedLevel.load(boost::memory_order_relaxed);
+        if (cached == NO_CACHED_LEVEL) {
+            return checkLevel(level);
+        }
+        return level <= cached;
+    }
+
+protected:
+
+    Logger();
+
+    /**
+     * Publishes the level used by #isLevelEnabled. Implementations calling
+     * this once have to call it again on every level change. From then on,
+     * the logging macros do not use the level checks like #isInfoEnabled
+     * anymore, so implementations overriding these must not call this
+     * method.
+     *
+     * @param level the current level of this logger
+     */
+    void cacheLevel(const Level& level);
+
+    /**
+     * Returns the level last published via #cacheLevel.
+     *
+     * @return cached level, undefined if #cacheLevel was never called
+     */
+    Level getCachedLevel() const;
+
+private:
+
+    static const int NO_CACHED_LEVEL = -1;
+
+    /**
+     * Maps @a level to the matching level check.
+     */
+    bool checkLevel(const Level& level) const;
+
+    boost::atomic<int> cachedLevel;
+
 };
 
 RSC_EXPORT std::ostream& operator<<(std::ostream& stream, const Logger::Level& level);
@@ -202,52 +290,121 @@ RSC_EXPORT std::ostream& operator<<(std::ostream& stream, const Logger::Level& l
 }
 }
 
+/**
+ * @name numeric logging levels for the preprocessor
+ *
+ * Equal to the values of rsc::logging::Logger::Level.
+ */
+//@{
+#define RSC_LOGGING_LEVEL_ALL 0x11111111
+#define RSC_LOGGING_LEVEL_TRACE 60
+#define RSC_LOGGING_LEVEL_DEBUG 50
+#define RSC_LOGGING_LEVEL_INFO 40
+#define RSC_LOGGING_LEVEL_WARN 30
+#define RSC_LOGGING_LEVEL_ERROR 20
+#define RSC_LOGGING_LEVEL_FATAL 10
+#define RSC_LOGGING_LEVEL_OFF 0
+//@}
+
+/**
+ * The most verbose level for which logging macros are compiled. Statements of
+ * more verbose levels are discarded at compile time including the formatting
+ * of their messages, regardless of the runtime level of the logger. Define
+ * this as one of the RSC_LOGGING_LEVEL_* values before including this header
+ * to change it for a translation unit. The RSC library itself uses the CMake
+ * option LOGGING_MIN_LEVEL.
+ */
+#ifndef RSC_LOGGING_MIN_LEVEL
+#define RSC_LOGGING_MIN_LEVEL RSC_LOGGING_LEVEL_ALL
+#endif
+
+/**
+ * Formats @a msg into a MessageBuffer and passes it to @a logger together
+ * with the CallSite of the statement. Not meant to be used directly.
+ */
+#define RSC_LOG_MESSAGE_(logger, level, msg) \
+    { \
+        static const rsc::logging::CallSite \
+                iShouldNeverBeMatchedByClientCodeSite(__FILE__, __LINE__); \
+        rsc::logging::MessageBuffer iShouldNeverBeMatchedByClientCode; \
+        iShouldNeverBeMatchedByClientCode.stream() << msg; \
+        logger->logAt(level, iShouldNeverBeMatchedByClientCodeSite, \
+                iShouldNeverBeMatchedByClientCode.data(), \
+                iShouldNeverBeMatchedByClientCode.size()); \
+    }
+
+/**
+ * Replacement for statements more verbose than #RSC_LOGGING_MIN_LEVEL. The
+ * condition and message are still type-checked but never evaluated, so the
+ * compiler removes the statement. Not meant to be used directly.
+ */
+#define RSC_LOG_DISCARDED_(condition, logger, msg) \
+    if (false && (condition)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_OFF, msg)
+
 /**
  * @name logging utility macros with stream semantics
+ *
+ * Enabled statements format the message into a reused per-thread buffer and
+ * do not allocate memory unless the message exceeds
+ * rsc::logging::MessageBuffer::CAPACITY. Statements more verbose than
+ * #RSC_LOGGING_MIN_LEVEL are removed at compile time.
  */
 //@{
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_TRACE
 #define RSCTRACE(logger, msg) \
-    if (logger->isTraceEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg; \
-        logger->trace(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (logger->isLevelEnabled(rsc::logging::Logger::LEVEL_TRACE)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_TRACE, msg)
+#else
+#define RSCTRACE(logger, msg) \
+    RSC_LOG_DISCARDED_(true, logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_DEBUG
 #define RSCDEBUG(logger, msg) \
-    if (logger->isDebugEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg; \
-        logger->debug(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (logger->isLevelEnabled(rsc::logging::Logger::LEVEL_DEBUG)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_DEBUG, msg)
+#else
+#define RSCDEBUG(logger, msg) \
+    RSC_LOG_DISCARDED_(true, logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_INFO
 #define RSCINFO(logger, msg) \
-    if (logger->isInfoEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg; \
-        logger->info(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (logger->isLevelEnabled(rsc::logging::Logger::LEVEL_INFO)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_INFO, msg)
+#else
+#define RSCINFO(logger, msg) \
+    RSC_LOG_DISCARDED_(true, logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_WARN
 #define RSCWARN(logger, msg) \
-    if (logger->isWarnEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg; \
-        logger->warn(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (logger->isLevelEnabled(rsc::logging::Logger::LEVEL_WARN)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_WARN, msg)
+#else
+#define RSCWARN(logger, msg) \
+    RSC_LOG_DISCARDED_(true, logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_ERROR
 #define RSCERROR(logger, msg) \
-    if (logger->isErrorEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg; \
-        logger->error(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (logger->isLevelEnabled(rsc::logging::Logger::LEVEL_ERROR)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_ERROR, msg)
+#else
+#define RSCERROR(logger, msg) \
+    RSC_LOG_DISCARDED_(true, logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_FATAL
 #define RSCFATAL(logger, msg) \
-    if (logger->isFatalEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg; \
-        logger->fatal(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (logger->isLevelEnabled(rsc::logging::Logger::LEVEL_FATAL)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_FATAL, msg)
+#else
+#define RSCFATAL(logger, msg) \
+    RSC_LOG_DISCARDED_(true, logger, msg)
+#endif
 
 //@}
 
@@ -259,46 +416,70 @@ RSC_EXPORT std::ostream& operator<<(std::ostream& stream, const Logger::Level& l
  */
 //@{
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_TRACE
 #define RSCTRACE_EXPECT(condition, logger, msg) \
-    if (!(condition) && logger->isTraceEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg << "\nfailed condition: " << #condition; \
-        logger->trace(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (!(condition) \
+            && logger->isLevelEnabled(rsc::logging::Logger::LEVEL_TRACE)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_TRACE, \
+                msg << "\nfailed condition: " << #condition)
+#else
+#define RSCTRACE_EXPECT(condition, logger, msg) \
+    RSC_LOG_DISCARDED_(!(condition), logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_DEBUG
 #define RSCDEBUG_EXPECT(condition, logger, msg) \
-    if (!(condition) && logger->isDebugEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg << "\nfailed condition: " << #condition; \
-        logger->debug(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (!(condition) \
+            && logger->isLevelEnabled(rsc::logging::Logger::LEVEL_DEBUG)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_DEBUG, \
+                msg << "\nfailed condition: " << #condition)
+#else
+#define RSCDEBUG_EXPECT(condition, logger, msg) \
+    RSC_LOG_DISCARDED_(!(condition), logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_INFO
 #define RSCINFO_EXPECT(condition, logger, msg) \
-    if (!(condition) && logger->isInfoEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg << "\nfailed condition: " << #condition; \
-        logger->info(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (!(condition) \
+            && logger->isLevelEnabled(rsc::logging::Logger::LEVEL_INFO)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_INFO, \
+                msg << "\nfailed condition: " << #condition)
+#else
+#define RSCINFO_EXPECT(condition, logger, msg) \
+    RSC_LOG_DISCARDED_(!(condition), logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_WARN
 #define RSCWARN_EXPECT(condition, logger, msg) \
-    if (!(condition) && logger->isWarnEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg << "\nfailed condition: " << #condition; \
-        logger->warn(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (!(condition) \
+            && logger->isLevelEnabled(rsc::logging::Logger::LEVEL_WARN)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_WARN, \
+                msg << "\nfailed condition: " << #condition)
+#else
+#define RSCWARN_EXPECT(condition, logger, msg) \
+    RSC_LOG_DISCARDED_(!(condition), logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_ERROR
 #define RSCERROR_EXPECT(condition, logger, msg) \
-    if (!(condition) && logger->isErrorEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg << "\nfailed condition: " << #condition; \
-        logger->error(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (!(condition) \
+            && logger->isLevelEnabled(rsc::logging::Logger::LEVEL_ERROR)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_ERROR, \
+                msg << "\nfailed condition: " << #condition)
+#else
+#define RSCERROR_EXPECT(condition, logger, msg) \
+    RSC_LOG_DISCARDED_(!(condition), logger, msg)
+#endif
 
+#if RSC_LOGGING_MIN_LEVEL >= RSC_LOGGING_LEVEL_FATAL
 #define RSCFATAL_EXPECT(condition, logger, msg) \
-    if (!(condition) && logger->isFatalEnabled()) { \
-        std::stringstream iShouldNeverBeMatchedByClientCode; \
-        iShouldNeverBeMatchedByClientCode << msg << "\nfailed condition: " << #condition; \
-        logger->fatal(iShouldNeverBeMatchedByClientCode.str()); \
-    }
+    if (!(condition) \
+            && logger->isLevelEnabled(rsc::logging::Logger::LEVEL_FATAL)) \
+        RSC_LOG_MESSAGE_(logger, rsc::logging::Logger::LEVEL_FATAL, \
+                msg << "\nfailed condition: " << #condition)
+#else
+#define RSCFATAL_EXPECT(condition, logger, msg) \
+    RSC_LOG_DISCARDED_(!(condition), logger, msg)
+#endif
 
 //@}
@@ -76,7 +76,7 @@ public:
                 return false;
             }
 
-            node->getLoggerProxy()->getLogger()->setLevel(level);
+            node->getLoggerProxy()->setLoggerLevel(level);
 
             return true;
 
@@ -98,7 +98,7 @@ public:
     void call(LoggerProxyPtr /*proxy*/, const Logger::Level& level) {
         boost::recursive_mutex::scoped_lock lock(mutex);
         LoggerTreeNodePtr node = treeNode.lock();
-        node->getLoggerProxy()->getLogger()->setLevel(level);
+        node->getLoggerProxy()->setLoggerLevel(level);
         node->setAssignedLevel(level);
         // TODO we ignore the path anyways... Can this be done by the tree itself?
         node->visit(LoggerTreeNode::VisitorPtr(new LevelSetter(level)),
@@ -126,7 +126,7 @@ LoggerFactory::LoggerFactory() {
     // assign the initial level to the only logger available, which is the root logger
     // by directly assigning the level to the proxied logger we prevent the
     // callback mechanism from working uselessly
-    logger->setLevel(DEFAULT_LEVEL);
+    proxy->setLoggerLevel(DEFAULT_LEVEL);
     loggerTree->setAssignedLevel(DEFAULT_LEVEL);
 }
 
@@ -142,11 +142,10 @@ public:
 
     bool visit(const LoggerTreeNode::NamePath& path, LoggerTreeNodePtr node,
             const Logger::Level& /*parentLevel*/) {
-        const Logger::Level oldLevel =
-                node->getLoggerProxy()->getLogger()->getLevel();
+        const Logger::Level oldLevel = node->getLoggerProxy()->getLevel();
         node->getLoggerProxy()->setLogger(
                 newSystem->createLogger(LoggerTreeNode::pathToName(path)));
-        node->getLoggerProxy()->getLogger()->setLevel(oldLevel);
+        node->getLoggerProxy()->setLoggerLevel(oldLevel);
         return true;
     }
 private:
@@ -169,7 +168,7 @@ void LoggerFactory::reselectLoggingSystem(const std::string& nameHint) {
             const Logger::Level oldLevel = loggerTree->getLoggerProxy()->getLevel();
             loggerTree->getLoggerProxy()->setLogger(
                 loggingSystem->createLogger(""));
-            loggerTree->getLoggerProxy()->getLogger()->setLevel(oldLevel);
+            loggerTree->getLoggerProxy()->setLoggerLevel(oldLevel);
             loggerTree->visit(
                 LoggerTreeNode::VisitorPtr(new ReselectVisitor(loggingSystem)));
         }
@@ -187,8 +186,7 @@ LoggerProxyPtr LoggerFactory::createLogger(const LoggerTreeNode::NamePath& path,
                             new TreeLevelUpdater(LoggerTreeNodeWeakPtr(node),
                                     mutex))));
     // new level can be derived from parent logger
-    logger->setLevel(
-            node->getParent()->getLoggerProxy()->getLogger()->getLevel());
+    proxy->setLoggerLevel(node->getParent()->getLoggerProxy()->getLevel());
     return proxy;
 }
 
@@ -215,7 +213,7 @@ public:
         if (node->hasAssignedLevel()) {
             node->setAssignedLevel(newLevel);
         }
-        node->getLoggerProxy()->getLogger()->setLevel(newLevel);
+        node->getLoggerProxy()->setLoggerLevel(newLevel);
         return true;
 
     }
@@ -225,7 +223,7 @@ private:
 
 void LoggerFactory::reconfigure(const Logger::Level& level) {
     boost::recursive_mutex::scoped_lock lock(mutex);
-    loggerTree->getLoggerProxy()->getLogger()->setLevel(level);
+    loggerTree->getLoggerProxy()->setLoggerLevel(level);
     loggerTree->setAssignedLevel(level);
     loggerTree->visit(
             LoggerTreeNode::VisitorPtr(new ReconfigurationVisitor(level)));
@@ -34,13 +34,14 @@ LoggerProxy::SetLevelCallback::~SetLevelCallback() {
 
 LoggerProxy::LoggerProxy(LoggerPtr logger, SetLevelCallbackPtr callback) :
         logger(logger), callback(callback) {
+    cacheLevel(logger->getLevel());
 }
 
 LoggerProxy::~LoggerProxy() {
 }
 
 Logger::Level LoggerProxy::getLevel() const {
-    return logger->getLevel();
+    return getCachedLevel();
 }
 
 void LoggerProxy::setLevel(const Logger::Level& level) {
@@ -60,6 +61,16 @@ void LoggerProxy::log(const Logger::Level& level, const std::string& msg) {
     logger->log(level, msg);
 }
 
+void LoggerProxy::logView(const Logger::Level& level, const char* msg,
+        const std::size_t& length) {
+    logger->logView(level, msg, length);
+}
+
+void LoggerProxy::logAt(const Logger::Level& level, const CallSite& site,
+        const char* msg, const std::size_t& length) {
+    logger->logAt(level, site, msg, length);
+}
+
 LoggerPtr LoggerProxy::getLogger() const {
     return logger;
 }
@@ -68,5 +79,10 @@ void LoggerProxy::setLogger(LoggerPtr logger) {
     this->logger = logger;
 }
 
+void LoggerProxy::setLoggerLevel(const Logger::Level& level) {
+    logger->setLevel(level);
+    cacheLevel(level);
+}
+
 }
 }
@@ -38,6 +38,10 @@ namespace logging {
  * A proxy to an instance of Logger, which provides the same interface but
  * allows to exchange the underlying logger at runtime.
  *
+ * The level of the hidden logger is cached in the proxy so that level checks
+ * neither call into the hidden logger nor lock. Therefore, the level of the
+ * hidden logger must only be changed through #setLoggerLevel.
+ *
  * @author jwienke
  */
 class LoggerProxy: public Logger, public boost::enable_shared_from_this<
@@ -80,6 +84,10 @@ public:
     virtual std::string getName() const;
     virtual void setName(const std::string& name);
     virtual void log(const Logger::Level& level, const std::string& msg);
+    virtual void logView(const Logger::Level& level, const char* msg,
+            const std::size_t& length);
+    virtual void logAt(const Logger::Level& level, const CallSite& site,
+            const char* msg, const std::size_t& length);
 
     //@}
 
@@ -91,12 +99,22 @@ public:
 
     /**
      * (Re-)Sets the logger to be hidden behind this proxy. This may happen at
-     * any time and from any thread.
+     * any time and from any thread. The cached level is not changed, callers
+     * have to assign the desired level using #setLoggerLevel.
      *
      * @param logger new logger to hide
      */
     void setLogger(LoggerPtr logger);
 
+    /**
+     * Sets the level of the hidden logger and updates the cached level
+     * without invoking the callback. Used by the callback and the logger
+     * hierarchy to apply effective levels.
+     *
+     * @param level new level of the hidden logger
+     */
+    void setLoggerLevel(const Logger::Level& level);
+
 private:
 
     /**
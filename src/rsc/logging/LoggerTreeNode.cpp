@@ -107,7 +107,7 @@ void LoggerTreeNode::visit(VisitorPtr visitor, const NamePath& thisPath) {
         childPath.push_back(it->first);
 
         bool descend = visitor->visit(childPath, it->second,
-                loggerProxy->getLogger()->getLevel());
+                loggerProxy->getLevel());
         if (descend) {
             it->second->visit(visitor, childPath);
         }
@@ -26,6 +26,8 @@
 
 #include "LoggingSystemFactory.h"
 
+#include "AsyncLoggingSystem.h"
+#include "BinaryLoggingSystem.h"
 #include "ConsoleLoggingSystem.h"
 
 namespace rsc {
@@ -33,6 +35,8 @@ namespace logging {
 
 LoggingSystemFactory::LoggingSystemFactory() {
     impls().register_("console", &ConsoleLoggingSystem::create);
+    impls().register_("async", &AsyncLoggingSystem::create);
+    impls().register_("binary", &BinaryLoggingSystem::create);
 }
 
 LoggingSystemFactory::~LoggingSystemFactory() {}
@@ -0,0 +1,192 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "MessageBuffer.h"
+
+#include <cstring>
+#include <streambuf>
+#include <string>
+
+#include <boost/thread/tss.hpp>
+
+using namespace std;
+
+namespace rsc {
+namespace logging {
+
+const size_t MessageBuffer::CAPACITY;
+
+/**
+ * Keeps spilled strings up to this size for reuse.
+ */
+static const size_t MAX_RETAINED_SPILL = 64 * MessageBuffer::CAPACITY;
+
+/**
+ * The per-thread stream and its buffer.
+ *
+ * @author jwienke
+ */
+class MessageBuffer::Storage: private boost::noncopyable {
+public:
+
+    /**
+     * Writes into a fixed array and into a string once the array is full.
+     *
+     * @author jwienke
+     */
+    class Buffer: public streambuf {
+    public:
+
+        Buffer() :
+                spilled(false) {
+            setp(fixed, fixed + CAPACITY);
+        }
+
+        void reset() {
+            if (spill.capacity() > MAX_RETAINED_SPILL) {
+                string().swap(spill);
+            } else {
+                spill.clear();
+            }
+            spilled = false;
+            setp(fixed, fixed + CAPACITY);
+        }
+
+        const char* data() const {
+            return spilled ? spill.data() : fixed;
+        }
+
+        size_t size() const {
+            return spilled ? spill.size() : size_t(pptr() - pbase());
+        }
+
+    protected:
+
+        int overflow(int c) {
+            spillOver();
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                spill.push_back(traits_type::to_char_type(c));
+            }
+            return traits_type::not_eof(c);
+        }
+
+        streamsize xsputn(const char* s, streamsize n) {
+            if (!spilled && n <= epptr() - pptr()) {
+                memcpy(pptr(), s, n);
+                pbump(int(n));
+            } else {
+                spillOver();
+                spill.append(s, n);
+            }
+            return n;
+        }
+
+    private:
+
+        void spillOver() {
+            if (!spilled) {
+                spill.assign(pbase(), pptr());
+                spilled = true;
+                // route all further output through overflow and xsputn
+                setp(0, 0);
+            }
+        }
+
+        char fixed[CAPACITY];
+        string spill;
+        bool spilled;
+
+    };
+
+    Storage() :
+            stream(&buffer), inUse(false), flags(stream.flags()), precision(
+                    stream.precision()), fill(stream.fill()) {
+    }
+
+    void release() {
+        buffer.reset();
+        stream.clear();
+        stream.flags(flags);
+        stream.precision(precision);
+        stream.width(0);
+        stream.fill(fill);
+        inUse = false;
+    }
+
+    Buffer buffer;
+    ostream stream;
+    bool inUse;
+
+private:
+    ios_base::fmtflags flags;
+    streamsize precision;
+    char fill;
+
+};
+
+MessageBuffer::Storage* MessageBuffer::threadStorage() {
+    // never destroyed to allow logging during static destruction
+    static boost::thread_specific_ptr<Storage>* storages =
+            new boost::thread_specific_ptr<Storage>;
+    Storage* storage = storages->get();
+    if (!storage) {
+        storage = new Storage;
+        storages->reset(storage);
+    }
+    return storage;
+}
+
+MessageBuffer::MessageBuffer() :
+        storage(threadStorage()), owned(false) {
+    if (storage->inUse) {
+        storage = new Storage;
+        owned = true;
+    }
+    storage->inUse = true;
+}
+
+MessageBuffer::~MessageBuffer() {
+    if (owned) {
+        delete storage;
+    } else {
+        storage->release();
+    }
+}
+
+ostream& MessageBuffer::stream() {
+    return storage->stream;
+}
+
+const char* MessageBuffer::data() const {
+    return storage->buffer.data();
+}
+
+size_t MessageBuffer::size() const {
+    return storage->buffer.size();
+}
+
+}
+}
@@ -0,0 +1,106 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include <boost/noncopyable.hpp>
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace logging {
+
+/**
+ * Formats log messages for the logging macros without allocating memory.
+ * Each thread reuses a stream writing into a buffer with a fixed capacity.
+ * Only messages exceeding #CAPACITY spill over into a heap-allocated string,
+ * which is kept for the next oversized message. Formatting flags changed on
+ * the stream are reset for the next message.
+ *
+ * Messages formatted while another one is formatted in the same thread, e.g.
+ * because an output operator logs itself, use a buffer of their own.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT MessageBuffer: private boost::noncopyable {
+public:
+
+    /**
+     * Number of characters a message can have without spilling over.
+     */
+    static const std::size_t CAPACITY = 1024;
+
+    /**
+     * Acquires the buffer of the calling thread.
+     */
+    MessageBuffer();
+
+    /**
+     * Releases the buffer for the next message.
+     */
+    ~MessageBuffer();
+
+    /**
+     * Returns the stream to format the message with.
+     *
+     * @return stream writing into this buffer
+     */
+    std::ostream& stream();
+
+    /**
+     * Returns the formatted characters, not null-terminated.
+     *
+     * @return pointer to the characters, valid until the next write or the
+     *         destruction of this instance
+     */
+    const char* data() const;
+
+    /**
+     * Returns the number of formatted characters.
+     *
+     * @return number of characters
+     */
+    std::size_t size() const;
+
+private:
+
+    class Storage;
+
+    /**
+     * Returns the storage of the calling thread, created on first use.
+     */
+    static Storage* threadStorage();
+
+    Storage* storage;
+    bool owned;
+
+};
+
+}
+}
@@ -46,23 +46,24 @@ std::ostream& SGRConsoleLogger::printHeader(std::ostream& stream, const Level& l
 
 std::ostream& SGRConsoleLogger::printBody(std::ostream&      stream,
                                           const Level&       level,
-                                          const std::string& msg) {
+                                          const char*        msg,
+                                          const std::size_t& length) {
     switch (level) {
     case LEVEL_TRACE:
     case LEVEL_DEBUG:
-        return stream << "[2m" << msg << "[0m" << std::endl;
+        return (stream << "[2m").write(msg, length) << "[0m" << std::endl;
         break;
     case LEVEL_WARN:
-        return stream << "[32m" << msg << "[0m" << std::endl;
+        return (stream << "[32m").write(msg, length) << "[0m" << std::endl;
         break;
     case LEVEL_ERROR:
-        return stream << "[31m" << msg << "[0m" << std::endl;
+        return (stream << "[31m").write(msg, length) << "[0m" << std::endl;
         break;
     case LEVEL_FATAL:
-        return stream << "[31;1m" << msg << "[0m" << std::endl;
+        return (stream << "[31;1m").write(msg, length) << "[0m" << std::endl;
         break;
     default:
-        return stream << msg << std::endl;
+        return stream.write(msg, length) << std::endl;
         break;
     }
 }
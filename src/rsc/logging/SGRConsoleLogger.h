@@ -51,7 +51,8 @@ protected:
 
     std::ostream& printBody(std::ostream&      stream,
                             const Level&       level,
-                            const std::string& msg);
+                            const char*        msg,
+                            const std::size_t& length);
 
 };
 
@@ -0,0 +1,185 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "Histogram.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace rsc {
+namespace misc {
+
+const unsigned int Histogram::RANGE_BITS;
+const unsigned int Histogram::MAX_PRECISION;
+const unsigned int Histogram::BUCKETS;
+
+Histogram::Histogram(const unsigned int& precision) :
+        precision(precision) {
+    if (precision > MAX_PRECISION) {
+        throw std::invalid_argument("Histogram precision too large");
+    }
+    buckets.resize(numBuckets(precision));
+    clear();
+}
+
+void Histogram::record(const boost::uint64_t& value) {
+    ++buckets[bucketFor(value, precision)];
+    if (count == 0 || value < min) {
+        min = value;
+    }
+    if (value > max) {
+        max = value;
+    }
+    ++count;
+    sum += value;
+}
+
+void Histogram::merge(const Histogram& other) {
+    if (other.precision != precision) {
+        throw std::invalid_argument(
+                "Cannot merge histograms with different precisions");
+    }
+    if (other.count == 0) {
+        return;
+    }
+    for (unsigned int i = 0; i < buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    if (count == 0 || other.min < min) {
+        min = other.min;
+    }
+    max = std::max(max, other.max);
+    count += other.count;
+    sum += other.sum;
+}
+
+void Histogram::clear() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    count = 0;
+    sum = 0;
+    min = 0;
+    max = 0;
+}
+
+boost::uint64_t Histogram::getCount() const {
+    return count;
+}
+
+boost::uint64_t Histogram::getMin() const {
+    return min;
+}
+
+boost::uint64_t Histogram::getMax() const {
+    return max;
+}
+
+double Histogram::getMean() const {
+    if (count == 0) {
+        return 0;
+    }
+    return double(sum) / double(count);
+}
+
+boost::uint64_t Histogram::getQuantile(const double& quantile) const {
+
+    if (count == 0) {
+        return 0;
+    }
+
+    // rank of the requested value, at least the first one
+    const double clamped = std::min(std::max(quantile, 0.0), 1.0);
+    const boost::uint64_t rank = std::max(boost::uint64_t(1),
+            boost::uint64_t(clamped * count + 0.5));
+    boost::uint64_t seen = 0;
+    for (unsigned int i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(getBucketUpperBound(i, precision), max);
+        }
+    }
+    return max;
+
+}
+
+boost::uint64_t Histogram::getBucketCount(const unsigned int& bucket) const {
+    if (bucket >= buckets.size()) {
+        throw std::out_of_range("Invalid bucket index");
+    }
+    return buckets[bucket];
+}
+
+unsigned int Histogram::getPrecision() const {
+    return precision;
+}
+
+unsigned int Histogram::numBuckets(const unsigned int& precision) {
+    // exact buckets for values below 2^precision, then 2^precision buckets
+    // per power of two
+    return (1u << precision) * (RANGE_BITS - precision + 1);
+}
+
+boost::uint64_t Histogram::getBucketUpperBound(const unsigned int& bucket,
+        const unsigned int& precision) {
+    if (bucket >= numBuckets(precision)) {
+        throw std::out_of_range("Invalid bucket index");
+    }
+    const unsigned int subBuckets = 1u << precision;
+    if (bucket < subBuckets) {
+        return bucket;
+    }
+    // bucket covers [(subBuckets + sub) << shift, ... + 1 << shift)
+    const unsigned int shift = (bucket - subBuckets) / subBuckets;
+    const boost::uint64_t sub = (bucket - subBuckets) % subBuckets;
+    return ((subBuckets + sub + 1) << shift) - 1;
+}
+
+unsigned int Histogram::bucketFor(const boost::uint64_t& value,
+        const unsigned int& precision) {
+    const unsigned int subBuckets = 1u << precision;
+    if (value < subBuckets) {
+        return value;
+    }
+    unsigned int magnitude = 0;
+    for (boost::uint64_t v = value; v != 0; v >>= 1) {
+        ++magnitude;
+    }
+    const unsigned int shift = magnitude - 1 - precision;
+    const boost::uint64_t bucket = subBuckets + boost::uint64_t(shift)
+            * subBuckets + ((value >> shift) - subBuckets);
+    return std::min<boost::uint64_t>(bucket, numBuckets(precision) - 1);
+}
+
+std::ostream& operator<<(std::ostream& stream, const Histogram& histogram) {
+    return stream << "Histogram[count = " << histogram.getCount()
+            << ", min = " << histogram.getMin() << ", mean = "
+            << histogram.getMean() << ", p50 = "
+            << histogram.getQuantile(0.5) << ", p99 = "
+            << histogram.getQuantile(0.99) << ", max = "
+            << histogram.getMax() << "]";
+}
+
+}
+}
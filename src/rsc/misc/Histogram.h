@@ -0,0 +1,197 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace misc {
+
+/**
+ * A histogram of non-negative integer values, e.g. durations in
+ * microseconds, with buckets of exponentially growing width. With the
+ * default precision of 0, bucket 0 counts the value 0 and bucket @c i > 0
+ * counts values in [2^(i-1), 2^i). A precision of @c p splits each power of
+ * two into 2^p buckets like in an HdrHistogram: values below 2^p are counted
+ * exactly and quantiles of larger values are off by at most 1 / 2^p of their
+ * value. Values of 2^#RANGE_BITS and more are counted in the last bucket.
+ * Recording a value is a few arithmetic operations and does not allocate
+ * memory. Instances are not synchronized.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT Histogram {
+public:
+
+    /**
+     * log2 of the smallest value counted in the last bucket.
+     */
+    static const unsigned int RANGE_BITS = 32;
+
+    /**
+     * Largest supported precision.
+     */
+    static const unsigned int MAX_PRECISION = 16;
+
+    /**
+     * Number of buckets with the default precision.
+     */
+    static const unsigned int BUCKETS = RANGE_BITS + 1;
+
+    /**
+     * Creates an empty histogram.
+     *
+     * @param precision log2 of the number of buckets per power of two
+     * @throw std::invalid_argument precision larger than #MAX_PRECISION
+     */
+    explicit Histogram(const unsigned int& precision = 0);
+
+    /**
+     * Adds a value to the histogram.
+     *
+     * @param value value to add
+     */
+    void record(const boost::uint64_t& value);
+
+    /**
+     * Adds all values recorded in @a other to this histogram.
+     *
+     * @param other histogram to merge
+     * @throw std::invalid_argument @a other has a different precision
+     */
+    void merge(const Histogram& other);
+
+    /**
+     * Removes all recorded values.
+     */
+    void clear();
+
+    /**
+     * Returns the number of recorded values.
+     *
+     * @return number of values
+     */
+    boost::uint64_t getCount() const;
+
+    /**
+     * Returns the smallest recorded value.
+     *
+     * @return minimum or 0 if no value was recorded
+     */
+    boost::uint64_t getMin() const;
+
+    /**
+     * Returns the largest recorded value.
+     *
+     * @return maximum or 0 if no value was recorded
+     */
+    boost::uint64_t getMax() const;
+
+    /**
+     * Returns the arithmetic mean of all recorded values.
+     *
+     * @return mean or 0 if no value was recorded
+     */
+    double getMean() const;
+
+    /**
+     * Returns an upper bound for the given quantile of the recorded values,
+     * i.e. the upper bound of the bucket which contains the quantile, capped
+     * at the maximum.
+     *
+     * @param quantile quantile in [0, 1], e.g. 0.99
+     * @return upper bound of the quantile or 0 if no value was recorded
+     */
+    boost::uint64_t getQuantile(const double& quantile) const;
+
+    /**
+     * Returns the number of values in the given bucket.
+     *
+     * @param bucket bucket index < #numBuckets
+     * @return count of values in the bucket
+     * @throw std::out_of_range invalid bucket index
+     */
+    boost::uint64_t getBucketCount(const unsigned int& bucket) const;
+
+    /**
+     * Returns the precision of this histogram.
+     *
+     * @return log2 of the number of buckets per power of two
+     */
+    unsigned int getPrecision() const;
+
+    /**
+     * Returns the number of buckets of histograms with the given precision.
+     *
+     * @param precision log2 of the number of buckets per power of two
+     * @return number of buckets
+     */
+    static unsigned int numBuckets(const unsigned int& precision = 0);
+
+    /**
+     * Returns the largest value counted by the given bucket, except for the
+     * last bucket which counts all larger values as well.
+     *
+     * @param bucket bucket index < #numBuckets
+     * @param precision log2 of the number of buckets per power of two
+     * @return upper bound of the bucket
+     * @throw std::out_of_range invalid bucket index
+     */
+    static boost::uint64_t getBucketUpperBound(const unsigned int& bucket,
+            const unsigned int& precision = 0);
+
+    /**
+     * Returns the index of the bucket counting @a value.
+     *
+     * @param value value to find the bucket for
+     * @param precision log2 of the number of buckets per power of two
+     * @return bucket index
+     */
+    static unsigned int bucketFor(const boost::uint64_t& value,
+            const unsigned int& precision = 0);
+
+protected:
+
+    unsigned int precision;
+    std::vector<boost::uint64_t> buckets;
+    boost::uint64_t count;
+    boost::uint64_t sum;
+    boost::uint64_t min;
+    boost::uint64_t max;
+
+};
+
+RSC_EXPORT std::ostream& operator<<(std::ostream& stream,
+        const Histogram& histogram);
+
+}
+}
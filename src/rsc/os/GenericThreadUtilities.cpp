@@ -0,0 +1,53 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "ThreadUtilities.h"
+
+#include <stdexcept>
+
+#include "../misc/UnsupportedOperationException.h"
+
+namespace rsc {
+namespace os {
+
+void setThreadAffinity(boost::thread& /*thread*/,
+        const std::vector<unsigned int>& cpus) {
+    if (cpus.empty()) {
+        throw std::invalid_argument("At least one CPU is required");
+    }
+    throw rsc::misc::UnsupportedOperationException(
+            "Thread affinity is not supported on this platform");
+}
+
+void setThreadName(boost::thread& /*thread*/, const std::string& /*name*/) {
+}
+
+unsigned int numaNodeOfCpu(const unsigned int& /*cpu*/) {
+    return 0;
+}
+
+}
+}
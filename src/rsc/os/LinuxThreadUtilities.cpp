@@ -0,0 +1,110 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "ThreadUtilities.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace rsc {
+namespace os {
+
+void setThreadAffinity(boost::thread& thread,
+        const std::vector<unsigned int>& cpus) {
+
+    if (cpus.empty()) {
+        throw std::invalid_argument("At least one CPU is required");
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (std::vector<unsigned int>::const_iterator it = cpus.begin();
+            it != cpus.end(); ++it) {
+        if (*it >= CPU_SETSIZE) {
+            throw std::invalid_argument(
+                    boost::str(boost::format("Invalid CPU index %1%") % *it));
+        }
+        CPU_SET(*it, &set);
+    }
+
+    const int result = pthread_setaffinity_np(thread.native_handle(),
+            sizeof(set), &set);
+    if (result != 0) {
+        throw std::runtime_error(
+                boost::str(
+                        boost::format("Could not set thread affinity since"
+                                " pthread_setaffinity_np(3) failed: %1%")
+                                % strerror(result)));
+    }
+
+}
+
+void setThreadName(boost::thread& thread, const std::string& name) {
+    // the kernel limits names to 16 bytes including the terminator
+    const int result = pthread_setname_np(thread.native_handle(),
+            name.substr(0, 15).c_str());
+    if (result != 0) {
+        throw std::runtime_error(
+                boost::str(
+                        boost::format("Could not set thread name since"
+                                " pthread_setname_np(3) failed: %1%")
+                                % strerror(result)));
+    }
+}
+
+unsigned int numaNodeOfCpu(const unsigned int& cpu) {
+
+    // the CPU directory contains a link nodeN to its NUMA node
+    const boost::filesystem::path cpuDir(
+            "/sys/devices/system/cpu/cpu" + boost::lexical_cast<std::string>(cpu));
+    boost::system::error_code error;
+    boost::filesystem::directory_iterator it(cpuDir, error);
+    if (error) {
+        return 0;
+    }
+    for (; it != boost::filesystem::directory_iterator(); ++it) {
+        const std::string name = it->path().filename().string();
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0) {
+            try {
+                return boost::lexical_cast<unsigned int>(name.substr(4));
+            } catch (const boost::bad_lexical_cast&) {
+                // unrelated entry
+            }
+        }
+    }
+    return 0;
+
+}
+
+}
+}
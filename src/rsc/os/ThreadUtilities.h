@@ -0,0 +1,87 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace os {
+
+/**
+ * @defgroup os_thread_utilities Thread Placement Functions
+ * @{
+ *
+ * Functions to control where threads are executed. Not all platforms
+ * support all of them.
+ */
+
+/**
+ * Restricts the execution of @a thread to the given CPUs.
+ *
+ * @param thread running thread to pin
+ * @param cpus indices of the CPUs the thread may run on, must not be empty
+ *
+ * @throw std::invalid_argument If @a cpus is empty.
+ * @throw std::runtime_error If the affinity could not be set.
+ * @throw rsc::misc::UnsupportedOperationException If the platform does not
+ *                                                  support CPU affinity.
+ */
+RSC_EXPORT void setThreadAffinity(boost::thread& thread,
+        const std::vector<unsigned int>& cpus);
+
+/**
+ * Assigns a name to @a thread which is displayed by debuggers and
+ * profilers. Names may be truncated by the platform, e.g. to 15
+ * characters on Linux. Does nothing on platforms without thread names.
+ *
+ * @param thread running thread to name
+ * @param name the new name
+ *
+ * @throw std::runtime_error If the name could not be set.
+ */
+RSC_EXPORT void setThreadName(boost::thread& thread, const std::string& name);
+
+/**
+ * Determines the NUMA node a CPU belongs to.
+ *
+ * @param cpu index of the CPU
+ * @return index of the NUMA node or 0 if the platform does not provide
+ *         NUMA information
+ */
+RSC_EXPORT unsigned int numaNodeOfCpu(const unsigned int& cpu);
+
+/**
+ * @}
+ */
+
+}
+}
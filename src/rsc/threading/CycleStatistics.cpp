@@ -0,0 +1,147 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "CycleStatistics.h"
+
+#include <boost/thread.hpp>
+
+namespace rsc {
+namespace threading {
+
+const unsigned int CycleStatistics::PRECISION;
+const unsigned int CycleStatistics::SUB_BUCKETS;
+const unsigned int CycleStatistics::BUCKETS;
+
+CycleStatistics::CycleStatistics() :
+        Histogram(PRECISION), last(0), overruns(0) {
+}
+
+boost::uint64_t CycleStatistics::getLast() const {
+    return last;
+}
+
+boost::uint64_t CycleStatistics::getOverruns() const {
+    return overruns;
+}
+
+boost::uint64_t CycleStatistics::getBucketUpperBound(
+        const unsigned int& bucket) {
+    return Histogram::getBucketUpperBound(bucket, PRECISION);
+}
+
+unsigned int CycleStatistics::bucketFor(const boost::uint64_t& value) {
+    return Histogram::bucketFor(value, PRECISION);
+}
+
+std::ostream& operator<<(std::ostream& stream,
+        const CycleStatistics& statistics) {
+    return stream << "CycleStatistics[last = " << statistics.getLast()
+            << ", overruns = " << statistics.getOverruns() << ", "
+            << static_cast<const rsc::misc::Histogram&>(statistics) << "]";
+}
+
+CycleStatisticsRecorder::CycleStatisticsRecorder() :
+        sequence(0), count(0), sum(0), last(0), min(0), max(0), overruns(0), budget(
+                0) {
+    for (unsigned int i = 0; i < CycleStatistics::BUCKETS; ++i) {
+        buckets[i].store(0, boost::memory_order_relaxed);
+    }
+}
+
+void CycleStatisticsRecorder::setBudget(const boost::uint64_t& budgetMus) {
+    budget.store(budgetMus, boost::memory_order_relaxed);
+}
+
+boost::uint64_t CycleStatisticsRecorder::getBudget() const {
+    return budget.load(boost::memory_order_relaxed);
+}
+
+void CycleStatisticsRecorder::add(boost::atomic<boost::uint64_t>& counter,
+        const boost::uint64_t& value) {
+    // single writer, hence no atomic read-modify-write required
+    counter.store(counter.load(boost::memory_order_relaxed) + value,
+            boost::memory_order_relaxed);
+}
+
+void CycleStatisticsRecorder::record(const boost::uint64_t& durationMus) {
+
+    const boost::uint64_t begin = sequence.load(boost::memory_order_relaxed);
+    sequence.store(begin + 1, boost::memory_order_relaxed);
+    boost::atomic_thread_fence(boost::memory_order_release);
+
+    add(buckets[CycleStatistics::bucketFor(durationMus)], 1);
+    if (count.load(boost::memory_order_relaxed) == 0
+            || durationMus < min.load(boost::memory_order_relaxed)) {
+        min.store(durationMus, boost::memory_order_relaxed);
+    }
+    if (durationMus > max.load(boost::memory_order_relaxed)) {
+        max.store(durationMus, boost::memory_order_relaxed);
+    }
+    const boost::uint64_t limit = budget.load(boost::memory_order_relaxed);
+    if (limit != 0 && durationMus > limit) {
+        add(overruns, 1);
+    }
+    last.store(durationMus, boost::memory_order_relaxed);
+    add(sum, durationMus);
+    add(count, 1);
+
+    sequence.store(begin + 2, boost::memory_order_release);
+
+}
+
+CycleStatistics CycleStatisticsRecorder::snapshot() const {
+
+    CycleStatistics result;
+    while (true) {
+
+        const boost::uint64_t begin = sequence.load(
+                boost::memory_order_acquire);
+        if (begin % 2 != 0) {
+            boost::this_thread::yield();
+            continue;
+        }
+
+        for (unsigned int i = 0; i < CycleStatistics::BUCKETS; ++i) {
+            result.buckets[i] = buckets[i].load(boost::memory_order_relaxed);
+        }
+        result.count = count.load(boost::memory_order_relaxed);
+        result.sum = sum.load(boost::memory_order_relaxed);
+        result.last = last.load(boost::memory_order_relaxed);
+        result.min = min.load(boost::memory_order_relaxed);
+        result.max = max.load(boost::memory_order_relaxed);
+        result.overruns = overruns.load(boost::memory_order_relaxed);
+
+        boost::atomic_thread_fence(boost::memory_order_acquire);
+        if (sequence.load(boost::memory_order_relaxed) == begin) {
+            return result;
+        }
+
+    }
+
+}
+
+}
+}
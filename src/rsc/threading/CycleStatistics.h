@@ -0,0 +1,180 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <ostream>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "rsc/misc/Histogram.h"
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace threading {
+
+/**
+ * A snapshot of the durations of the cycles of a RepetitiveTask in
+ * microseconds. Durations are counted in a Histogram with #SUB_BUCKETS
+ * buckets per power of two, hence quantiles are off by at most
+ * 1 / #SUB_BUCKETS of their value.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT CycleStatistics: public rsc::misc::Histogram {
+public:
+
+    /**
+     * Precision of the histogram, see rsc::misc::Histogram.
+     */
+    static const unsigned int PRECISION = 3;
+
+    /**
+     * Number of buckets per power of two.
+     */
+    static const unsigned int SUB_BUCKETS = 1 << PRECISION;
+
+    /**
+     * Number of buckets.
+     */
+    static const unsigned int BUCKETS = SUB_BUCKETS
+            * (RANGE_BITS - PRECISION + 1);
+
+    CycleStatistics();
+
+    /**
+     * Returns the duration of the most recent cycle.
+     *
+     * @return duration or 0 if no cycle was recorded
+     */
+    boost::uint64_t getLast() const;
+
+    /**
+     * Returns the number of cycles which took longer than the cycle budget,
+     * e.g. the cycle time of a PeriodicTask.
+     *
+     * @return number of overruns
+     */
+    boost::uint64_t getOverruns() const;
+
+    /**
+     * Returns the largest value counted by the given bucket with the
+     * precision of cycle statistics.
+     *
+     * @param bucket bucket index < BUCKETS
+     * @return upper bound of the bucket
+     * @throw std::out_of_range invalid bucket index
+     */
+    static boost::uint64_t getBucketUpperBound(const unsigned int& bucket);
+
+    /**
+     * Returns the index of the bucket counting @a value with the precision
+     * of cycle statistics.
+     *
+     * @param value value to find the bucket for
+     * @return bucket index
+     */
+    static unsigned int bucketFor(const boost::uint64_t& value);
+
+private:
+
+    friend class CycleStatisticsRecorder;
+
+    boost::uint64_t last;
+    boost::uint64_t overruns;
+
+};
+
+RSC_EXPORT std::ostream& operator<<(std::ostream& stream,
+        const CycleStatistics& statistics);
+
+/**
+ * Records cycle durations and provides CycleStatistics snapshots. Recording
+ * must happen from one thread at a time and never blocks or takes a lock.
+ * Snapshots can be taken concurrently from any thread. They are consistent,
+ * i.e. they never contain half of a recorded cycle, and are retried if a
+ * cycle was recorded while copying.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT CycleStatisticsRecorder: private boost::noncopyable {
+public:
+
+    CycleStatisticsRecorder();
+
+    /**
+     * Sets the duration above which cycles count as overruns.
+     *
+     * @param budgetMus budget in microseconds, 0 to not count overruns
+     */
+    void setBudget(const boost::uint64_t& budgetMus);
+
+    /**
+     * Returns the duration above which cycles count as overruns.
+     *
+     * @return budget in microseconds, 0 if overruns are not counted
+     */
+    boost::uint64_t getBudget() const;
+
+    /**
+     * Records the duration of a cycle. Must not be called concurrently.
+     *
+     * @param durationMus duration in microseconds
+     */
+    void record(const boost::uint64_t& durationMus);
+
+    /**
+     * Returns a consistent copy of the recorded values.
+     *
+     * @return statistics snapshot
+     */
+    CycleStatistics snapshot() const;
+
+private:
+
+    void add(boost::atomic<boost::uint64_t>& counter,
+            const boost::uint64_t& value);
+
+    /**
+     * Odd while a cycle is recorded.
+     */
+    boost::atomic<boost::uint64_t> sequence;
+
+    boost::atomic<boost::uint64_t> buckets[CycleStatistics::BUCKETS];
+    boost::atomic<boost::uint64_t> count;
+    boost::atomic<boost::uint64_t> sum;
+    boost::atomic<boost::uint64_t> last;
+    boost::atomic<boost::uint64_t> min;
+    boost::atomic<boost::uint64_t> max;
+    boost::atomic<boost::uint64_t> overruns;
+    boost::atomic<boost::uint64_t> budget;
+
+};
+
+}
+}
@@ -43,5 +43,13 @@ FutureTimeoutException::FutureTimeoutException(const string& message):
     FutureException(message) {
 }
 
+WhenAnyCollector::WhenAnyCollector() :
+        done(false), future(new Future<size_t>) {
+}
+
+boost::shared_ptr<Future<size_t> > WhenAnyCollector::getFuture() const {
+    return future;
+}
+
 }
 }
@@ -27,12 +27,22 @@
 #pragma once
 
 #include <stdexcept>
+#include <vector>
 
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/format.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition.hpp>
 
+#include "SimpleTask.h"
+#include "TaskExecutor.h"
+#include "../misc/IllegalStateException.h"
 #include "rsc/rscexports.h"
 
 namespace rsc {
@@ -92,21 +102,198 @@ public:
  * running. If the result is requested before the task finished, the ::get
  * operation will block until a results or error is available.
  *
+ * Instead of blocking, callbacks can be registered with #addCallback and
+ * further processing can be chained with #then. See also ::whenAll and
+ * ::whenAny.
+ *
+ * The completion state is kept in an atomic status word. Hence, #isDone and
+ * #get on a completed future do not lock. Errors are stored as
+ * boost::exception_ptr so that #get rethrows the original exception.
+ *
+ * A future can only be completed once, either with #set or #setError.
+ * Completing it a second time throws rsc::misc::IllegalStateException and
+ * keeps the first result or error. Earlier versions silently overwrote the
+ * result instead, so producers which may complete a future more than once
+ * have to check #isDone or catch the exception.
+ *
  * @author jwienke
- * @tparam R result type, should be copyable but this is not a hard requirement
+ * @tparam R result type, should be copyable. Move-only types are supported by
+ *           #set and #take.
  */
 template<class R>
 class Future {
+public:
+
+    /**
+     * A function called with a completed future.
+     */
+    typedef boost::function<void(Future<R>&)> Callback;
+
 protected:
     typedef boost::mutex MutexType;
     typedef boost::condition ConditionType;
 private:
-    R result;
-    bool taskFinished;
-    bool taskError;
-    std::string errorMsg;
-    ConditionType condition;
-    MutexType mutex;
+
+    enum Status {
+        PENDING, COMPLETING, SUCCEEDED, FAILED, TAKEN
+    };
+
+    struct PendingCallback {
+        Callback callback;
+        TaskExecutorPtr executor;
+    };
+
+    /**
+     * The state of a future, shared with callbacks running on executors.
+     */
+    struct State {
+        State() :
+                status(PENDING) {
+        }
+        boost::atomic<int> status;
+        R result;
+        boost::exception_ptr error;
+        MutexType mutex;
+        ConditionType condition;
+        std::vector<PendingCallback> callbacks;
+    };
+
+    /**
+     * Runs a callback with a completed future on a TaskExecutor.
+     *
+     * @author jwienke
+     */
+    class CallbackTask: public SimpleTask {
+    public:
+
+        CallbackTask(const Callback& callback, boost::shared_ptr<State> state) :
+                callback(callback), state(state) {
+        }
+
+        void run() {
+            if (!isCancelRequested()) {
+                Future<R> completed(state);
+                callback(completed);
+            }
+            markDone();
+        }
+
+    private:
+        Callback callback;
+        boost::shared_ptr<State> state;
+    };
+
+    boost::shared_ptr<State> state;
+
+    explicit Future(boost::shared_ptr<State> state) :
+            state(state) {
+    }
+
+    Future(const Future<R>&);
+    Future<R>& operator=(const Future<R>&);
+
+    /**
+     * Waits until the future is completed.
+     *
+     * @param timeout seconds to wait, <= 0 to wait forever
+     * @return final status
+     */
+    int waitCompleted(const double& timeout) {
+
+        // fast path for completed futures
+        int status = state->status.load(boost::memory_order_acquire);
+        if (status >= SUCCEEDED) {
+            return status;
+        }
+
+        const boost::system_time deadline = boost::get_system_time()
+                + boost::posix_time::microseconds(
+                        boost::int64_t(timeout * 1000000));
+        MutexType::scoped_lock lock(state->mutex);
+        while ((status = state->status.load(boost::memory_order_acquire))
+                < SUCCEEDED) {
+            if (timeout <= 0) {
+                state->condition.wait(lock);
+            } else if (!state->condition.timed_wait(lock, deadline)) {
+                if (state->status.load(boost::memory_order_acquire)
+                        >= SUCCEEDED) {
+                    continue;
+                }
+                throw FutureTimeoutException(
+                        boost::str(
+                                boost::format(
+                                        "Timeout while waiting for result. Waited %1% seconds.")
+                                        % timeout));
+            }
+        }
+        return status;
+
+    }
+
+    /**
+     * Throws for failed or taken futures.
+     */
+    void checkResult(const int& status) const {
+        if (status == FAILED) {
+            boost::rethrow_exception(state->error);
+        } else if (status == TAKEN) {
+            throw rsc::misc::IllegalStateException(
+                    "The result of this future was already taken");
+        }
+    }
+
+    /**
+     * Claims the right to complete this future.
+     *
+     * @throw rsc::misc::IllegalStateException already completed
+     */
+    void claim() {
+        int expected = PENDING;
+        if (!state->status.compare_exchange_strong(expected, COMPLETING,
+                boost::memory_order_acq_rel)) {
+            throw rsc::misc::IllegalStateException(
+                    "This future is already completed");
+        }
+    }
+
+    /**
+     * Publishes the outcome, wakes up waiting threads and runs the
+     * callbacks.
+     */
+    void complete(const Status& status) {
+        std::vector<PendingCallback> pending;
+        {
+            MutexType::scoped_lock lock(state->mutex);
+            state->status.store(status, boost::memory_order_release);
+            pending.swap(state->callbacks);
+        }
+        state->condition.notify_all();
+        for (typename std::vector<PendingCallback>::const_iterator it =
+                pending.begin(); it != pending.end(); ++it) {
+            dispatch(*it);
+        }
+    }
+
+    void dispatch(const PendingCallback& pending) {
+        if (pending.executor) {
+            pending.executor->schedule(
+                    TaskPtr(new CallbackTask(pending.callback, state)));
+        } else {
+            pending.callback(*this);
+        }
+    }
+
+    template<class T>
+    static void continueWith(
+            const boost::function<T(Future<R>&)>& continuation,
+            boost::shared_ptr<Future<T> > next, Future<R>& completed) {
+        try {
+            next->set(continuation(completed));
+        } catch (...) {
+            next->setError(boost::current_exception());
+        }
+    }
+
 public:
 
     /**
@@ -114,7 +301,7 @@ public:
      * thus suitable for representing an in-progress computation.
      */
     Future() :
-            taskFinished(false), taskError(false) {
+            state(boost::make_shared<State>()) {
     }
 
     /**
@@ -126,7 +313,9 @@ public:
      *
      * @return The result of the operation if it did complete successfully.
      * @throw FutureTaskExecutionException If the operation represented by the
-     *        Future object failed.
+     *        Future object failed with #setError(const std::string&).
+     *        Otherwise the exception passed to #setError is rethrown.
+     * @throw rsc::misc::IllegalStateException the result was taken with #take
      */
     R get() {
         return get(0);
@@ -145,39 +334,41 @@ public:
      * @return The result of the operation if it did complete
      *         successfully within the given amount of time.
      * @throw FutureTaskExecutionException If the operation represented by the
-     *                                     Future object failed.
+     *                                     Future object failed with
+     *                                     #setError(const std::string&).
+     *                                     Otherwise the exception passed to
+     *                                     #setError is rethrown.
      * @throw FutureTimeoutException If the result does not become available
      *                               within the amount of time specified via
      *                               @a timeout.
+     * @throw rsc::misc::IllegalStateException the result was taken with #take
      */
     R get(double timeout) {
-        MutexType::scoped_lock lock(mutex);
-        while (!taskFinished) {
-            if (timeout <= 0) {
-                condition.wait(lock);
-            } else {
-#if BOOST_VERSION >= 105000
-                if (!condition.timed_wait(lock, boost::posix_time::microseconds(long(timeout) * 1000000))) {
-#else
-                boost::xtime xt;
-                boost::xtime_get(&xt, boost::TIME_UTC);
-                xt.sec += timeout;
-                if (!condition.timed_wait(lock, xt)) {
-#endif
-                    throw FutureTimeoutException(
-                            boost::str(
-                                    boost::format(
-                                            "Timeout while waiting for result. Waited %1% seconds.")
-                                            % timeout));
-                }
-            }
-        }
+        const int status = waitCompleted(timeout);
+        checkResult(status);
+        return state->result;
+    }
 
-        if (taskError) {
-            throw FutureTaskExecutionException(errorMsg);
+    /**
+     * Waits for the result like #get and moves it out of the future. This is
+     * required for move-only result types. Afterwards, the result cannot be
+     * obtained again. Must not be called concurrently with #get.
+     *
+     * @param timeout The amount of time in seconds in which the operation has
+     *                to complete, <= 0 to wait forever
+     * @return the result of the operation
+     * @throw FutureTaskExecutionException see #get
+     * @throw FutureTimeoutException see #get
+     * @throw rsc::misc::IllegalStateException the result was already taken
+     */
+    R take(double timeout = 0) {
+        int status = waitCompleted(timeout);
+        checkResult(status);
+        if (!state->status.compare_exchange_strong(status, TAKEN,
+                boost::memory_order_acq_rel)) {
+            checkResult(status);
         }
-
-        return result;
+        return boost::move(state->result);
     }
 
     /**
@@ -188,47 +379,239 @@ public:
      * false
      */
     bool isDone() {
-        MutexType::scoped_lock lock(mutex);
-        return taskFinished;
+        return state->status.load(boost::memory_order_acquire) >= SUCCEEDED;
     }
 
     /**
      * Provide the result for this future.
      *
      * @param data result data
+     * @throw rsc::misc::IllegalStateException the future is already completed
      */
     void set(R data) {
-        result = data;
-        {
-            MutexType::scoped_lock lock(mutex);
-            taskFinished = true;
-            condition.notify_all();
-        }
+        claim();
+        state->result = boost::move(data);
+        complete(SUCCEEDED);
     }
 
     /**
-     * Indicate an error while processing.
+     * Indicate an error while processing. #get will throw a
+     * FutureTaskExecutionException with the given message.
      *
      * @param message error description
+     * @throw rsc::misc::IllegalStateException the future is already completed
      */
     void setError(const std::string& message) {
-        errorMsg = message;
+        setError(boost::copy_exception(FutureTaskExecutionException(message)));
+    }
+
+    /**
+     * Indicate an error while processing with the exception that caused it,
+     * e.g. obtained via boost::current_exception or boost::copy_exception.
+     * #get will rethrow this exception.
+     *
+     * @param error the exception that occurred
+     * @throw rsc::misc::IllegalStateException the future is already completed
+     */
+    void setError(const boost::exception_ptr& error) {
+        claim();
+        state->error = error;
+        complete(FAILED);
+    }
+
+    /**
+     * Registers a callback which is called once a result or error is
+     * available. This method never blocks. Without an executor, the callback
+     * is called by the thread completing the future or immediately if the
+     * future is already done. With an executor, the callback is scheduled as
+     * a task and receives a future sharing the state of this one, so that
+     * this future may be destroyed in between.
+     *
+     * Callbacks must not throw exceptions.
+     *
+     * @param callback function to call with the completed future
+     * @param executor executor to run the callback on or empty pointer to
+     *                 call it directly
+     */
+    void addCallback(const Callback& callback, TaskExecutorPtr executor =
+            TaskExecutorPtr()) {
+        PendingCallback pending;
+        pending.callback = callback;
+        pending.executor = executor;
         {
-            MutexType::scoped_lock lock(mutex);
-            taskFinished = true;
-            taskError = true;
+            MutexType::scoped_lock lock(state->mutex);
+            if (state->status.load(boost::memory_order_acquire) < SUCCEEDED) {
+                state->callbacks.push_back(pending);
+                return;
+            }
         }
-        condition.notify_all();
+        dispatch(pending);
     }
+
+    /**
+     * Chains a computation which receives this future once it is completed
+     * and whose return value becomes the result of the returned future.
+     * Exceptions thrown by the continuation, e.g. by calling #get on a failed
+     * future, become the error of the returned future.
+     *
+     * @param continuation function computing the next result
+     * @param executor executor to run the continuation on or empty pointer
+     *                 to call it in the thread completing this future
+     * @return future for the result of @a continuation
+     * @tparam T result type of the continuation
+     */
+    template<class T>
+    boost::shared_ptr<Future<T> > then(
+            const boost::function<T(Future<R>&)>& continuation,
+            TaskExecutorPtr executor = TaskExecutorPtr()) {
+        boost::shared_ptr<Future<T> > next(new Future<T>);
+        addCallback(
+                boost::bind(&Future<R>::template continueWith<T>,
+                        continuation, next, _1), executor);
+        return next;
+    }
+
 protected:
     MutexType& getMutex() {
-        return this->mutex;
+        return state->mutex;
     }
 
     ConditionType& getCondition() {
-        return this->condition;
+        return state->condition;
     }
 };
 
+/**
+ * Collects the results of several futures for ::whenAll.
+ *
+ * @author jwienke
+ */
+template<class R>
+class WhenAllCollector {
+public:
+
+    explicit WhenAllCollector(const std::size_t& count) :
+            results(count), remaining(count), failed(false), future(
+                    new Future<std::vector<R> >) {
+    }
+
+    void completed(const std::size_t& index, Future<R>& completed) {
+        bool complete = false;
+        boost::exception_ptr error;
+        try {
+            R value = completed.get();
+            boost::mutex::scoped_lock lock(mutex);
+            results[index] = value;
+            complete = --remaining == 0 && !failed;
+        } catch (...) {
+            boost::mutex::scoped_lock lock(mutex);
+            if (failed) {
+                return;
+            }
+            failed = true;
+            error = boost::current_exception();
+        }
+        if (error) {
+            future->setError(error);
+        } else if (complete) {
+            future->set(results);
+        }
+    }
+
+    boost::shared_ptr<Future<std::vector<R> > > getFuture() const {
+        return future;
+    }
+
+private:
+    boost::mutex mutex;
+    std::vector<R> results;
+    std::size_t remaining;
+    bool failed;
+    boost::shared_ptr<Future<std::vector<R> > > future;
+};
+
+/**
+ * Returns a future which completes once all given futures completed. Its
+ * result contains the results of @a futures in the same order. If any of them
+ * fails, the returned future fails with the first error instead. The result
+ * type must be copyable.
+ *
+ * @param futures futures to wait for
+ * @return future for all results
+ * @tparam R result type of the futures
+ */
+template<class R>
+boost::shared_ptr<Future<std::vector<R> > > whenAll(
+        const std::vector<boost::shared_ptr<Future<R> > >& futures) {
+    boost::shared_ptr<WhenAllCollector<R> > collector(
+            new WhenAllCollector<R>(futures.size()));
+    boost::shared_ptr<Future<std::vector<R> > > result =
+            collector->getFuture();
+    if (futures.empty()) {
+        result->set(std::vector<R>());
+    }
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i]->addCallback(
+                boost::bind(&WhenAllCollector<R>::completed, collector, i, _1));
+    }
+    return result;
+}
+
+/**
+ * Completes a future with the index of the first completed future for
+ * ::whenAny.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT WhenAnyCollector {
+public:
+
+    WhenAnyCollector();
+
+    template<class R>
+    void completed(const std::size_t& index, Future<R>& /*completed*/) {
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            if (done) {
+                return;
+            }
+            done = true;
+        }
+        future->set(index);
+    }
+
+    boost::shared_ptr<Future<std::size_t> > getFuture() const;
+
+private:
+    boost::mutex mutex;
+    bool done;
+    boost::shared_ptr<Future<std::size_t> > future;
+};
+
+/**
+ * Returns a future which completes once the first of the given futures
+ * completed, either with a result or an error. Its result is the index of
+ * that future in @a futures.
+ *
+ * @param futures futures to wait for, must not be empty
+ * @return future for the index of the first completed future
+ * @throw std::invalid_argument @a futures is empty
+ * @tparam R result type of the futures
+ */
+template<class R>
+boost::shared_ptr<Future<std::size_t> > whenAny(
+        const std::vector<boost::shared_ptr<Future<R> > >& futures) {
+    if (futures.empty()) {
+        throw std::invalid_argument("whenAny requires at least one future");
+    }
+    boost::shared_ptr<WhenAnyCollector> collector(new WhenAnyCollector);
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i]->addCallback(
+                boost::bind(&WhenAnyCollector::completed<R>,
+                        collector, i, _1));
+    }
+    return collector->getFuture();
+}
+
 }
 }
@@ -26,14 +26,31 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/atomic.hpp>
 #include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/function.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/optional.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 
+#include "../misc/Histogram.h"
 #include "../misc/IllegalStateException.h"
+#include "../misc/langutils.h"
+#include "../os/ThreadUtilities.h"
 #include "SynchronizedQueue.h"
 
 namespace rsc {
@@ -56,6 +73,29 @@ namespace threading {
  * Filtering and delivery of message to receivers are performed by handlers.
  * These handlers should be stateless.
  *
+ * Workers take receivers with pending messages from a FIFO queue of ready
+ * receivers. Hence, finding the next job does not depend on the number of
+ * registered receivers and workers are only woken up if there is work. With
+ * SCHEDULING_WORK_STEALING, each worker owns such a queue and idle workers
+ * steal from the others, see #setSchedulingMode. For large numbers of
+ * receivers, messages can be stored once for all receivers instead of being
+ * copied into per-receiver queues, see #setMessageStorage. Receivers which
+ * can process messages in bulk may use a BatchDeliveryHandler instead of a
+ * DeliveryHandler to get several messages per call.
+ *
+ * By default, the number of pending messages per receiver is unlimited. A
+ * capacity and an OverflowPolicy can be specified per receiver at
+ * registration time to bound the memory used by slow receivers.
+ *
+ * Statistics about receivers and workers can be enabled at runtime with
+ * #setStatisticsEnabled. Workers can be pinned to CPUs and receivers kept on
+ * the NUMA node of the workers processing them, see #setWorkerAffinity and
+ * #setNumaAware.
+ *
+ * The number of workers can be changed while the pool is running with
+ * #resize or adjusted automatically to the load, see #setAutoScaling. To
+ * shut down without losing pending messages, use #drain instead of #stop.
+ *
  * @author jwienke
  *
  * @tparam M type of the messages dispatched by the pool
@@ -105,6 +145,82 @@ public:
 
     typedef boost::shared_ptr<DeliveryHandler> DeliveryHandlerPtr;
 
+    /**
+     * Consecutive messages for one receiver passed to a
+     * BatchDeliveryHandler in the order they were pushed. The messages are
+     * not copied for the batch and are only valid during the call of the
+     * handler.
+     *
+     * @author jwienke
+     */
+    class Batch {
+    public:
+
+        typedef boost::indirect_iterator<
+                typename std::vector<const M*>::const_iterator> const_iterator;
+
+        std::size_t size() const {
+            return messages.size();
+        }
+
+        bool empty() const {
+            return messages.empty();
+        }
+
+        const M& operator[](const std::size_t& index) const {
+            return *messages[index];
+        }
+
+        const_iterator begin() const {
+            return const_iterator(messages.begin());
+        }
+
+        const_iterator end() const {
+            return const_iterator(messages.end());
+        }
+
+    private:
+
+        friend class OrderedQueueDispatcherPool;
+
+        std::vector<const M*> messages;
+
+    };
+
+    /**
+     * A handler that receives several consecutive messages for one receiver
+     * at once. Useful for receivers which can process messages in bulk to
+     * amortize the scheduling overhead per message.
+     *
+     * @author jwienke
+     * @note do not use state in this class and make it reentrant
+     */
+    class BatchDeliveryHandler {
+    public:
+
+        virtual ~BatchDeliveryHandler() {
+        }
+
+        /**
+         * Requests this handler to deliver the messages to the receiver.
+         *
+         * @param receiver receiver to pass messages to
+         * @param messages non-empty batch of messages in the order they
+         *                 were pushed
+         */
+        virtual void deliver(boost::shared_ptr<R>& receiver,
+                const Batch& messages) = 0;
+
+    };
+
+    typedef boost::shared_ptr<BatchDeliveryHandler> BatchDeliveryHandlerPtr;
+
+    /**
+     * Default maximum number of messages passed to a BatchDeliveryHandler at
+     * once.
+     */
+    static const std::size_t DEFAULT_MAX_BATCH_SIZE = 64;
+
     /**
      * A handler that is used to filter messages for a certain receiver.
      *
@@ -132,6 +248,224 @@ public:
 
     typedef boost::shared_ptr<FilterHandler> FilterHandlerPtr;
 
+    /**
+     * A function that is called with a message which did not fit into the
+     * queue of a receiver registered with OVERFLOW_CALLBACK. The message is
+     * not delivered to that receiver. Must be reentrant.
+     */
+    typedef boost::function<void(boost::shared_ptr<R>& receiver,
+            const M& message)> overflowFunction;
+
+    /**
+     * Behaviors of #push if the queue of a receiver with a limited capacity
+     * is full.
+     */
+    enum OverflowPolicy {
+        /**
+         * Block the pushing thread until the receiver has processed enough
+         * messages. This also happens if the pool is stopped.
+         */
+        OVERFLOW_BLOCK,
+        /**
+         * Discard the oldest pending message of the receiver.
+         */
+        OVERFLOW_DROP_OLDEST,
+        /**
+         * Discard the new message for this receiver.
+         */
+        OVERFLOW_DROP_NEWEST,
+        /**
+         * Discard the new message for this receiver and pass it to an
+         * overflowFunction.
+         */
+        OVERFLOW_CALLBACK
+    };
+
+    /**
+     * Counters describing the message flow of one registered receiver. Except
+     * for #dropped and #blocked, the values are only collected while
+     * statistics are enabled, see #setStatisticsEnabled.
+     *
+     * @author jwienke
+     */
+    struct ReceiverStatistics {
+
+        ReceiverStatistics() :
+            dropped(0), blocked(0), highWaterMark(0), delivered(0), rejected(
+                    0) {
+        }
+
+        /**
+         * Adds the values of @a other to this instance.
+         *
+         * @param other statistics to merge
+         */
+        void merge(const ReceiverStatistics& other) {
+            dropped += other.dropped;
+            blocked += other.blocked;
+            highWaterMark = std::max(highWaterMark, other.highWaterMark);
+            delivered += other.delivered;
+            rejected += other.rejected;
+            latency.merge(other.latency);
+            deliveryDuration.merge(other.deliveryDuration);
+        }
+
+        /**
+         * Number of messages discarded because of an overflow.
+         */
+        boost::uint64_t dropped;
+
+        /**
+         * Number of #push calls that had to wait for space in the queue.
+         */
+        boost::uint64_t blocked;
+
+        /**
+         * Maximum number of pending messages observed. For receivers using
+         * the shared log, this is sampled when messages are taken.
+         */
+        std::size_t highWaterMark;
+
+        /**
+         * Number of messages passed to the delivery handler.
+         */
+        boost::uint64_t delivered;
+
+        /**
+         * Number of messages rejected by the filter.
+         */
+        boost::uint64_t rejected;
+
+        /**
+         * Microseconds from pushing a message until the delivery handler is
+         * called with it.
+         */
+        rsc::misc::Histogram latency;
+
+        /**
+         * Microseconds spent in the filter and delivery handler per job,
+         * i.e. per message or per batch.
+         */
+        rsc::misc::Histogram deliveryDuration;
+
+    };
+
+    /**
+     * Utilization of one worker thread while statistics are enabled.
+     *
+     * @author jwienke
+     */
+    struct WorkerStatistics {
+
+        WorkerStatistics() :
+            jobs(0), busyMicros(0), idleMicros(0) {
+        }
+
+        /**
+         * Number of processed jobs, i.e. messages or batches.
+         */
+        boost::uint64_t jobs;
+
+        /**
+         * Microseconds spent in filters and delivery handlers.
+         */
+        boost::uint64_t busyMicros;
+
+        /**
+         * Microseconds spent waiting for and taking jobs.
+         */
+        boost::uint64_t idleMicros;
+
+    };
+
+    /**
+     * Parameters for adjusting the number of workers to the load, see
+     * #setAutoScaling. At most one worker is added or removed per check.
+     *
+     * @author jwienke
+     */
+    struct AutoScalingPolicy {
+
+        AutoScalingPolicy() :
+            minWorkers(1), maxWorkers(
+                    std::max(boost::thread::hardware_concurrency(), 1u)),
+                    backlogThreshold(4), latencyThreshold(10000), idleTimeout(
+                            1000), checkInterval(100) {
+        }
+
+        /**
+         * Minimum number of workers.
+         */
+        unsigned int minWorkers;
+
+        /**
+         * Maximum number of workers.
+         */
+        unsigned int maxWorkers;
+
+        /**
+         * A worker is added if more receivers than this are waiting for a
+         * worker while no worker is idle.
+         */
+        std::size_t backlogThreshold;
+
+        /**
+         * A worker is added if a message waited longer than this many
+         * microseconds for a worker since the last check while no worker is
+         * idle. 0 disables this criterion.
+         */
+        boost::uint64_t latencyThreshold;
+
+        /**
+         * A worker is removed if there were idle workers and no waiting
+         * receivers at every check during this many milliseconds.
+         */
+        unsigned int idleTimeout;
+
+        /**
+         * Milliseconds between two checks of the load.
+         */
+        unsigned int checkInterval;
+
+    };
+
+    /**
+     * Strategies used by the workers to find the next receiver to process.
+     */
+    enum SchedulingMode {
+        /**
+         * All workers share a single queue of ready receivers.
+         */
+        SCHEDULING_SHARED,
+        /**
+         * Each worker owns a queue of ready receivers. Receivers are
+         * initially distributed over these queues and stay with the worker
+         * that processed them last. Idle workers steal receivers from the
+         * queues of other workers. Avoids contention on a single queue with
+         * many workers.
+         */
+        SCHEDULING_WORK_STEALING
+    };
+
+    /**
+     * Ways of storing pushed messages until they are delivered.
+     */
+    enum MessageStorage {
+        /**
+         * Each receiver has its own queue and #push copies the message into
+         * every queue.
+         */
+        STORAGE_PER_RECEIVER,
+        /**
+         * Messages are appended once to a log shared by all receivers and
+         * each receiver only keeps a cursor into this log. Messages are
+         * delivered from the log without copying them and released once all
+         * receivers have processed them. #push does not depend on the number
+         * of receivers which still have pending messages.
+         */
+        STORAGE_SHARED_LOG
+    };
+
 private:
 
     /**
@@ -188,160 +522,1302 @@ private:
     };
 
     /**
-     * Represents on registered receiver of the pool.
+     * Number of messages in one segment of the shared message log.
+     */
+    static const std::size_t LOG_SEGMENT_SIZE = 256;
+
+    /**
+     * A fixed-size part of the shared message log. Only the pool appends
+     * messages and publishes them by incrementing #size. Segments are
+     * chained and kept alive by the cursors of the receivers, hence a
+     * segment is released as soon as the last receiver has moved past it.
      *
      * @author jwienke
      */
-    class Receiver {
+    class LogSegment {
     public:
 
-        Receiver(boost::shared_ptr<R> receiver) :
-            receiver(receiver), processing(false) {
+        explicit LogSegment(const boost::uint64_t& base) :
+            base(base), messages(LOG_SEGMENT_SIZE), enqueued(LOG_SEGMENT_SIZE,
+                    0), size(0) {
         }
 
-        boost::shared_ptr<R> receiver;
-        // TODO think about if this really requires a synchronized queue if
-        // all message dispatching to worker threads is synchronized
-        SynchronizedQueue<M> queue;
+        /**
+         * Position of the first message of this segment in the log.
+         */
+        const boost::uint64_t base;
 
-        boost::condition processingCondition;
+        /**
+         * Slots for the messages, which are only constructed once appended
+         * so that @a M does not need a default constructor.
+         */
+        std::vector<boost::optional<M> > messages;
 
         /**
-         * Indicates whether a job for this worker is currently being processed
-         * and this receiver hence cannot be addressed by another thread even
-         * though there may be more messages to process.
-         *
-         * All changes to this flag are already locked by the global
-         * recieversMutex.
+         * Push times of the messages if statistics were enabled, else 0.
+         */
+        std::vector<boost::uint64_t> enqueued;
+
+        /**
+         * Number of published messages in this segment.
+         */
+        boost::atomic<std::size_t> size;
+
+        /**
+         * The following segment. Set before the last message of this
+         * segment is published.
          */
-        volatile bool processing;
+        boost::shared_ptr<LogSegment> next;
 
     };
 
-    // TODO make this a set to only allow unique subscriptions?
-    boost::mutex receiversMutex;
-    std::vector<boost::shared_ptr<Receiver> > receivers;
-    size_t currentPosition;
+    /**
+     * A message in the queue of a receiver.
+     *
+     * @author jwienke
+     */
+    class Pending {
+    public:
 
-    volatile bool jobsAvailable;
-    boost::condition jobsAvailableCondition;
-    volatile bool interrupted;
+        Pending(const M& message, const boost::uint64_t& enqueued) :
+            message(message), enqueued(enqueued) {
+        }
 
-    volatile bool parallelCalls;
+        M message;
 
-    volatile bool started;
+        /**
+         * Push time if statistics were enabled, else 0.
+         */
+        boost::uint64_t enqueued;
+
+    };
 
     /**
-     * Returns the next job to process for worker threads and blocks if there
-     * is no job.
+     * Represents on registered receiver of the pool.
      *
-     * @param workerNum number of the worker requesting a new job
-     * @param receiver out param with the receiver to work on
+     * @author jwienke
      */
-    void nextJob(const unsigned int& /*workerNum*/,
-            boost::shared_ptr<Receiver>& receiver) {
+    class Receiver {
+    public:
 
-        boost::mutex::scoped_lock lock(receiversMutex);
+        Receiver(boost::shared_ptr<R> receiver, const std::size_t& id,
+                const std::size_t& capacity, const OverflowPolicy& policy,
+                overflowFunction overflowCallback) :
+            receiver(receiver), id(id), capacity(capacity), policy(policy),
+                    overflowCallback(overflowCallback), index(0), batching(
+                            false), processing(0), ready(false), waiting(
+                            false), registered(true), blockedPushers(0),
+                    nextTurn(0), servingTurn(0) {
+        }
+
+        /**
+         * Appends @a message to the queue of this receiver if it is not full.
+         * Overflows are handled as specified by #policy except for blocking.
+         * With OVERFLOW_BLOCK, the receiver counts as full as long as other
+         * pushers are blocked so that messages cannot overtake them. In that
+         * case the caller is registered as a blocked pusher and must wait
+         * until #servingTurn reaches @a turn. Acquire #mutex before calling
+         * this method.
+         *
+         * @param turn set to the position of the caller among the blocked
+         *             pushers if the message was not added due to
+         *             OVERFLOW_BLOCK
+         * @return @c false if the message was not added to the queue
+         */
+        bool enqueueLocked(const M& message, const boost::uint64_t& enqueued,
+                boost::uint64_t& turn) {
+            if (capacity != 0 && (queue.size() >= capacity
+                    || blockedPushers > 0)) {
+                if (policy == OVERFLOW_BLOCK) {
+                    ++statistics.blocked;
+                    ++blockedPushers;
+                    turn = nextTurn++;
+                    return false;
+                }
+                if (policy != OVERFLOW_DROP_OLDEST) {
+                    ++statistics.dropped;
+                    return false;
+                }
+                queue.tryPop();
+                ++statistics.dropped;
+            }
+            pushLocked(message, enqueued);
+            return true;
+        }
+
+        /**
+         * Appends @a message to the queue of this receiver regardless of its
+         * capacity. Acquire #mutex before calling this method.
+         */
+        void pushLocked(const M& message, const boost::uint64_t& enqueued) {
+            queue.push(Pending(message, enqueued));
+            if (enqueued != 0 && queue.size() > statistics.highWaterMark) {
+                statistics.highWaterMark = queue.size();
+            }
+            if (batching) {
+                messageCondition.notify_all();
+            }
+        }
 
-        //        std::cout << "Worker " << workerNum << " requests a new job"
-        //                << std::endl;
+        /**
+         * Takes the oldest message from the queue of this receiver and wakes
+         * up blocked pushers. Acquire #mutex before calling this method.
+         */
+        Pending popLocked() {
+            Pending pending = queue.tryPop();
+            if (blockedPushers > 0) {
+                spaceCondition.notify_all();
+            }
+            return pending;
+        }
 
-        // wait until a job is available
-        bool gotJob = false;
-        while (!gotJob) {
+        /**
+         * Tells whether there are messages left to process for this
+         * receiver. Acquire #mutex before calling this method.
+         */
+        bool hasPendingLocked() const {
+            return !queue.empty()
+                    || (segment && index < segment->size.load(
+                            boost::memory_order_acquire));
+        }
 
-            while (!jobsAvailable && !interrupted) {
-                //                std::cout << "Worker " << workerNum
-                //                        << ": no jobs available, waiting" << std::endl;
-                jobsAvailableCondition.wait(lock);
+        /**
+         * Moves the cursor into the shared log to the next message.
+         */
+        void advanceLocked() {
+            if (++index == LOG_SEGMENT_SIZE) {
+                segment = segment->next;
+                index = 0;
             }
+        }
+
+        boost::shared_ptr<R> receiver;
+
+        /**
+         * Registration number used to select the ready queue this receiver
+         * is scheduled on by #push, see #homeQueue.
+         */
+        const std::size_t id;
+
+        /**
+         * Maximum number of messages in #queue or 0 for no limit. Receivers
+         * with a limit always use #queue, regardless of the message storage.
+         */
+        const std::size_t capacity;
+        const OverflowPolicy policy;
+        overflowFunction overflowCallback;
+
+        // TODO think about if this really requires a synchronized queue if
+        // all message dispatching to worker threads is synchronized
+        SynchronizedQueue<Pending> queue;
+
+        /**
+         * Cursor into the shared message log pointing to the next message
+         * to process. Messages in #queue are older than the ones in the log.
+         */
+        boost::shared_ptr<LogSegment> segment;
+        std::size_t index;
+
+        /**
+         * Guards the scheduling state of this receiver, i.e. the following
+         * members and the transitions of #queue between empty and non-empty.
+         */
+        boost::mutex mutex;
+
+        boost::condition processingCondition;
+
+        /**
+         * Notified when new messages are available while a worker is
+         * collecting a batch for this receiver.
+         */
+        boost::condition messageCondition;
+
+        /**
+         * Indicates whether a worker waits on #messageCondition.
+         */
+        bool batching;
+
+        /**
+         * Number of jobs for this receiver which are currently being
+         * processed. Unless parallel calls are allowed, a receiver with
+         * running jobs cannot be addressed by another thread even though
+         * there may be more messages to process.
+         */
+        unsigned int processing;
+
+        /**
+         * Indicates whether this receiver is contained in one of the ready
+         * queues.
+         */
+        bool ready;
+
+        /**
+         * Indicates whether this receiver is contained in the list of
+         * receivers waiting for the next message in the shared log.
+         */
+        bool waiting;
+
+        /**
+         * @c false once the receiver was unregistered. Such receivers are
+         * lazily discarded when taken from a ready queue.
+         */
+        bool registered;
+
+        /**
+         * Number of pushing threads waiting on #spaceCondition.
+         */
+        unsigned int blockedPushers;
+        boost::condition spaceCondition;
+
+        /**
+         * Blocked pushers are served in the order they were blocked. Each
+         * one draws a turn from #nextTurn and may only add its message once
+         * #servingTurn has reached it.
+         */
+        boost::uint64_t nextTurn;
+        boost::uint64_t servingTurn;
+
+        ReceiverStatistics statistics;
+
+    };
+
+    /**
+     * A queue of receivers which have pending messages and may be processed
+     * by a worker right now, in the order they became ready. Each receiver in
+     * such a queue has a non-empty message queue unless it was unregistered.
+     *
+     * @author jwienke
+     */
+    class ReadyQueue {
+    public:
+        boost::mutex mutex;
+        std::deque<boost::shared_ptr<Receiver> > receivers;
+    };
+
+    /**
+     * A message taken from a receiver for processing.
+     *
+     * @author jwienke
+     */
+    class Job {
+    public:
+
+        Job() :
+            index(0), enqueued(0), measured(false), started(0), finished(0), delivered(
+                    0), rejected(0) {
+        }
+
+        const M& getMessage() const {
+            return segment ? *segment->messages[index] : *message;
+        }
+
+        boost::shared_ptr<Receiver> receiver;
+
+        /**
+         * The message if it was taken from the receiver's queue.
+         */
+        boost::optional<M> message;
+
+        /**
+         * Location of the message if it was taken from the shared log.
+         */
+        boost::shared_ptr<LogSegment> segment;
+        std::size_t index;
+
+        /**
+         * Push time of the message or 0 if unknown.
+         */
+        boost::uint64_t enqueued;
+
+        /**
+         * Whether the following values were measured for this job.
+         */
+        bool measured;
+        boost::uint64_t started;
+        boost::uint64_t finished;
+        std::size_t delivered;
+        std::size_t rejected;
+
+    };
+
+    /**
+     * Storage of a worker for collecting batches, reused for all batches of
+     * the worker to avoid allocations.
+     *
+     * @author jwienke
+     */
+    class BatchBuffer {
+    public:
+
+        /**
+         * Releases the messages of the previous batch.
+         */
+        void clear() {
+            batch.messages.clear();
+            taken.clear();
+            segments.clear();
+            enqueued.clear();
+        }
+
+        Batch batch;
+
+        /**
+         * Messages taken from the receiver's queue. Capacity is reserved for
+         * the whole batch up front so that #batch can point into it.
+         */
+        std::vector<M> taken;
+
+        /**
+         * Keeps the segments of the shared log alive which #batch points
+         * into.
+         */
+        std::vector<boost::shared_ptr<LogSegment> > segments;
+
+        /**
+         * Push times of the messages in #batch if measured.
+         */
+        std::vector<boost::uint64_t> enqueued;
+
+    };
+
+    // TODO make this a set to only allow unique subscriptions?
+    boost::mutex receiversMutex;
+    std::vector<boost::shared_ptr<Receiver> > receivers;
+    std::size_t nextReceiverId;
+
+    /**
+     * Receivers with a limited capacity. Subset of #receivers.
+     */
+    std::vector<boost::shared_ptr<Receiver> > boundedReceivers;
+
+    /**
+     * One shared ready queue or one queue per worker, depending on the
+     * scheduling mode. Only changed while the pool is not running.
+     */
+    std::vector<boost::shared_ptr<ReadyQueue> > readyQueues;
+
+    /**
+     * Number of entries in all ready queues.
+     */
+    boost::atomic<std::size_t> readyCount;
+
+    boost::mutex idleMutex;
+    boost::condition jobsAvailableCondition;
+    boost::atomic<unsigned int> idleWorkers;
+
+    boost::atomic<bool> interrupted;
+
+    volatile bool parallelCalls;
+
+    volatile bool started;
+
+    SchedulingMode schedulingMode;
+
+    MessageStorage messageStorage;
+
+    /**
+     * Guards appending to the shared message log and #waitingReceivers.
+     */
+    boost::mutex logMutex;
+
+    /**
+     * The segment of the shared log new messages are appended to.
+     */
+    boost::shared_ptr<LogSegment> logTail;
+
+    /**
+     * Receivers without pending messages in the shared log which need to
+     * be scheduled by the next #push.
+     */
+    std::vector<boost::shared_ptr<Receiver> > waitingReceivers;
+
+    /**
+     * Number of messages ever appended to the shared log.
+     */
+    boost::atomic<boost::uint64_t> logLength;
+
+    volatile bool statisticsEnabled;
+
+    /**
+     * CPUs the workers are pinned to, worker i uses entry i modulo the size.
+     * Empty if workers are not pinned.
+     */
+    std::vector<unsigned int> workerCpus;
+
+    /**
+     * Prefix of the worker thread names. Empty if threads are not named.
+     */
+    std::string workerNamePrefix;
+
+    bool numaAware;
+
+    /**
+     * Ready queue indices in the order a worker takes receivers from them.
+     * The first one is the worker's own queue.
+     */
+    std::vector<std::vector<std::size_t> > workerQueues;
+
+    /**
+     * Workers grouped by NUMA node. A single group if the pool is not NUMA
+     * aware.
+     */
+    std::vector<std::vector<unsigned int> > nodeWorkers;
+
+    /**
+     * Counters of one worker. Only written by the worker itself.
+     *
+     * @author jwienke
+     */
+    class WorkerCounters {
+    public:
+
+        WorkerCounters() :
+            jobs(0), busyMicros(0), idleMicros(0) {
+        }
+
+        void add(boost::atomic<boost::uint64_t>& counter,
+                const boost::uint64_t& value) {
+            // single writer, hence no atomic read-modify-write required
+            counter.store(counter.load(boost::memory_order_relaxed) + value,
+                    boost::memory_order_relaxed);
+        }
+
+        boost::atomic<boost::uint64_t> jobs;
+        boost::atomic<boost::uint64_t> busyMicros;
+        boost::atomic<boost::uint64_t> idleMicros;
+
+    };
+
+    /**
+     * Counters indexed by worker number. Grows with the number of workers
+     * and is guarded by #countersMutex.
+     */
+    std::vector<boost::shared_ptr<WorkerCounters> > workerCounters;
+
+    mutable boost::mutex countersMutex;
+
+    /**
+     * Guards #threadPool, #scaler and changes of the number of workers.
+     * Acquire it before #receiversMutex.
+     */
+    boost::mutex workersMutex;
+
+    /**
+     * Number of workers which should be running. Workers with a higher
+     * number exit after their current job.
+     */
+    boost::atomic<unsigned int> targetWorkers;
+
+    bool autoScaling;
+
+    AutoScalingPolicy autoScalingPolicy;
+
+    /**
+     * Thread adjusting the number of workers while auto scaling.
+     */
+    boost::shared_ptr<boost::thread> scaler;
+    boost::mutex scalerMutex;
+    boost::condition scalerCondition;
+    bool scalerStopped;
+
+    /**
+     * Maximum microseconds a message waited for a worker since the last
+     * check of the auto scaler. Only measured while auto scaling.
+     */
+    boost::atomic<boost::uint64_t> maxQueueLatency;
+
+    /**
+     * Set by #drain. New messages are rejected until the next #start.
+     */
+    volatile bool draining;
+
+    /**
+     * Notified while draining whenever a job finished.
+     */
+    boost::mutex drainMutex;
+    boost::condition drainCondition;
+
+    /**
+     * Appends @a message to the shared log. Acquire #logMutex before calling
+     * this method.
+     */
+    void appendLocked(const M& message, const boost::uint64_t& enqueued) {
+        boost::shared_ptr<LogSegment> tail = logTail;
+        const std::size_t position = tail->size.load(
+                boost::memory_order_relaxed);
+        tail->messages[position] = message;
+        tail->enqueued[position] = enqueued;
+        if (position + 1 == LOG_SEGMENT_SIZE) {
+            tail->next.reset(new LogSegment(tail->base + LOG_SEGMENT_SIZE));
+            logTail = tail->next;
+        }
+        tail->size.store(position + 1, boost::memory_order_release);
+        logLength.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+    /**
+     * Recreates the ready queues for the current scheduling mode and worker
+     * placement and redistributes already scheduled receivers. Must not be
+     * called while workers are running.
+     */
+    void createReadyQueues() {
+
+        boost::mutex::scoped_lock lock(receiversMutex);
+
+        std::deque<boost::shared_ptr<Receiver> > scheduled;
+        for (std::size_t i = 0; i < readyQueues.size(); ++i) {
+            scheduled.insert(scheduled.end(),
+                    readyQueues[i]->receivers.begin(),
+                    readyQueues[i]->receivers.end());
+        }
+
+        // sized for the largest number of workers the auto scaler may start
+        unsigned int numWorkers = std::max(threadPoolSize, 1u);
+        if (autoScaling) {
+            numWorkers = std::max(numWorkers, autoScalingPolicy.maxWorkers);
+        }
+
+        // group workers by the NUMA node of their CPU
+        std::vector<std::size_t> workerNodes(numWorkers, 0);
+        std::map<unsigned int, std::size_t> nodeIndices;
+        if (numaAware && !workerCpus.empty()) {
+            for (unsigned int i = 0; i < numWorkers; ++i) {
+                const unsigned int node = rsc::os::numaNodeOfCpu(
+                        workerCpus[i % workerCpus.size()]);
+                workerNodes[i] = nodeIndices.insert(
+                        std::make_pair(node, nodeIndices.size())).first->second;
+            }
+        }
+        nodeWorkers.assign(std::max(nodeIndices.size(), std::size_t(1)),
+                std::vector<unsigned int>());
+        for (unsigned int i = 0; i < numWorkers; ++i) {
+            nodeWorkers[workerNodes[i]].push_back(i);
+        }
+
+        // one queue per worker or one shared queue per node
+        const bool perWorker = schedulingMode == SCHEDULING_WORK_STEALING;
+        const std::size_t numQueues =
+                perWorker ? numWorkers : nodeWorkers.size();
+        readyQueues.clear();
+        for (std::size_t i = 0; i < numQueues; ++i) {
+            readyQueues.push_back(
+                    boost::shared_ptr<ReadyQueue>(new ReadyQueue));
+        }
+
+        // own queue first, then queues of the same node, then the rest
+        workerQueues.assign(numWorkers, std::vector<std::size_t>());
+        for (unsigned int i = 0; i < numWorkers; ++i) {
+            const std::size_t home = perWorker ? i : workerNodes[i];
+            std::vector<std::size_t>& order = workerQueues[i];
+            order.push_back(home);
+            for (std::size_t j = 1; j < numQueues; ++j) {
+                const std::size_t queue = (home + j) % numQueues;
+                const std::size_t node = perWorker ? workerNodes[queue] : queue;
+                if (node == workerNodes[i]) {
+                    order.push_back(queue);
+                }
+            }
+            for (std::size_t j = 1; j < numQueues; ++j) {
+                const std::size_t queue = (home + j) % numQueues;
+                const std::size_t node = perWorker ? workerNodes[queue] : queue;
+                if (node != workerNodes[i]) {
+                    order.push_back(queue);
+                }
+            }
+        }
+
+        for (typename std::deque<boost::shared_ptr<Receiver> >::iterator it =
+                scheduled.begin(); it != scheduled.end(); ++it) {
+            readyQueues[homeQueue((*it)->id)]->receivers.push_back(*it);
+        }
+
+    }
+
+    /**
+     * Returns the ready queue a receiver is scheduled on by #push. Receivers
+     * are distributed round-robin over the NUMA nodes and the workers of a
+     * node. Queues of workers which are not running are avoided.
+     *
+     * @param receiverId registration number of the receiver
+     * @return ready queue index
+     */
+    std::size_t homeQueue(const std::size_t& receiverId) const {
+        const std::size_t node = receiverId % nodeWorkers.size();
+        if (schedulingMode != SCHEDULING_WORK_STEALING) {
+            return node;
+        }
+        const std::vector<unsigned int>& workers = nodeWorkers[node];
+        const std::size_t worker = workers[(receiverId / nodeWorkers.size())
+                % workers.size()];
+        const unsigned int running = targetWorkers.load(
+                boost::memory_order_relaxed);
+        if (worker >= running && running > 0) {
+            return worker % running;
+        }
+        return worker;
+    }
+
+    /**
+     * Returns the own ready queue of a worker.
+     *
+     * @param workerNum number of the worker
+     * @return ready queue index
+     */
+    std::size_t workerQueue(const unsigned int& workerNum) const {
+        return workerQueues[workerNum % workerQueues.size()].front();
+    }
+
+    void createWorkerCounters() {
+        for (unsigned int i = 0; i < threadPoolSize; ++i) {
+            workerCounters.push_back(
+                    boost::shared_ptr<WorkerCounters>(new WorkerCounters));
+        }
+    }
+
+    /**
+     * Schedules @a receiver on the ready queue with index @a queueIndex
+     * unless it is already scheduled. Acquire the receiver's mutex before
+     * calling this method.
+     *
+     * @return @c true if the receiver was scheduled
+     */
+    bool markReadyLocked(const boost::shared_ptr<Receiver>& receiver,
+            const std::size_t& queueIndex) {
+        if (receiver->ready) {
+            return false;
+        }
+        receiver->ready = true;
+        ReadyQueue& queue = *readyQueues[queueIndex];
+        {
+            // counted before a worker can take the receiver so that
+            // #readyCount cannot wrap around
+            boost::mutex::scoped_lock lock(queue.mutex);
+            readyCount.fetch_add(1);
+            queue.receivers.push_back(receiver);
+        }
+        return true;
+    }
+
+    /**
+     * Schedules @a receiver on a ready queue if it has pending messages and
+     * may be processed right now. In the shared log mode, receivers without
+     * pending messages are added to the waiting list instead. Acquire the
+     * receiver's mutex before calling this method.
+     *
+     * @return @c true if the receiver was added to a ready queue
+     */
+    bool scheduleLocked(const boost::shared_ptr<Receiver>& receiver,
+            const std::size_t& queueIndex) {
+
+        if (!receiver->registered || receiver->ready) {
+            return false;
+        }
+        if (!parallelCalls && receiver->processing > 0) {
+            return false;
+        }
+        if (receiver->hasPendingLocked()) {
+            return markReadyLocked(receiver, queueIndex);
+        }
+        if (messageStorage == STORAGE_SHARED_LOG && receiver->segment
+                && !receiver->waiting) {
+            // recheck under the log mutex as a push may have happened in
+            // the meantime without seeing this receiver in the waiting list
+            boost::mutex::scoped_lock lock(logMutex);
+            if (receiver->hasPendingLocked()) {
+                lock.unlock();
+                return markReadyLocked(receiver, queueIndex);
+            }
+            receiver->waiting = true;
+            waitingReceivers.push_back(receiver);
+        }
+        return false;
+
+    }
+
+    /**
+     * Wakes up idle workers after @a count receivers became ready.
+     */
+    void wakeWorkers(const std::size_t& count) {
+        if (count == 0) {
+            return;
+        }
+        // pairs with the fence in nextJob so that either the worker sees the
+        // new ready count or we see the worker being idle
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (idleWorkers.load() == 0) {
+            return;
+        }
+        {
+            boost::mutex::scoped_lock lock(idleMutex);
+        }
+        if (count == 1) {
+            jobsAvailableCondition.notify_one();
+        } else {
+            jobsAvailableCondition.notify_all();
+        }
+    }
+
+    /**
+     * Takes a ready receiver, preferring the worker's own ready queue and
+     * then the queues of its NUMA node. Other queues are stolen from at
+     * their back.
+     *
+     * @return the receiver or an empty pointer if all queues were empty
+     */
+    boost::shared_ptr<Receiver> takeReady(const unsigned int& workerNum) {
+        const std::vector<std::size_t>& order = workerQueues[workerNum
+                % workerQueues.size()];
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            ReadyQueue& queue = *readyQueues[order[i]];
+            boost::mutex::scoped_lock lock(queue.mutex);
+            if (queue.receivers.empty()) {
+                continue;
+            }
+            boost::shared_ptr<Receiver> receiver;
+            if (i == 0) {
+                receiver = queue.receivers.front();
+                queue.receivers.pop_front();
+            } else {
+                receiver = queue.receivers.back();
+                queue.receivers.pop_back();
+            }
+            readyCount.fetch_sub(1);
+            return receiver;
+        }
+        return boost::shared_ptr<Receiver>();
+    }
+
+    /**
+     * Returns the next job to process for worker threads and blocks if there
+     * is no job.
+     *
+     * @param workerNum number of the worker requesting a new job
+     * @param job out param with the receiver and the message to process
+     * @return @c false if the worker has to exit because the pool shrank
+     */
+    bool nextJob(const unsigned int& workerNum, Job& job) {
+
+        while (true) {
+
+            if (interrupted) {
+                throw InterruptedException("Processing was interrupted");
+            }
+            if (workerNum >= targetWorkers.load()) {
+                return false;
+            }
+
+            boost::shared_ptr<Receiver> candidate;
+            if (readyCount.load() > 0) {
+                candidate = takeReady(workerNum);
+            }
+
+            // wait until a job is available
+            if (!candidate) {
+                boost::mutex::scoped_lock lock(idleMutex);
+                idleWorkers.fetch_add(1);
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                while (readyCount.load() == 0 && !interrupted
+                        && workerNum < targetWorkers.load()) {
+                    jobsAvailableCondition.wait(lock);
+                }
+                idleWorkers.fetch_sub(1);
+                continue;
+            }
+
+            boost::mutex::scoped_lock lock(candidate->mutex);
+            candidate->ready = false;
+            if (!candidate->registered || !candidate->hasPendingLocked()) {
+                scheduleLocked(candidate, workerQueue(workerNum));
+                continue;
+            }
+            ++candidate->processing;
+
+            // older messages from the receiver's queue go first
+            if (!candidate->queue.empty()) {
+                Pending pending = candidate->popLocked();
+                job.message = boost::move(pending.message);
+                job.enqueued = pending.enqueued;
+            } else {
+                job.segment = candidate->segment;
+                job.index = candidate->index;
+                job.enqueued = job.segment->enqueued[job.index];
+                if (job.enqueued != 0) {
+                    sampleLogHighWaterMarkLocked(*candidate);
+                }
+                candidate->advanceLocked();
+            }
+
+            // with parallel calls other workers may process further messages
+            // of this receiver right away
+            const bool scheduled = scheduleLocked(candidate,
+                    workerQueue(workerNum));
+            lock.unlock();
+            if (scheduled) {
+                wakeWorkers(1);
+            }
+
+            job.receiver = candidate;
+            return true;
+
+        }
+
+    }
+
+    unsigned int threadPoolSize;
+
+    /**
+     * Updates the high-water mark of a receiver with the number of messages
+     * it has pending in the shared log. Acquire the receiver's mutex before
+     * calling this method.
+     */
+    void sampleLogHighWaterMarkLocked(Receiver& receiver) {
+        const std::size_t pending = pendingCountLocked(receiver);
+        if (pending > receiver.statistics.highWaterMark) {
+            receiver.statistics.highWaterMark = pending;
+        }
+    }
+
+    /**
+     * Returns the number of messages pending for a receiver in its queue and
+     * in the shared log. Acquire the receiver's mutex before calling this
+     * method.
+     */
+    std::size_t pendingCountLocked(const Receiver& receiver) const {
+        std::size_t pending = receiver.queue.size();
+        if (receiver.segment) {
+            pending += std::size_t(
+                    logLength.load(boost::memory_order_relaxed)
+                            - (receiver.segment->base + receiver.index));
+        }
+        return pending;
+    }
+
+    /**
+     * Wakes up #drain to check whether all messages are delivered.
+     */
+    void notifyDrain() {
+        if (draining) {
+            boost::mutex::scoped_lock lock(drainMutex);
+            drainCondition.notify_all();
+        }
+    }
+
+    /**
+     * Counts the messages of registered receivers which are not delivered
+     * yet, including the ones of blocked #push calls.
+     *
+     * @param busy out param, set to @c true if a worker is processing a
+     *             message
+     * @return number of pending messages
+     */
+    std::size_t countPending(bool& busy) {
+        busy = false;
+        std::size_t pending = 0;
+        boost::mutex::scoped_lock lock(receiversMutex);
+        for (typename std::vector<boost::shared_ptr<Receiver> >::iterator it =
+                receivers.begin(); it != receivers.end(); ++it) {
+            boost::mutex::scoped_lock receiverLock((*it)->mutex);
+            pending += pendingCountLocked(**it) + (*it)->blockedPushers;
+            busy = busy || (*it)->processing > 0;
+        }
+        return pending;
+    }
+
+    /**
+     * Wakes up workers which wait for further messages of a batch.
+     */
+    void wakeBatchingWorkers() {
+        boost::mutex::scoped_lock lock(receiversMutex);
+        for (typename std::vector<boost::shared_ptr<Receiver> >::iterator it =
+                receivers.begin(); it != receivers.end(); ++it) {
+            boost::mutex::scoped_lock receiverLock((*it)->mutex);
+            (*it)->messageCondition.notify_all();
+        }
+    }
+
+    void finishedWork(const Job& job, const unsigned int& workerNum) {
+
+        const boost::shared_ptr<Receiver>& receiver = job.receiver;
+        bool scheduled = false;
+        {
+            boost::mutex::scoped_lock lock(receiver->mutex);
+            if (job.measured) {
+                ReceiverStatistics& statistics = receiver->statistics;
+                // batches record the latency when collecting messages
+                if (job.enqueued != 0 && !batchDeliveryHandler
+                        && job.started >= job.enqueued) {
+                    statistics.latency.record(job.started - job.enqueued);
+                }
+                statistics.deliveryDuration.record(job.finished - job.started);
+                statistics.delivered += job.delivered;
+                statistics.rejected += job.rejected;
+            }
+            --receiver->processing;
+            receiver->processingCondition.notify_all();
+            // continue on the same worker if possible as its caches are
+            // still warm
+            scheduled = scheduleLocked(receiver,
+                    workerNum < targetWorkers.load() ? workerQueue(workerNum)
+                            : homeQueue(receiver->id));
+        }
+        if (scheduled) {
+            wakeWorkers(1);
+        }
+        notifyDrain();
+
+    }
+
+    /**
+     * Takes the next pending message of @a receiver for a batch. Messages
+     * from the receiver's queue are moved to @a buffer, messages from the
+     * shared log stay where they are. Acquire the receiver's mutex before
+     * calling this method.
+     *
+     * @return the message, valid until @a buffer is cleared
+     */
+    const M& takeMessageLocked(Receiver& receiver, BatchBuffer& buffer,
+            boost::uint64_t& enqueued) {
+        if (!receiver.queue.empty()) {
+            Pending pending = receiver.popLocked();
+            enqueued = pending.enqueued;
+            buffer.taken.push_back(boost::move(pending.message));
+            return buffer.taken.back();
+        }
+        if (buffer.segments.empty()
+                || buffer.segments.back() != receiver.segment) {
+            buffer.segments.push_back(receiver.segment);
+        }
+        const M& message = *receiver.segment->messages[receiver.index];
+        enqueued = receiver.segment->enqueued[receiver.index];
+        if (enqueued != 0) {
+            sampleLogHighWaterMarkLocked(receiver);
+        }
+        receiver.advanceLocked();
+        return message;
+    }
+
+    /**
+     * Collects further messages of the job's receiver up to the maximum
+     * batch size, waiting at most the maximum batch delay for new ones, and
+     * passes the accepted ones to the batch delivery handler.
+     */
+    void deliverBatch(Job& job, BatchBuffer& buffer) {
+
+        Receiver& receiver = *job.receiver;
+        std::vector<const M*>& messages = buffer.batch.messages;
+
+        const std::size_t batchSize = std::max(std::size_t(maxBatchSize),
+                std::size_t(1));
+        buffer.taken.reserve(batchSize);
+        messages.push_back(&job.getMessage());
+        if (job.measured) {
+            buffer.enqueued.push_back(job.enqueued);
+        }
+
+        const boost::system_time deadline = boost::get_system_time()
+                + boost::posix_time::milliseconds(maxBatchDelay);
+        {
+            boost::mutex::scoped_lock lock(receiver.mutex);
+            while (messages.size() < batchSize) {
+
+                if (receiver.hasPendingLocked()) {
+                    boost::uint64_t messageEnqueued = 0;
+                    messages.push_back(
+                            &takeMessageLocked(receiver, buffer,
+                                    messageEnqueued));
+                    if (job.measured) {
+                        buffer.enqueued.push_back(messageEnqueued);
+                    }
+                    continue;
+                }
+                if (maxBatchDelay == 0 || interrupted || draining
+                        || !receiver.registered) {
+                    break;
+                }
+
+                // make sure the next push wakes us up
+                if (messageStorage == STORAGE_SHARED_LOG && receiver.segment
+                        && !receiver.waiting) {
+                    boost::mutex::scoped_lock logLock(logMutex);
+                    if (receiver.hasPendingLocked()) {
+                        continue;
+                    }
+                    receiver.waiting = true;
+                    waitingReceivers.push_back(job.receiver);
+                }
+
+                receiver.batching = true;
+                const bool notified = receiver.messageCondition.timed_wait(
+                        lock, deadline);
+                receiver.batching = false;
+                if (!notified && !receiver.hasPendingLocked()) {
+                    break;
+                }
+
+            }
+
+            if (job.measured) {
+                job.started = rsc::misc::currentTimeMicros();
+                const std::vector<boost::uint64_t>& enqueued = buffer.enqueued;
+                for (std::size_t i = 0; i < enqueued.size(); ++i) {
+                    if (enqueued[i] != 0 && job.started >= enqueued[i]) {
+                        receiver.statistics.latency.record(
+                                job.started - enqueued[i]);
+                    }
+                }
+            }
+        }
+
+        // filter outside of the lock to not block pushing
+        std::size_t accepted = 0;
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            if (filterHandler->filter(receiver.receiver, *messages[i])) {
+                messages[accepted++] = messages[i];
+            }
+        }
+        job.rejected = messages.size() - accepted;
+        job.delivered = accepted;
+        messages.resize(accepted);
+
+        if (!messages.empty()) {
+            batchDeliveryHandler->deliver(receiver.receiver, buffer.batch);
+        }
+        buffer.clear();
+
+    }
+
+    /**
+     * Applies the configured CPU affinity and name to a worker thread.
+     */
+    void placeWorker(boost::thread& thread, const unsigned int& workerNum) {
+        if (!workerCpus.empty()) {
+            rsc::os::setThreadAffinity(thread,
+                    std::vector<unsigned int>(1,
+                            workerCpus[workerNum % workerCpus.size()]));
+        }
+        if (!workerNamePrefix.empty()) {
+            rsc::os::setThreadName(thread,
+                    workerNamePrefix
+                            + boost::lexical_cast<std::string>(workerNum));
+        }
+    }
+
+    /**
+     * Largest queueing latency seen since the last check of the auto scaler.
+     */
+    void recordQueueLatency(const boost::uint64_t& micros) {
+        boost::uint64_t current = maxQueueLatency.load(
+                boost::memory_order_relaxed);
+        while (micros > current
+                && !maxQueueLatency.compare_exchange_weak(current, micros,
+                        boost::memory_order_relaxed)) {
+        }
+    }
 
-            if (interrupted) {
-                throw InterruptedException("Processing was interrupted");
-            }
+    /**
+     * Threaded worker method.
+     */
+    void worker(const unsigned int& workerNum,
+            boost::shared_ptr<WorkerCounters> ownCounters) {
 
-            // search for the next job
-            for (size_t pos = 0; pos < receivers.size(); ++pos) {
+        WorkerCounters& counters = *ownCounters;
+        BatchBuffer batchBuffer;
 
-                // TODO is this selection fair in any case?
-                ++currentPosition;
-                size_t realPos = currentPosition % receivers.size();
+        try {
+            // start of the current idle phase if measured, else 0
+            boost::uint64_t idleSince = 0;
+            while (true) {
 
-                // TODO maybe provide an atomic pop and tell if successful
-                // operation in SynchronizedQueue
-                if ((parallelCalls || !receivers[realPos]->processing)
-                        && !receivers[realPos]->queue.empty()) {
+                Job job;
+                if (!nextJob(workerNum, job)) {
+                    return;
+                }
 
-                    // found a job
+                job.measured = statisticsEnabled;
+                if (autoScaling && job.enqueued != 0) {
+                    job.started = rsc::misc::currentTimeMicros();
+                    if (job.started > job.enqueued) {
+                        recordQueueLatency(job.started - job.enqueued);
+                    }
+                }
+                if (job.measured) {
+                    if (job.started == 0) {
+                        job.started = rsc::misc::currentTimeMicros();
+                    }
+                    if (idleSince != 0 && job.started >= idleSince) {
+                        counters.add(counters.idleMicros,
+                                job.started - idleSince);
+                    }
+                }
 
-                    receiver = receivers[realPos];
-                    receiver->processing = true;
-                    gotJob = true;
-                    break;
+                if (batchDeliveryHandler) {
+                    deliverBatch(job, batchBuffer);
+                } else {
+                    const M& message = job.getMessage();
+                    //                std::cout << "Worker " << workerNum << " got new job: "
+                    //                        << message << " for receiver " << *(job.receiver->receiver)
+                    //                        << std::endl;
+                    if (filterHandler->filter(job.receiver->receiver, message)) {
+                        deliveryHandler->deliver(job.receiver->receiver, message);
+                        job.delivered = 1;
+                    } else {
+                        job.rejected = 1;
+                    }
+                }
 
+                if (job.measured) {
+                    job.finished = rsc::misc::currentTimeMicros();
+                    if (job.finished < job.started) {
+                        job.finished = job.started;
+                    }
+                    counters.add(counters.jobs, 1);
+                    counters.add(counters.busyMicros,
+                            job.finished - job.started);
+                    idleSince = job.finished;
+                } else {
+                    idleSince = 0;
                 }
 
-            }
+                finishedWork(job, workerNum);
 
-            // did not find a job, hence there are no other jobs right now
-            if (!gotJob) {
-                jobsAvailable = false;
             }
-
+        } catch (InterruptedException& e) {
+            //            std::cout << "Worker " << workerNum << " was interrupted"
+            //                    << std::endl;
         }
 
-        // if I got a job there are certainly others interested in jobs
-        //        std::cout << "Worker " << workerNum << ": got job for receiver"
-        //                << receiver->receiver << ", notify_one" << std::endl;
-        lock.unlock();
-        jobsAvailableCondition.notify_one();
+    }
 
+    /**
+     * Creates the thread of worker @a workerNum. Acquire #workersMutex before
+     * calling this method.
+     */
+    void startWorkerLocked(const unsigned int& workerNum) {
+        boost::shared_ptr<WorkerCounters> counters;
+        {
+            boost::mutex::scoped_lock lock(countersMutex);
+            while (workerCounters.size() <= workerNum) {
+                workerCounters.push_back(
+                        boost::shared_ptr<WorkerCounters>(new WorkerCounters));
+            }
+            counters = workerCounters[workerNum];
+        }
+        boost::function<void()> workerMethod = boost::bind(
+                &OrderedQueueDispatcherPool::worker, this, workerNum, counters);
+        boost::shared_ptr<boost::thread> w(new boost::thread(workerMethod));
+        threadPool.push_back(w);
+        placeWorker(*w, workerNum);
     }
 
-    unsigned int threadPoolSize;
+    /**
+     * Changes the number of workers. If the ready queues are not laid out
+     * for @a size workers, all workers are restarted with a new layout.
+     * Acquire #workersMutex before calling this method.
+     */
+    void resizeLocked(const unsigned int& size) {
+
+        if (started && size > workerQueues.size()) {
+            // the new workers need their own ready queues, which cannot be
+            // added while other workers use the current ones
+            targetWorkers.store(0);
+            {
+                boost::mutex::scoped_lock lock(idleMutex);
+            }
+            jobsAvailableCondition.notify_all();
+            wakeBatchingWorkers();
+            for (std::size_t i = 0; i < threadPool.size(); ++i) {
+                threadPool[i]->join();
+            }
+            threadPool.clear();
+        }
 
-    void finishedWork(boost::shared_ptr<Receiver> receiver) {
+        threadPoolSize = size;
+        targetWorkers.store(size);
+        if (!started || size > workerQueues.size()) {
+            createReadyQueues();
+        }
+        if (!started) {
+            return;
+        }
 
-        boost::mutex::scoped_lock lock(receiversMutex);
-        // changing this flag must already be locked as it is read by the
-        // globally synchronized nextJob method to determine if a job is
-        // available
-        receiver->processing = false;
-        receiver->processingCondition.notify_all();
-        // maybe avoid informing other threads about new jobs of the receiver
-        // will be removed by adding a flag? Right now they will start to search
-        // for a new job and may not find one.
-        if (!receiver->queue.empty()) {
-            jobsAvailable = true;
-            lock.unlock();
-            jobsAvailableCondition.notify_one();
+        if (size > threadPool.size()) {
+            const unsigned int previous = threadPool.size();
+            try {
+                for (unsigned int i = previous; i < size; ++i) {
+                    startWorkerLocked(i);
+                }
+            } catch (...) {
+                resizeLocked(previous);
+                throw;
+            }
+        } else {
+            // idle workers have to notice that they are removed
+            {
+                boost::mutex::scoped_lock lock(idleMutex);
+            }
+            jobsAvailableCondition.notify_all();
+            for (std::size_t i = size; i < threadPool.size(); ++i) {
+                threadPool[i]->join();
+            }
+            threadPool.resize(size);
         }
 
     }
 
     /**
-     * Threaded worker method.
+     * Adds or removes workers according to the auto scaling policy until
+     * #stop is called.
      */
-    void worker(const unsigned int& workerNum) {
+    void autoScale() {
 
-        try {
-            while (true) {
+        const AutoScalingPolicy policy = autoScalingPolicy;
+        // first check which found idle workers, 0 if the last one did not
+        boost::uint64_t idleSince = 0;
+
+        boost::mutex::scoped_lock lock(scalerMutex);
+        while (!scalerStopped) {
+
+            scalerCondition.timed_wait(lock,
+                    boost::get_system_time() + boost::posix_time::milliseconds(
+                            policy.checkInterval));
+            if (scalerStopped) {
+                break;
+            }
+            lock.unlock();
 
-                boost::shared_ptr<Receiver> receiver;
-                nextJob(workerNum, receiver);
-                M message = receiver->queue.pop();
-                //                std::cout << "Worker " << workerNum << " got new job: "
-                //                        << message << " for receiver " << *(receiver->receiver)
-                //                        << std::endl;
-                if (filterHandler->filter(receiver->receiver, message)) {
-                    deliveryHandler->deliver(receiver->receiver, message);
+            const unsigned int workers = targetWorkers.load();
+            const std::size_t backlog = readyCount.load();
+            const bool idle = idleWorkers.load() > 0;
+            const boost::uint64_t latency = maxQueueLatency.exchange(0);
+            const boost::uint64_t now = rsc::misc::currentTimeMicros();
+
+            unsigned int size = workers;
+            if (!idle && (backlog > policy.backlogThreshold
+                    || (policy.latencyThreshold != 0
+                            && latency > policy.latencyThreshold))) {
+                ++size;
+                idleSince = 0;
+            } else if (idle && backlog == 0) {
+                if (idleSince == 0) {
+                    idleSince = now;
+                } else if (now >= idleSince + boost::uint64_t(
+                        policy.idleTimeout) * 1000) {
+                    --size;
+                    idleSince = now;
                 }
-                finishedWork(receiver);
+            } else {
+                idleSince = 0;
+            }
+            size = std::min(std::max(size, policy.minWorkers),
+                    policy.maxWorkers);
 
+            if (size != workers) {
+                boost::mutex::scoped_lock workersLock(workersMutex);
+                resizeLocked(size);
             }
-        } catch (InterruptedException& e) {
-            //            std::cout << "Worker " << workerNum << " was interrupted"
-            //                    << std::endl;
+
+            lock.lock();
+
         }
 
     }
@@ -349,8 +1825,12 @@ private:
     std::vector<boost::shared_ptr<boost::thread> > threadPool;
 
     DeliveryHandlerPtr deliveryHandler;
+    BatchDeliveryHandlerPtr batchDeliveryHandler;
     FilterHandlerPtr filterHandler;
 
+    volatile std::size_t maxBatchSize;
+    volatile unsigned int maxBatchDelay;
+
 public:
 
     /**
@@ -365,10 +1845,18 @@ public:
      */
     OrderedQueueDispatcherPool(const unsigned int& threadPoolSize,
             deliverFunction delFunc) :
-            currentPosition(0), jobsAvailable(false), interrupted(false), parallelCalls(
-                    false), started(false), threadPoolSize(threadPoolSize), deliveryHandler(
+            nextReceiverId(0), readyCount(0), idleWorkers(0),
+            interrupted(false), parallelCalls(false), started(false),
+            schedulingMode(SCHEDULING_SHARED),
+            messageStorage(STORAGE_PER_RECEIVER), logLength(0),
+            statisticsEnabled(false), numaAware(false), targetWorkers(threadPoolSize),
+            autoScaling(false), scalerStopped(false), maxQueueLatency(0), draining(false),
+            threadPoolSize(threadPoolSize), deliveryHandler(
                     new DeliverFunctionAdapter(delFunc)), filterHandler(
-                    new TrueFilter()) {
+                    new TrueFilter()), maxBatchSize(
+                    DEFAULT_MAX_BATCH_SIZE), maxBatchDelay(0) {
+        createReadyQueues();
+        createWorkerCounters();
     }
 
     /**
@@ -385,10 +1873,18 @@ public:
      */
     OrderedQueueDispatcherPool(const unsigned int& threadPoolSize,
             deliverFunction delFunc, filterFunction filterFunc) :
-            currentPosition(0), jobsAvailable(false), interrupted(false), parallelCalls(
-                    false), started(false), threadPoolSize(threadPoolSize), deliveryHandler(
+            nextReceiverId(0), readyCount(0), idleWorkers(0),
+            interrupted(false), parallelCalls(false), started(false),
+            schedulingMode(SCHEDULING_SHARED),
+            messageStorage(STORAGE_PER_RECEIVER), logLength(0),
+            statisticsEnabled(false), numaAware(false), targetWorkers(threadPoolSize),
+            autoScaling(false), scalerStopped(false), maxQueueLatency(0), draining(false),
+            threadPoolSize(threadPoolSize), deliveryHandler(
                     new DeliverFunctionAdapter(delFunc)), filterHandler(
-                    new FilterFunctionAdapter(filterFunc)) {
+                    new FilterFunctionAdapter(filterFunc)), maxBatchSize(
+                    DEFAULT_MAX_BATCH_SIZE), maxBatchDelay(0) {
+        createReadyQueues();
+        createWorkerCounters();
     }
 
     /**
@@ -400,9 +1896,17 @@ public:
      */
     OrderedQueueDispatcherPool(const unsigned int& threadPoolSize,
             DeliveryHandlerPtr deliveryHandler) :
-            currentPosition(0), jobsAvailable(false), interrupted(false), parallelCalls(
-                    false), started(false), threadPoolSize(threadPoolSize), deliveryHandler(
-                    deliveryHandler), filterHandler(new TrueFilter) {
+            nextReceiverId(0), readyCount(0), idleWorkers(0),
+            interrupted(false), parallelCalls(false), started(false),
+            schedulingMode(SCHEDULING_SHARED),
+            messageStorage(STORAGE_PER_RECEIVER), logLength(0),
+            statisticsEnabled(false), numaAware(false), targetWorkers(threadPoolSize),
+            autoScaling(false), scalerStopped(false), maxQueueLatency(0), draining(false),
+            threadPoolSize(threadPoolSize), deliveryHandler(
+                    deliveryHandler), filterHandler(new TrueFilter), maxBatchSize(
+                    DEFAULT_MAX_BATCH_SIZE), maxBatchDelay(0) {
+        createReadyQueues();
+        createWorkerCounters();
     }
 
     /**
@@ -414,9 +1918,64 @@ public:
      */
     OrderedQueueDispatcherPool(const unsigned int& threadPoolSize,
             DeliveryHandlerPtr deliveryHandler, FilterHandlerPtr filterHandler) :
-            currentPosition(0), jobsAvailable(false), interrupted(false), parallelCalls(
-                    false), started(false), threadPoolSize(threadPoolSize), deliveryHandler(
-                    deliveryHandler), filterHandler(filterHandler) {
+            nextReceiverId(0), readyCount(0), idleWorkers(0),
+            interrupted(false), parallelCalls(false), started(false),
+            schedulingMode(SCHEDULING_SHARED),
+            messageStorage(STORAGE_PER_RECEIVER), logLength(0),
+            statisticsEnabled(false), numaAware(false), targetWorkers(threadPoolSize),
+            autoScaling(false), scalerStopped(false), maxQueueLatency(0), draining(false),
+            threadPoolSize(threadPoolSize), deliveryHandler(
+                    deliveryHandler), filterHandler(filterHandler), maxBatchSize(
+                    DEFAULT_MAX_BATCH_SIZE), maxBatchDelay(0) {
+        createReadyQueues();
+        createWorkerCounters();
+    }
+
+    /**
+     * Constructs a new pool which delivers messages in batches and accepts
+     * every message.
+     *
+     * @param threadPoolSize number of threads for this pool
+     * @param batchDeliveryHandler handler to deliver batches of messages to
+     *                             receivers
+     */
+    OrderedQueueDispatcherPool(const unsigned int& threadPoolSize,
+            BatchDeliveryHandlerPtr batchDeliveryHandler) :
+            nextReceiverId(0), readyCount(0), idleWorkers(0),
+            interrupted(false), parallelCalls(false), started(false),
+            schedulingMode(SCHEDULING_SHARED),
+            messageStorage(STORAGE_PER_RECEIVER), logLength(0),
+            statisticsEnabled(false), numaAware(false), targetWorkers(threadPoolSize),
+            autoScaling(false), scalerStopped(false), maxQueueLatency(0), draining(false),
+            threadPoolSize(threadPoolSize), batchDeliveryHandler(
+                    batchDeliveryHandler), filterHandler(new TrueFilter), maxBatchSize(
+                    DEFAULT_MAX_BATCH_SIZE), maxBatchDelay(0) {
+        createReadyQueues();
+        createWorkerCounters();
+    }
+
+    /**
+     * Constructs a new pool which delivers messages in batches.
+     *
+     * @param threadPoolSize number of threads for this pool
+     * @param batchDeliveryHandler handler to deliver batches of messages to
+     *                             receivers
+     * @param filterHandler filter handler for messages
+     */
+    OrderedQueueDispatcherPool(const unsigned int& threadPoolSize,
+            BatchDeliveryHandlerPtr batchDeliveryHandler,
+            FilterHandlerPtr filterHandler) :
+            nextReceiverId(0), readyCount(0), idleWorkers(0),
+            interrupted(false), parallelCalls(false), started(false),
+            schedulingMode(SCHEDULING_SHARED),
+            messageStorage(STORAGE_PER_RECEIVER), logLength(0),
+            statisticsEnabled(false), numaAware(false), targetWorkers(threadPoolSize),
+            autoScaling(false), scalerStopped(false), maxQueueLatency(0), draining(false),
+            threadPoolSize(threadPoolSize), batchDeliveryHandler(
+                    batchDeliveryHandler), filterHandler(filterHandler), maxBatchSize(
+                    DEFAULT_MAX_BATCH_SIZE), maxBatchDelay(0) {
+        createReadyQueues();
+        createWorkerCounters();
     }
 
     virtual ~OrderedQueueDispatcherPool() {
@@ -433,9 +1992,49 @@ public:
      * @param receiver new receiver
      */
     void registerReceiver(boost::shared_ptr<R> receiver) {
+        registerReceiver(receiver, 0);
+    }
+
+    /**
+     * Registers a new receiver at the pool with a limited number of pending
+     * messages. See #registerReceiver(boost::shared_ptr<R>) for details.
+     *
+     * @param receiver new receiver
+     * @param capacity maximum number of pending messages for this receiver,
+     *                 0 for no limit
+     * @param policy what to do if a message is pushed while @a capacity
+     *               messages are pending
+     * @param overflowCallback function called with messages that did not
+     *                         fit if @a policy is OVERFLOW_CALLBACK
+     * @throw std::invalid_argument if @a policy is OVERFLOW_CALLBACK and no
+     *                              callback is given
+     */
+    void registerReceiver(boost::shared_ptr<R> receiver,
+            const std::size_t& capacity, const OverflowPolicy& policy =
+                    OVERFLOW_BLOCK, overflowFunction overflowCallback =
+                    overflowFunction()) {
+
+        if (policy == OVERFLOW_CALLBACK && !overflowCallback) {
+            throw std::invalid_argument(
+                    "OVERFLOW_CALLBACK requires an overflow callback");
+        }
+
         boost::mutex::scoped_lock lock(receiversMutex);
-        boost::shared_ptr<Receiver> rec(new Receiver(receiver));
+        boost::shared_ptr<Receiver> rec(
+                new Receiver(receiver, nextReceiverId++, capacity, policy,
+                        overflowCallback));
+        if (capacity != 0) {
+            boundedReceivers.push_back(rec);
+        } else if (messageStorage == STORAGE_SHARED_LOG) {
+            // only messages pushed after the registration are delivered
+            boost::mutex::scoped_lock logLock(logMutex);
+            rec->segment = logTail;
+            rec->index = logTail->size.load();
+            rec->waiting = true;
+            waitingReceivers.push_back(rec);
+        }
         receivers.push_back(rec);
+
     }
 
     /**
@@ -453,9 +2052,24 @@ public:
             boost::shared_ptr<Receiver> rec = *it;
             if (rec->receiver == receiver) {
                 it = receivers.erase(it);
-                while (rec->processing) {
-                    rec ->processingCondition.wait(lock);
+                if (rec->capacity != 0) {
+                    boundedReceivers.erase(
+                            std::find(boundedReceivers.begin(),
+                                    boundedReceivers.end(), rec));
                 }
+                lock.unlock();
+                // entries in the ready queues are discarded lazily
+                boost::mutex::scoped_lock receiverLock(rec->mutex);
+                rec->registered = false;
+                rec->queue.clear();
+                rec->segment.reset();
+                rec->messageCondition.notify_all();
+                rec->spaceCondition.notify_all();
+                while (rec->processing > 0) {
+                    rec->processingCondition.wait(receiverLock);
+                }
+                receiverLock.unlock();
+                notifyDrain();
                 return true;
             }
         }
@@ -483,6 +2097,337 @@ public:
         parallelCalls = allow;
     }
 
+    /**
+     * Sets the maximum number of messages passed to the
+     * BatchDeliveryHandler in one call. The default is
+     * DEFAULT_MAX_BATCH_SIZE.
+     *
+     * @param size maximum batch size
+     * @throw std::invalid_argument if @a size is 0
+     */
+    void setMaxBatchSize(const std::size_t& size) {
+        if (size == 0) {
+            throw std::invalid_argument("Batch size must be at least 1");
+        }
+        maxBatchSize = size;
+    }
+
+    /**
+     * Sets the time a worker waits for further messages of a receiver once
+     * it started to collect a batch that is not yet full. The worker is
+     * blocked while waiting, so larger values trade latency and available
+     * workers for larger batches. The default of 0 only batches messages
+     * which are already pending.
+     *
+     * @param milliseconds maximum delay in milliseconds
+     */
+    void setMaxBatchDelay(const unsigned int& milliseconds) {
+        maxBatchDelay = milliseconds;
+    }
+
+    /**
+     * Selects how workers find the next receiver to process. The default is
+     * SCHEDULING_SHARED. Both modes give the same ordering guarantees.
+     *
+     * @param mode the new scheduling mode
+     * @throw IllegalStateException if the pool is running
+     */
+    void setSchedulingMode(const SchedulingMode& mode) {
+        if (started) {
+            throw rsc::misc::IllegalStateException(
+                    "Scheduling mode cannot be changed while the pool is running");
+        }
+        schedulingMode = mode;
+        createReadyQueues();
+    }
+
+    /**
+     * Pins the workers to CPUs when the pool is started. Worker @c i is
+     * pinned to <code>cpus[i % cpus.size()]</code>. Not supported on all
+     * platforms.
+     *
+     * @param cpus CPU indices for the workers, empty to not pin workers
+     * @throw IllegalStateException if the pool is running
+     */
+    void setWorkerAffinity(const std::vector<unsigned int>& cpus) {
+        if (started) {
+            throw rsc::misc::IllegalStateException(
+                    "Worker affinity cannot be changed while the pool is running");
+        }
+        workerCpus = cpus;
+        createReadyQueues();
+    }
+
+    /**
+     * Returns the CPUs workers are pinned to.
+     *
+     * @return CPU indices, empty if workers are not pinned
+     */
+    std::vector<unsigned int> getWorkerAffinity() const {
+        return workerCpus;
+    }
+
+    /**
+     * Keeps receivers on the NUMA node of the CPUs of the workers which
+     * process them. Receivers are distributed over the nodes of the pinned
+     * workers and workers prefer receivers of their own node. Workers only
+     * take receivers of other nodes if there is no work on their own node.
+     * Without pinned workers, see #setWorkerAffinity, this has no effect.
+     *
+     * @param aware if @c true, receivers are partitioned by NUMA node
+     * @throw IllegalStateException if the pool is running
+     */
+    void setNumaAware(const bool& aware) {
+        if (started) {
+            throw rsc::misc::IllegalStateException(
+                    "NUMA awareness cannot be changed while the pool is running");
+        }
+        numaAware = aware;
+        createReadyQueues();
+    }
+
+    /**
+     * Sets a prefix for the names of the worker threads. Workers are named
+     * by appending their number to the prefix when the pool is started.
+     *
+     * @param prefix name prefix, empty to not name threads
+     */
+    void setWorkerNamePrefix(const std::string& prefix) {
+        workerNamePrefix = prefix;
+    }
+
+    /**
+     * Returns the current scheduling mode.
+     *
+     * @return scheduling mode
+     */
+    SchedulingMode getSchedulingMode() const {
+        return schedulingMode;
+    }
+
+    /**
+     * Selects how pushed messages are stored until they are delivered. The
+     * default is STORAGE_PER_RECEIVER. Messages which are already pending
+     * are kept and delivered in order. Must not be called concurrently with
+     * #push.
+     *
+     * @param storage the new message storage
+     * @throw IllegalStateException if the pool is running
+     */
+    void setMessageStorage(const MessageStorage& storage) {
+
+        if (started) {
+            throw rsc::misc::IllegalStateException(
+                    "Message storage cannot be changed while the pool is running");
+        }
+
+        boost::mutex::scoped_lock lock(receiversMutex);
+        if (storage == messageStorage) {
+            return;
+        }
+
+        if (storage == STORAGE_SHARED_LOG) {
+            logTail.reset(new LogSegment(logLength.load()));
+            messageStorage = storage;
+            for (typename std::vector<boost::shared_ptr<Receiver> >::iterator
+                    it = receivers.begin(); it != receivers.end(); ++it) {
+                boost::mutex::scoped_lock receiverLock((*it)->mutex);
+                if ((*it)->capacity == 0) {
+                    (*it)->segment = logTail;
+                    (*it)->index = 0;
+                    scheduleLocked(*it, homeQueue((*it)->id));
+                }
+            }
+        } else {
+            // pending messages from the log are newer than the ones in the
+            // receiver's queue
+            for (typename std::vector<boost::shared_ptr<Receiver> >::iterator
+                    it = receivers.begin(); it != receivers.end(); ++it) {
+                Receiver& receiver = **it;
+                boost::mutex::scoped_lock receiverLock(receiver.mutex);
+                while (receiver.segment && receiver.index
+                        < receiver.segment->size.load()) {
+                    receiver.pushLocked(
+                            *receiver.segment->messages[receiver.index],
+                            receiver.segment->enqueued[receiver.index]);
+                    receiver.advanceLocked();
+                }
+                receiver.segment.reset();
+                receiver.waiting = false;
+            }
+            waitingReceivers.clear();
+            logTail.reset();
+            messageStorage = storage;
+        }
+
+    }
+
+    /**
+     * Returns the current message storage.
+     *
+     * @return message storage
+     */
+    MessageStorage getMessageStorage() const {
+        return messageStorage;
+    }
+
+    /**
+     * Enables or disables the collection of statistics. Disabled by default.
+     * When enabled, each message costs a few additional time measurements.
+     *
+     * @param enabled if @c true, statistics are collected
+     */
+    void setStatisticsEnabled(const bool& enabled) {
+        statisticsEnabled = enabled;
+    }
+
+    /**
+     * Tells whether statistics are collected.
+     *
+     * @return @c true if statistics are collected
+     */
+    bool isStatisticsEnabled() const {
+        return statisticsEnabled;
+    }
+
+    /**
+     * Returns the utilization of each worker thread.
+     *
+     * @return statistics indexed by worker number
+     */
+    std::vector<WorkerStatistics> getWorkerStatistics() const {
+        boost::mutex::scoped_lock lock(countersMutex);
+        std::vector<WorkerStatistics> result;
+        for (std::size_t i = 0; i < workerCounters.size(); ++i) {
+            WorkerStatistics statistics;
+            statistics.jobs = workerCounters[i]->jobs.load(
+                    boost::memory_order_relaxed);
+            statistics.busyMicros = workerCounters[i]->busyMicros.load(
+                    boost::memory_order_relaxed);
+            statistics.idleMicros = workerCounters[i]->idleMicros.load(
+                    boost::memory_order_relaxed);
+            result.push_back(statistics);
+        }
+        return result;
+    }
+
+    /**
+     * Returns the counters of a receiver summed up over all of its
+     * registrations.
+     *
+     * @param receiver registered receiver
+     * @return counters of @a receiver
+     * @throw std::invalid_argument if @a receiver is not registered
+     */
+    ReceiverStatistics getReceiverStatistics(boost::shared_ptr<R> receiver) {
+
+        boost::mutex::scoped_lock lock(receiversMutex);
+
+        bool found = false;
+        ReceiverStatistics result;
+        for (typename std::vector<boost::shared_ptr<Receiver> >::iterator it =
+                receivers.begin(); it != receivers.end(); ++it) {
+            if ((*it)->receiver != receiver) {
+                continue;
+            }
+            found = true;
+            boost::mutex::scoped_lock receiverLock((*it)->mutex);
+            result.merge((*it)->statistics);
+        }
+        if (!found) {
+            throw std::invalid_argument("Receiver is not registered");
+        }
+        return result;
+
+    }
+
+    /**
+     * Changes the number of worker threads. If the pool is running, workers
+     * are started or removed right away. Removed workers finish their
+     * current job first and this method blocks until they have exited.
+     * Hence, it must not be called from a handler of this pool. Growing
+     * beyond the number of workers the ready queues are laid out for, i.e.
+     * the largest size so far or the maximum of the auto scaling policy,
+     * briefly stops all workers after their current job to lay out the
+     * queues for the new size, so that the new workers get queues of their
+     * own. While
+     * auto scaling, the auto scaler continues from the new size.
+     *
+     * @param size new number of workers
+     * @throw std::invalid_argument if @a size is 0
+     */
+    void resize(const unsigned int& size) {
+        if (size == 0) {
+            throw std::invalid_argument("The pool needs at least one worker");
+        }
+        boost::mutex::scoped_lock lock(workersMutex);
+        resizeLocked(size);
+    }
+
+    /**
+     * Returns the number of workers which are running or will be started.
+     *
+     * @return number of workers
+     */
+    unsigned int getWorkerCount() const {
+        return targetWorkers.load();
+    }
+
+    /**
+     * Lets a background thread add workers when receivers wait for workers
+     * and remove them when workers are idle, within the bounds of
+     * @a policy. The current number of workers is clamped to these bounds.
+     * Ready queues are sized for the maximum number of workers.
+     *
+     * @param policy thresholds for adding and removing workers
+     * @throw std::invalid_argument if the bounds or the interval of
+     *                              @a policy are invalid
+     * @throw IllegalStateException if the pool is running
+     */
+    void setAutoScaling(const AutoScalingPolicy& policy) {
+        if (started) {
+            throw rsc::misc::IllegalStateException(
+                    "Auto scaling cannot be changed while the pool is running");
+        }
+        if (policy.minWorkers == 0 || policy.minWorkers > policy.maxWorkers) {
+            throw std::invalid_argument(
+                    "Auto scaling needs 0 < minWorkers <= maxWorkers");
+        }
+        if (policy.checkInterval == 0) {
+            throw std::invalid_argument(
+                    "Auto scaling needs a check interval greater than 0");
+        }
+        boost::mutex::scoped_lock lock(workersMutex);
+        autoScaling = true;
+        autoScalingPolicy = policy;
+        resizeLocked(std::min(std::max(threadPoolSize, policy.minWorkers),
+                policy.maxWorkers));
+    }
+
+    /**
+     * Disables auto scaling. The current number of workers is kept.
+     *
+     * @throw IllegalStateException if the pool is running
+     */
+    void disableAutoScaling() {
+        if (started) {
+            throw rsc::misc::IllegalStateException(
+                    "Auto scaling cannot be changed while the pool is running");
+        }
+        boost::mutex::scoped_lock lock(workersMutex);
+        autoScaling = false;
+        createReadyQueues();
+    }
+
+    /**
+     * Tells whether the number of workers is adjusted automatically.
+     *
+     * @return @c true if auto scaling is enabled
+     */
+    bool isAutoScaling() const {
+        return autoScaling;
+    }
+
     /**
      * Non-blocking start.
      *
@@ -491,22 +2436,38 @@ public:
      */
     void start() {
 
+        boost::mutex::scoped_lock workersLock(workersMutex);
         boost::mutex::scoped_lock lock(receiversMutex);
         if (started) {
             throw rsc::misc::IllegalStateException("Pool already running");
         }
 
         interrupted = false;
+        draining = false;
+        targetWorkers.store(threadPoolSize);
 
         for (unsigned int i = 0; i < threadPoolSize; ++i) {
-            boost::function<void()> workerMethod = boost::bind(
-                    &OrderedQueueDispatcherPool::worker, this, i);
-            boost::shared_ptr<boost::thread> w(new boost::thread(workerMethod));
-            threadPool.push_back(w);
+            try {
+                startWorkerLocked(i);
+            } catch (...) {
+                lock.unlock();
+                workersLock.unlock();
+                stop();
+                throw;
+            }
         }
 
         started = true;
 
+        if (autoScaling) {
+            scalerStopped = false;
+            maxQueueLatency.store(0);
+            scaler.reset(
+                    new boost::thread(
+                            boost::bind(&OrderedQueueDispatcherPool::autoScale,
+                                    this)));
+        }
+
     }
 
     /**
@@ -514,11 +2475,24 @@ public:
      */
     void stop() {
 
+        if (scaler) {
+            {
+                boost::mutex::scoped_lock lock(scalerMutex);
+                scalerStopped = true;
+            }
+            scalerCondition.notify_all();
+            scaler->join();
+            scaler.reset();
+        }
+
+        boost::mutex::scoped_lock workersLock(workersMutex);
+
+        interrupted = true;
         {
-            boost::mutex::scoped_lock lock(receiversMutex);
-            interrupted = true;
+            boost::mutex::scoped_lock lock(idleMutex);
         }
         jobsAvailableCondition.notify_all();
+        wakeBatchingWorkers();
 
         for (unsigned int i = 0; i < threadPool.size(); ++i) {
             threadPool[i]->join();
@@ -529,23 +2503,149 @@ public:
 
     }
 
+    /**
+     * Stops the pool after delivering the pending messages. From now on,
+     * #push rejects new messages until the pool is started again. Workers
+     * keep delivering the messages which are already pending, in order,
+     * until none are left or the timeout elapsed. Afterwards the pool is
+     * stopped like with #stop. Must not be called from a handler of this
+     * pool.
+     *
+     * @param timeoutMs maximum time to wait for the pending messages in
+     *                  milliseconds, 0 to wait until all are delivered
+     * @return number of messages which were not delivered because the
+     *         timeout elapsed. They stay pending and are delivered if the
+     *         pool is started again.
+     */
+    std::size_t drain(const boost::uint32_t& timeoutMs = 0) {
+
+        draining = true;
+        // batches are not going to grow anymore
+        wakeBatchingWorkers();
+
+        const boost::system_time deadline = boost::get_system_time()
+                + boost::posix_time::milliseconds(timeoutMs);
+        {
+            boost::mutex::scoped_lock lock(drainMutex);
+            bool busy = false;
+            while (started && (countPending(busy) != 0 || busy)) {
+                if (timeoutMs == 0) {
+                    drainCondition.wait(lock);
+                } else if (!drainCondition.timed_wait(lock, deadline)) {
+                    break;
+                }
+            }
+        }
+
+        stop();
+
+        bool busy = false;
+        return countPending(busy);
+
+    }
+
     /**
      * Pushes a new message to be dispatched to all receivers in this pool.
+     * Blocks if a receiver registered with OVERFLOW_BLOCK has no space left
+     * in its queue.
      *
      * @param message message to dispatch
+     * @throw IllegalStateException if the pool is draining, see #drain
      */
     void push(const M& message) {
 
-        //        std::cout << "new job " << message << std::endl;
+        if (draining) {
+            throw rsc::misc::IllegalStateException(
+                    "Pool is draining and does not accept messages");
+        }
+
+        const boost::uint64_t enqueued =
+                statisticsEnabled || autoScaling ? rsc::misc::currentTimeMicros()
+                        : 0;
+
+        std::size_t newlyReady = 0;
+        if (messageStorage == STORAGE_SHARED_LOG) {
+            // receivers which still have pending messages will get to the
+            // new one on their own
+            std::vector<boost::shared_ptr<Receiver> > waiting;
+            {
+                boost::mutex::scoped_lock lock(logMutex);
+                appendLocked(message, enqueued);
+                waiting.swap(waitingReceivers);
+            }
+            // the receivers mutex keeps the ready queues from being
+            // recreated by #resize
+            boost::mutex::scoped_lock lock(receiversMutex);
+            for (typename std::vector<boost::shared_ptr<Receiver> >::iterator
+                    it = waiting.begin(); it != waiting.end(); ++it) {
+                boost::mutex::scoped_lock receiverLock((*it)->mutex);
+                (*it)->waiting = false;
+                if ((*it)->batching) {
+                    (*it)->messageCondition.notify_all();
+                }
+                if (scheduleLocked(*it, homeQueue((*it)->id))) {
+                    ++newlyReady;
+                }
+            }
+        }
+
+        // receivers which did not accept the message with the turn of this
+        // pusher for blocking receivers
+        std::vector<std::pair<boost::shared_ptr<Receiver>, boost::uint64_t> >
+                full;
         {
             boost::mutex::scoped_lock lock(receiversMutex);
+            std::vector<boost::shared_ptr<Receiver> >& queued =
+                    messageStorage == STORAGE_SHARED_LOG ? boundedReceivers
+                            : receivers;
             for (typename std::vector<boost::shared_ptr<Receiver> >::iterator
-                    it = receivers.begin(); it != receivers.end(); ++it) {
-                (*it)->queue.push(message);
+                    it = queued.begin(); it != queued.end(); ++it) {
+                boost::mutex::scoped_lock receiverLock((*it)->mutex);
+                boost::uint64_t turn = 0;
+                if (!(*it)->enqueueLocked(message, enqueued, turn)) {
+                    full.push_back(std::make_pair(*it, turn));
+                } else if (scheduleLocked(*it, homeQueue((*it)->id))) {
+                    ++newlyReady;
+                }
+            }
+        }
+        wakeWorkers(newlyReady);
+
+        // overflows are handled without holding the receivers mutex so that
+        // they cannot stall stop or unregistration
+        for (typename std::vector<std::pair<boost::shared_ptr<Receiver>,
+                boost::uint64_t> >::iterator it = full.begin();
+                it != full.end(); ++it) {
+            Receiver& receiver = *it->first;
+            if (receiver.policy == OVERFLOW_CALLBACK) {
+                receiver.overflowCallback(receiver.receiver, message);
+            } else if (receiver.policy == OVERFLOW_BLOCK) {
+                boost::mutex::scoped_lock receiverLock(receiver.mutex);
+                while (receiver.registered
+                        && (receiver.servingTurn != it->second
+                                || receiver.queue.size() >= receiver.capacity)) {
+                    receiver.spaceCondition.wait(receiverLock);
+                }
+                --receiver.blockedPushers;
+                ++receiver.servingTurn;
+                if (receiver.blockedPushers > 0) {
+                    receiver.spaceCondition.notify_all();
+                }
+                if (receiver.registered) {
+                    receiver.pushLocked(message, enqueued);
+                    receiverLock.unlock();
+                    // scheduling needs the receivers mutex, which has to be
+                    // acquired first
+                    boost::mutex::scoped_lock lock(receiversMutex);
+                    receiverLock.lock();
+                    const bool scheduled = scheduleLocked(it->first,
+                            homeQueue(receiver.id));
+                    receiverLock.unlock();
+                    lock.unlock();
+                    wakeWorkers(scheduled ? 1 : 0);
+                }
             }
-            jobsAvailable = true;
         }
-        jobsAvailableCondition.notify_one();
 
     }
 
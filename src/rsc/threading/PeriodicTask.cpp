@@ -31,10 +31,13 @@ using namespace std;
 namespace rsc {
 namespace threading {
 
-PeriodicTask::PeriodicTask(const unsigned int& ms, bool accountProcTime) :
+PeriodicTask::PeriodicTask(const unsigned int& ms, bool accountProcTime,
+        const OverrunPolicy& overrunPolicy) :
         cycleTime(ms), logger(
                 rsc::logging::Logger::getLogger("rsc.threading.PeriodicTask")), fixedScheduling(
-                accountProcTime), nextProcessingStart(0) {
+                accountProcTime), overrunPolicy(overrunPolicy), lastPlannedStart(
+                0) {
+    setCycleBudget(boost::uint64_t(ms) * 1000);
 }
 
 PeriodicTask::~PeriodicTask() {
@@ -48,40 +51,155 @@ bool PeriodicTask::continueExec() {
         return false;
     }
 
-    if (nextProcessingStart == 0) {
-        nextProcessingStart = rsc::misc::currentTimeMicros() + cycleTime * 1000;
-        return true;
+    const boost::uint64_t now = rsc::misc::currentTimeMicros();
+    boost::uint64_t plannedStart;
+    if (lastPlannedStart == 0) {
+        // the start of the first iteration is unknown, hence schedule
+        // relative to its end
+        plannedStart = now + boost::uint64_t(cycleTime) * 1000;
+    } else {
+        plannedStart = nextStart(lastPlannedStart, now);
     }
 
-    // wait, give others a chance
-    if (cycleTime != 0) {
-        // TODO provide option to interrupt in cancel using boost::this_thread
-        try {
-            RSCTRACE(
-                    logger,
-                    "PeriodicTask()::continueExec() before thread sleep, sleeping " << cycleTime << " ms");
-            if (fixedScheduling) {
-                boost::this_thread::sleep(
-                        boost::posix_time::microseconds(
-                                nextProcessingStart
-                                        - rsc::misc::currentTimeMicros()));
-            } else {
-                boost::this_thread::sleep(
-                        boost::posix_time::microseconds(cycleTime * 1000));
+    RSCTRACE(
+            logger,
+            "PeriodicTask()::continueExec() waiting " << (plannedStart > now ? plannedStart - now : 0) << " us");
+    if (!waitUntil(plannedStart)) {
+        return false;
+    }
+    RSCTRACE(logger, "PeriodicTask()::continueExec() thread woke up");
+
+    recordJitter(plannedStart);
+    lastPlannedStart = plannedStart;
+
+    return true;
+}
+
+void PeriodicTask::cancel() {
+    boost::function<void()> handler;
+    {
+        boost::mutex::scoped_lock lock(cancelMutex);
+        RepetitiveTask::cancel();
+        handler = cancelHandler;
+    }
+    cancelCondition.notify_all();
+    if (handler) {
+        handler();
+    }
+}
+
+void PeriodicTask::setCancelHandler(const boost::function<void()>& handler) {
+    {
+        boost::mutex::scoped_lock lock(cancelMutex);
+        cancelHandler = handler;
+        if (!isCancelRequested()) {
+            return;
+        }
+    }
+    if (handler) {
+        handler();
+    }
+}
+
+bool PeriodicTask::waitUntil(const boost::uint64_t& deadline) {
+
+    try {
+        boost::mutex::scoped_lock lock(cancelMutex);
+        while (!isCancelRequested()) {
+            const boost::uint64_t now = rsc::misc::currentTimeMicros();
+            if (now >= deadline) {
+                return true;
             }
-        } catch (const boost::thread_interrupted& e) {
-            // TODO handle interruption somewhere directly in task. This is
-            // something all tasks should benefit of, see above TODO.
-            RSCWARN(
-                    logger,
-                    "PeriodicTask()::continueExec() caught boost::thread_interrupted exception");
-            return false;
-        }RSCTRACE(logger, "PeriodicTask()::continueExec() thread woke up");
-    }RSCTRACE(logger, "PeriodicTask()::continueExec() before lock");
-
-    nextProcessingStart += cycleTime * 1000;
+            cancelCondition.timed_wait(lock,
+                    boost::get_system_time()
+                            + boost::posix_time::microseconds(deadline - now));
+        }
+    } catch (const boost::thread_interrupted& e) {
+        RSCWARN(
+                logger,
+                "PeriodicTask()::continueExec() caught boost::thread_interrupted exception");
+    }
+    return false;
+
+}
+
+boost::uint64_t PeriodicTask::nextStart(const boost::uint64_t& plannedStart,
+        const boost::uint64_t& now) const {
+
+    const boost::uint64_t cycle = boost::uint64_t(cycleTime) * 1000;
+    if (!fixedScheduling) {
+        return now + cycle;
+    }
+
+    const boost::uint64_t next = plannedStart + cycle;
+    if (next >= now) {
+        return next;
+    }
+
+    switch (overrunPolicy) {
+    case OVERRUN_SKIP:
+        if (cycle == 0) {
+            return now;
+        }
+        // first start of the original schedule which is not yet missed
+        return next + ((now - next + cycle - 1) / cycle) * cycle;
+    case OVERRUN_SHIFT:
+        return now;
+    case OVERRUN_CATCH_UP:
+    default:
+        return next;
+    }
+
+}
+
+bool PeriodicTask::runCycle(const boost::uint64_t& plannedStart) {
 
+    if (isCancelRequested()) {
+        markDone();
+        return false;
+    }
+
+    if (plannedStart != 0) {
+        recordJitter(plannedStart);
+    }
+    try {
+        pre();
+        execute();
+        post();
+    } catch (...) {
+        markDone();
+        throw;
+    }
+
+    if (isCancelRequested()) {
+        markDone();
+        return false;
+    }
     return true;
+
+}
+
+unsigned int PeriodicTask::getCycleTime() const {
+    return cycleTime;
+}
+
+bool PeriodicTask::isFixedScheduling() const {
+    return fixedScheduling;
+}
+
+PeriodicTask::OverrunPolicy PeriodicTask::getOverrunPolicy() const {
+    return overrunPolicy;
+}
+
+rsc::misc::Histogram PeriodicTask::getJitter() const {
+    boost::mutex::scoped_lock lock(jitterMutex);
+    return jitter;
+}
+
+void PeriodicTask::recordJitter(const boost::uint64_t& plannedStart) {
+    const boost::uint64_t now = rsc::misc::currentTimeMicros();
+    boost::mutex::scoped_lock lock(jitterMutex);
+    jitter.record(now > plannedStart ? now - plannedStart : 0);
 }
 
 }
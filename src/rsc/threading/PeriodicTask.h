@@ -28,6 +28,11 @@
 
 #include "RepetitiveTask.h"
 
+#include <boost/function.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <rsc/misc/Histogram.h>
 #include <rsc/misc/langutils.h>
 
 #include <iostream>
@@ -40,6 +45,10 @@ namespace threading {
  * providing an special implementation of #continueExec. A fixed interval
  * is guaranteed.
  *
+ * Waiting for the next iteration is interrupted immediately by #cancel. If an
+ * iteration of a task with fixed scheduling takes longer than the cycle time,
+ * the OverrunPolicy decides when the following iterations start.
+ *
  * @author swrede
  * @author jwienke
  * @author anordman
@@ -47,16 +56,40 @@ namespace threading {
 class RSC_EXPORT PeriodicTask: public RepetitiveTask {
 public:
 
+    /**
+     * Strategies for iterations which did not start in time with fixed
+     * scheduling because previous iterations took too long.
+     */
+    enum OverrunPolicy {
+        /**
+         * Drops the missed iterations and waits for the next start time of
+         * the original schedule.
+         */
+        OVERRUN_SKIP,
+        /**
+         * Runs the missed iterations back to back until the original schedule
+         * is reached again. This is the default.
+         */
+        OVERRUN_CATCH_UP,
+        /**
+         * Starts the next iteration immediately and continues the schedule
+         * from there.
+         */
+        OVERRUN_SHIFT
+    };
+
     /**
      * Constructs a new periodic task with a fixed wait time after each
      * iteration.
      *
-     * @param ms time to wait between iterations. No overall-fixed interval
-     *           is guaranteed by the implementation. Time is in milliseconds.
+     * @param ms time to wait between iterations. Time is in milliseconds.
      * @param accountProcTime subtracts the processing time from sleep time in
      *           order to guarantee a fixed scheduling interval
+     * @param overrunPolicy strategy for iterations that could not start in
+     *                      time, only applies to fixed scheduling
      */
-    PeriodicTask(const unsigned int& ms, bool accountProcTime = true);
+    PeriodicTask(const unsigned int& ms, bool accountProcTime = true,
+            const OverrunPolicy& overrunPolicy = OVERRUN_CATCH_UP);
 
     virtual ~PeriodicTask();
 
@@ -68,11 +101,103 @@ public:
      */
     virtual bool continueExec();
 
+    /**
+     * Interrupts the task and wakes it up if it waits for the next iteration.
+     */
+    virtual void cancel();
+
+    /**
+     * Performs a single iteration for executors which schedule the
+     * iterations themselves instead of calling #run, e.g.
+     * PooledTaskExecutor. The task is marked as done if it is canceled.
+     *
+     * @param plannedStart time in microseconds at which this iteration
+     *                     should have started, used to record the jitter.
+     *                     0 to not record it.
+     * @return @c true if another iteration shall be scheduled
+     */
+    bool runCycle(const boost::uint64_t& plannedStart);
+
+    /**
+     * Sets a function which is called by #cancel, e.g. by executors which
+     * schedule the iterations themselves to run the pending iteration
+     * immediately. Replaces the previously set function. If the task is
+     * already canceled, @a handler is called right away.
+     *
+     * @param handler function to call on cancellation, called without
+     *                holding locks of this task
+     */
+    void setCancelHandler(const boost::function<void()>& handler);
+
+    /**
+     * Returns the time between iterations.
+     *
+     * @return cycle time in milliseconds
+     */
+    unsigned int getCycleTime() const;
+
+    /**
+     * Tells whether iterations start at a fixed rate, accounting for the
+     * processing time, or with a fixed delay after the previous iteration.
+     *
+     * @return @c true for a fixed rate
+     */
+    bool isFixedScheduling() const;
+
+    /**
+     * Returns the strategy for iterations that could not start in time.
+     *
+     * @return overrun policy
+     */
+    OverrunPolicy getOverrunPolicy() const;
+
+    /**
+     * Computes the start of the iteration following the one planned for
+     * @a plannedStart according to the scheduling mode and the
+     * OverrunPolicy.
+     *
+     * @param plannedStart planned start of the previous iteration in
+     *                     microseconds
+     * @param now current time in microseconds after the previous iteration
+     * @return planned start of the next iteration in microseconds
+     */
+    boost::uint64_t nextStart(const boost::uint64_t& plannedStart,
+            const boost::uint64_t& now) const;
+
+    /**
+     * Returns how late iterations started compared to their planned start.
+     *
+     * @return lateness in microseconds
+     */
+    rsc::misc::Histogram getJitter() const;
+
 private:
+
+    void recordJitter(const boost::uint64_t& plannedStart);
+
+    /**
+     * Waits until the given time unless the task is canceled.
+     *
+     * @param deadline time in microseconds
+     * @return @c false if the task was canceled or interrupted
+     */
+    bool waitUntil(const boost::uint64_t& deadline);
+
     unsigned int cycleTime;
     rsc::logging::LoggerPtr logger;
     bool fixedScheduling;
-    boost::uint64_t nextProcessingStart;
+    OverrunPolicy overrunPolicy;
+    /**
+     * Planned start of the current iteration, 0 during the first one.
+     */
+    boost::uint64_t lastPlannedStart;
+
+    boost::mutex cancelMutex;
+    boost::condition cancelCondition;
+    boost::function<void()> cancelHandler;
+
+    mutable boost::mutex jitterMutex;
+    rsc::misc::Histogram jitter;
 };
 
 }
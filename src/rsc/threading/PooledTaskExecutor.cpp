@@ -0,0 +1,326 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "PooledTaskExecutor.h"
+
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/thread.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "../misc/langutils.h"
+#include "PeriodicTask.h"
+
+using namespace std;
+
+namespace rsc {
+namespace threading {
+
+/**
+ * Runs one iteration of a PeriodicTask and schedules the next one. Canceling
+ * and waiting is forwarded to the periodic task. An iteration waiting in the
+ * timer wheel is queued by #fire, either when it is due or when the periodic
+ * task is canceled, whichever happens first.
+ *
+ * @author jwienke
+ */
+class PooledTaskExecutor::PeriodicCycle: public Task,
+        public boost::enable_shared_from_this<PeriodicCycle> {
+public:
+
+    PeriodicCycle(PooledTaskExecutor* executor,
+            boost::shared_ptr<PeriodicTask> task,
+            const boost::uint64_t& plannedStart) :
+            executor(executor), task(task), plannedStart(plannedStart), fired(
+                    false) {
+    }
+
+    /**
+     * Queues this iteration for execution unless this already happened.
+     */
+    void fire() {
+        if (!fired.exchange(true)) {
+            executor->enqueue(shared_from_this());
+        }
+    }
+
+    /**
+     * Cancel handler of the periodic task. Only holds a weak reference so
+     * that the task does not keep old iterations alive.
+     */
+    static void wake(boost::weak_ptr<PeriodicCycle> cycle) {
+        boost::shared_ptr<PeriodicCycle> pending = cycle.lock();
+        if (pending) {
+            pending->fire();
+        }
+    }
+
+    void cancel() {
+        task->cancel();
+    }
+
+    bool isCancelRequested() {
+        return task->isCancelRequested();
+    }
+
+    void run() {
+        if (!task->runCycle(plannedStart)) {
+            return;
+        }
+        executor->schedulePeriodic(task,
+                task->nextStart(plannedStart, rsc::misc::currentTimeMicros()));
+    }
+
+    bool isDone() {
+        return task->isDone();
+    }
+
+    void waitDone() {
+        task->waitDone();
+    }
+
+private:
+
+    PooledTaskExecutor* executor;
+    boost::shared_ptr<PeriodicTask> task;
+    const boost::uint64_t plannedStart;
+    boost::atomic<bool> fired;
+
+};
+
+const boost::uint32_t PooledTaskExecutor::DEFAULT_KEEP_ALIVE = 60000;
+
+PooledTaskExecutor::PooledTaskExecutor(const unsigned int& numThreads) :
+        minThreads(numThreads), maxThreads(numThreads), keepAlive(
+                DEFAULT_KEEP_ALIVE), logger(
+                rsc::logging::Logger::getLogger(
+                        "rsc.threading.PooledTaskExecutor")), threads(0), idleThreads(
+                0), stopped(false), timerWheel(new TimerWheel) {
+    if (numThreads == 0) {
+        throw invalid_argument("Pool needs at least one thread");
+    }
+    boost::mutex::scoped_lock lock(mutex);
+    for (unsigned int i = 0; i < minThreads; ++i) {
+        startWorkerLocked();
+    }
+}
+
+PooledTaskExecutor::PooledTaskExecutor(const unsigned int& minThreads,
+        const unsigned int& maxThreads, const boost::uint32_t& keepAliveMs) :
+        minThreads(minThreads), maxThreads(maxThreads), keepAlive(
+                keepAliveMs), logger(
+                rsc::logging::Logger::getLogger(
+                        "rsc.threading.PooledTaskExecutor")), threads(0), idleThreads(
+                0), stopped(false), timerWheel(new TimerWheel) {
+    if (maxThreads == 0 || maxThreads < minThreads) {
+        throw invalid_argument(
+                "Pool needs 0 <= minThreads <= maxThreads and maxThreads > 0");
+    }
+    boost::mutex::scoped_lock lock(mutex);
+    for (unsigned int i = 0; i < minThreads; ++i) {
+        startWorkerLocked();
+    }
+}
+
+PooledTaskExecutor::~PooledTaskExecutor() {
+
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        stopped = true;
+        for (multiset<TaskPtr>::iterator it = running.begin(); it != running.end();
+                ++it) {
+            (*it)->cancel();
+        }
+    }
+    taskCondition.notify_all();
+
+    // delayed tasks are canceled and run by enqueue. Tasks still running
+    // cannot add new ones because schedule checks stopped.
+    timerWheel->expireAll();
+
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        while (threads > 0) {
+            exitCondition.wait(lock);
+        }
+    }
+
+    timerWheel.reset();
+
+}
+
+void PooledTaskExecutor::schedule(TaskPtr t) {
+    this->schedule(t, 0);
+}
+
+void PooledTaskExecutor::schedule(TaskPtr t, const boost::uint64_t& delayMus) {
+    if (t->isCancelRequested()) {
+        throw invalid_argument("Task already canceled.");
+    }
+    boost::shared_ptr<PeriodicTask> periodic = boost::dynamic_pointer_cast<
+            PeriodicTask>(t);
+    if (periodic) {
+        schedulePeriodic(periodic, rsc::misc::currentTimeMicros() + delayMus);
+    } else if (delayMus == 0) {
+        enqueue(t);
+    } else {
+        boost::mutex::scoped_lock lock(mutex);
+        if (stopped) {
+            // the timer wheel is going away, enqueue cancels the task
+            lock.unlock();
+            enqueue(t);
+            return;
+        }
+        timerWheel->schedule(
+                boost::bind(&PooledTaskExecutor::enqueue, this, t), delayMus);
+    }
+}
+
+unsigned int PooledTaskExecutor::getThreadCount() const {
+    boost::mutex::scoped_lock lock(mutex);
+    return threads;
+}
+
+size_t PooledTaskExecutor::getPendingCount() const {
+    size_t delayed = timerWheel->getPendingCount();
+    boost::mutex::scoped_lock lock(mutex);
+    return tasks.size() + delayed;
+}
+
+void PooledTaskExecutor::enqueue(TaskPtr task) {
+
+    boost::mutex::scoped_lock lock(mutex);
+    if (stopped) {
+        // a delayed task expired during shutdown
+        lock.unlock();
+        task->cancel();
+        task->run();
+        return;
+    }
+
+    tasks.push_back(task);
+    if (idleThreads < tasks.size() && threads < maxThreads) {
+        startWorkerLocked();
+    }
+    if (idleThreads > 0) {
+        taskCondition.notify_one();
+    }
+
+}
+
+void PooledTaskExecutor::schedulePeriodic(
+        boost::shared_ptr<PeriodicTask> task,
+        const boost::uint64_t& plannedStart) {
+
+    boost::shared_ptr<PeriodicCycle> cycle(
+            new PeriodicCycle(this, task, plannedStart));
+    const boost::uint64_t now = rsc::misc::currentTimeMicros();
+    if (plannedStart <= now) {
+        cycle->fire();
+        return;
+    }
+
+    // installed before the cycle can expire so that the handler of a
+    // previous cycle cannot replace it. Must not be called with the mutex
+    // held since canceled tasks call the handler immediately.
+    task->setCancelHandler(
+            boost::bind(&PeriodicCycle::wake,
+                    boost::weak_ptr<PeriodicCycle>(cycle)));
+
+    boost::mutex::scoped_lock lock(mutex);
+    if (stopped) {
+        // the timer wheel is going away, enqueue cancels the task
+        lock.unlock();
+        cycle->fire();
+        return;
+    }
+    timerWheel->schedule(boost::bind(&PeriodicCycle::fire, cycle),
+            plannedStart - now);
+
+}
+
+void PooledTaskExecutor::startWorkerLocked() {
+    boost::thread worker(boost::bind(&PooledTaskExecutor::worker, this));
+    // workers are only waited for through the thread count
+    worker.detach();
+    ++threads;
+}
+
+void PooledTaskExecutor::worker() {
+
+    boost::mutex::scoped_lock lock(mutex);
+    while (true) {
+
+        while (tasks.empty() && !stopped) {
+            ++idleThreads;
+            bool timedOut = false;
+            if (threads > minThreads) {
+                timedOut = !taskCondition.timed_wait(lock,
+                        boost::get_system_time()
+                                + boost::posix_time::milliseconds(keepAlive));
+            } else {
+                taskCondition.wait(lock);
+            }
+            --idleThreads;
+            if (timedOut && tasks.empty() && threads > minThreads) {
+                break;
+            }
+        }
+        if (tasks.empty()) {
+            break;
+        }
+
+        TaskPtr task = tasks.front();
+        tasks.pop_front();
+        if (stopped) {
+            task->cancel();
+        }
+        running.insert(task);
+        lock.unlock();
+
+        try {
+            task->run();
+        } catch (const std::exception& e) {
+            RSCERROR(logger, "Task threw an exception: " << e.what());
+        } catch (...) {
+            RSCERROR(logger, "Task threw an unknown exception");
+        }
+
+        lock.lock();
+        running.erase(running.find(task));
+
+    }
+
+    --threads;
+    exitCondition.notify_all();
+
+}
+
+}
+}
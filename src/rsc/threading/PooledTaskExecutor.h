@@ -0,0 +1,175 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <deque>
+#include <set>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "../logging/Logger.h"
+#include "TaskExecutor.h"
+#include "TimerWheel.h"
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace threading {
+
+class PeriodicTask;
+
+/**
+ * A TaskExecutor which runs tasks on a pool of reused threads instead of
+ * creating a thread per task like ThreadedTaskExecutor. Delayed tasks wait in
+ * a TimerWheel shared by all tasks of the executor and do not occupy a worker
+ * thread until they are due.
+ *
+ * The pool either has a fixed size or is elastic. An elastic pool starts
+ * additional workers up to its maximum size if tasks are waiting and no
+ * worker is idle. Workers above the minimum size exit after being idle for
+ * the keep-alive time. Tasks which run for a long time, like
+ * RepetitiveTask instances, occupy a worker until they are done. With a fixed
+ * size, further tasks wait until a worker becomes free.
+ *
+ * PeriodicTask instances are an exception. Instead of calling
+ * PeriodicTask::run, which sleeps between iterations, each iteration is
+ * scheduled on the TimerWheel and executed with PeriodicTask::runCycle. Hence,
+ * many periodic tasks can share a few workers. Fixed-rate and fixed-delay
+ * scheduling work like in PeriodicTask::continueExec, but overriding
+ * PeriodicTask::continueExec has no effect. The lateness of each iteration
+ * is available through PeriodicTask::getJitter.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT PooledTaskExecutor: public TaskExecutor,
+        private boost::noncopyable {
+public:
+
+    /**
+     * Default time in milliseconds after which idle workers above the
+     * minimum pool size exit.
+     */
+    static const boost::uint32_t DEFAULT_KEEP_ALIVE;
+
+    /**
+     * Creates an executor with a fixed number of workers.
+     *
+     * @param numThreads number of workers
+     * @throw std::invalid_argument if @a numThreads is 0
+     */
+    explicit PooledTaskExecutor(const unsigned int& numThreads);
+
+    /**
+     * Creates an elastic executor.
+     *
+     * @param minThreads number of workers which are always available
+     * @param maxThreads maximum number of workers
+     * @param keepAliveMs time in milliseconds after which idle workers above
+     *                    @a minThreads exit
+     * @throw std::invalid_argument if @a maxThreads is 0 or less than
+     *                              @a minThreads
+     */
+    PooledTaskExecutor(const unsigned int& minThreads,
+            const unsigned int& maxThreads, const boost::uint32_t& keepAliveMs =
+                    DEFAULT_KEEP_ALIVE);
+
+    /**
+     * Cancels all tasks which are pending or running and waits until the
+     * workers finished them. Pending tasks are still run after being
+     * canceled, so that threads waiting for them are woken up.
+     */
+    virtual ~PooledTaskExecutor();
+
+    void schedule(TaskPtr t);
+    void schedule(TaskPtr t, const boost::uint64_t& delayMus);
+
+    /**
+     * Returns the current number of workers.
+     *
+     * @return number of workers
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * Returns the number of scheduled tasks which have not started yet,
+     * including delayed ones.
+     *
+     * @return number of pending tasks
+     */
+    std::size_t getPendingCount() const;
+
+private:
+
+    class PeriodicCycle;
+
+    /**
+     * Hands @a task to the workers.
+     */
+    void enqueue(TaskPtr task);
+
+    /**
+     * Schedules the next iteration of a periodic task.
+     *
+     * @param task task to run
+     * @param plannedStart time in microseconds at which the iteration should
+     *                     start
+     */
+    void schedulePeriodic(boost::shared_ptr<PeriodicTask> task,
+            const boost::uint64_t& plannedStart);
+
+    /**
+     * Starts a new worker. Acquire #mutex before calling this method.
+     */
+    void startWorkerLocked();
+
+    void worker();
+
+    const unsigned int minThreads;
+    const unsigned int maxThreads;
+    const boost::uint32_t keepAlive;
+
+    rsc::logging::LoggerPtr logger;
+
+    mutable boost::mutex mutex;
+    boost::condition taskCondition;
+    boost::condition exitCondition;
+
+    std::deque<TaskPtr> tasks;
+    std::multiset<TaskPtr> running;
+    unsigned int threads;
+    unsigned int idleThreads;
+    bool stopped;
+
+    boost::scoped_ptr<TimerWheel> timerWheel;
+
+};
+
+}
+}
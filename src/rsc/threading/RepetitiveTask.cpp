@@ -26,6 +26,8 @@
 
 #include "RepetitiveTask.h"
 
+#include "../misc/langutils.h"
+
 using namespace std;
 
 namespace rsc {
@@ -33,7 +35,8 @@ namespace threading {
 
 RepetitiveTask::RepetitiveTask() :
         cancelRequest(false), done(false), logger(
-                rsc::logging::Logger::getLogger("rsc.threading.RepetitiveTask")) {
+                rsc::logging::Logger::getLogger("rsc.threading.RepetitiveTask")), cycleStart(
+                0) {
 }
 
 RepetitiveTask::~RepetitiveTask() {
@@ -109,13 +112,24 @@ bool RepetitiveTask::isDone() {
     return done;
 }
 
+CycleStatistics RepetitiveTask::getCycleStatistics() const {
+    return cycleStatistics.snapshot();
+}
+
+void RepetitiveTask::setCycleBudget(const boost::uint64_t& budgetMus) {
+    cycleStatistics.setBudget(budgetMus);
+}
+
 void RepetitiveTask::timerBeforeCycle() {
-    timer.restart();
+    cycleStart = rsc::misc::currentTimeMicros();
 }
 
 void RepetitiveTask::timerAfterCycle() {
-    // calculate processing time for last cycle, last n cycle, variance...
-    RSCTRACE(logger, "Times (last cycle = " << timer.elapsed() << "s)");
+    const boost::uint64_t now = rsc::misc::currentTimeMicros();
+    // the wall clock may have been adjusted in between
+    const boost::uint64_t duration = now > cycleStart ? now - cycleStart : 0;
+    cycleStatistics.record(duration);
+    RSCTRACE(logger, "Times (last cycle = " << duration << "us)");
 }
 
 ostream& operator<<(ostream& out, const RepetitiveTask& t) {
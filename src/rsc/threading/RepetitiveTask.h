@@ -31,9 +31,10 @@
 
 #include <boost/function.hpp>
 #include <boost/thread.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/thread/condition.hpp>
-#include <boost/timer.hpp>
 
+#include "CycleStatistics.h"
 #include "Task.h"
 
 namespace rsc {
@@ -53,6 +54,9 @@ namespace threading {
  * A default flag mechanism to cancel a task is provided and incorporated into
  * #continueExec.
  *
+ * The wall clock time between #pre and #post is recorded for each iteration
+ * and can be queried with #getCycleStatistics while the task runs.
+ *
  * @author swrede
  * @author jwienke
  */
@@ -65,8 +69,8 @@ public:
 
     /**
      * A method called before each iteration of the task. The default
-     * implementation starts a timer for performance measurements. Override this
-     * for comparable tasks.
+     * implementation starts the cycle time measurement. Call it when
+     * overriding to keep the cycle statistics.
      */
     virtual void pre();
 
@@ -76,8 +80,9 @@ public:
     virtual void execute() = 0;
 
     /**
-     * A method called after each iteration of the task. The default methods
-     * logs timing information. Use it for comparable tasks only.
+     * A method called after each iteration of the task. The default
+     * implementation records the cycle time in the cycle statistics. Call it
+     * when overriding to keep the cycle statistics.
      */
     virtual void post();
 
@@ -116,17 +121,36 @@ public:
     virtual void waitDone();
     virtual bool isDone();
 
+    /**
+     * Returns a snapshot of the durations of the iterations completed so far.
+     * Can be called from any thread without disturbing the task.
+     *
+     * @return cycle statistics
+     */
+    CycleStatistics getCycleStatistics() const;
+
     friend std::ostream& operator<<(std::ostream& out, const RepetitiveTask& t);
 
 protected:
 
+    /**
+     * Marks the task as done and wakes up threads in #waitDone.
+     */
+    void markDone();
+
+    /**
+     * Sets the duration above which iterations are counted as overruns in the
+     * cycle statistics.
+     *
+     * @param budgetMus budget in microseconds, 0 to not count overruns
+     */
+    void setCycleBudget(const boost::uint64_t& budgetMus);
+
     mutable boost::recursive_mutex doneMutex;
     boost::condition doneCondition;
 
 private:
 
-    void markDone();
-
     void timerBeforeCycle();
 
     void timerAfterCycle();
@@ -135,8 +159,8 @@ private:
     volatile bool done;
 
     rsc::logging::LoggerPtr logger;
-    // TODO boost::timer measures cpu time, not really used time
-    boost::timer timer;
+    boost::uint64_t cycleStart;
+    CycleStatisticsRecorder cycleStatistics;
 
 };
 
@@ -0,0 +1,406 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/format.hpp>
+#include <boost/function.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "InterruptedException.h"
+#include "SynchronizedQueue.h"
+
+namespace rsc {
+namespace threading {
+
+/**
+ * A bounded multi-producer multi-consumer queue with the same interface as
+ * SynchronizedQueue but backed by a ring buffer with per-slot sequence
+ * counters. Producers and consumers do not acquire a lock as long as the
+ * queue is neither empty nor exhausted. Only consumers waiting on an empty
+ * queue park on a condition variable, and producers only touch the
+ * corresponding mutex if someone is actually waiting.
+ *
+ * The capacity of the queue is always rounded up to the next power of two
+ * and is at least two, because the per-slot sequence counters cannot
+ * distinguish a full slot from an empty one with a single slot.
+ * If the queue is full, #push removes the oldest element and passes it to the
+ * drop handler, which mirrors the size limit semantics of SynchronizedQueue.
+ *
+ * The element type needs to be default-constructible and assignable. Each
+ * slot of the ring buffer is reset to a default-constructed element after
+ * popping so that resources held by elements are released in time.
+ *
+ * @author jwienke
+ * @tparam M message type handled in this queue
+ */
+template<class M>
+class RingBufferQueue: public boost::noncopyable {
+public:
+
+    typedef boost::function<void(const M& drop)> dropHandlerType;
+
+private:
+
+    static const std::size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        boost::atomic<std::size_t> sequence;
+        M data;
+    };
+
+    /**
+     * Keeps track of the number of parked consumers in an exception-safe
+     * manner.
+     */
+    class WaitingGuard {
+    public:
+        explicit WaitingGuard(boost::atomic<unsigned int>& waiting) :
+                waiting(waiting) {
+            this->waiting.fetch_add(1);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        }
+        ~WaitingGuard() {
+            this->waiting.fetch_sub(1);
+        }
+    private:
+        boost::atomic<unsigned int>& waiting;
+    };
+
+    const std::size_t mask;
+    boost::scoped_array<Cell> buffer;
+
+    char padding0[CACHE_LINE_SIZE];
+    boost::atomic<std::size_t> enqueuePos;
+    char padding1[CACHE_LINE_SIZE];
+    boost::atomic<std::size_t> dequeuePos;
+    char padding2[CACHE_LINE_SIZE];
+
+    boost::atomic<bool> interrupted;
+    boost::atomic<unsigned int> waiting;
+    boost::mutex mutex;
+    boost::condition condition;
+
+    dropHandlerType dropHandler;
+
+    static std::size_t roundCapacity(const std::size_t& capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument(
+                    "A RingBufferQueue requires a capacity of at least one element.");
+        }
+        std::size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    bool tryEnqueue(const M& message) {
+        Cell* cell;
+        std::size_t pos = this->enqueuePos.load(boost::memory_order_relaxed);
+        while (true) {
+            cell = &this->buffer[pos & this->mask];
+            const std::size_t sequence = cell->sequence.load(
+                    boost::memory_order_acquire);
+            const std::ptrdiff_t diff = (std::ptrdiff_t) sequence
+                    - (std::ptrdiff_t) pos;
+            if (diff == 0) {
+                if (this->enqueuePos.compare_exchange_weak(pos, pos + 1,
+                        boost::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->enqueuePos.load(boost::memory_order_relaxed);
+            }
+        }
+        cell->data = message;
+        cell->sequence.store(pos + 1, boost::memory_order_release);
+        return true;
+    }
+
+    bool tryDequeue(M& message) {
+        Cell* cell;
+        std::size_t pos = this->dequeuePos.load(boost::memory_order_relaxed);
+        while (true) {
+            cell = &this->buffer[pos & this->mask];
+            const std::size_t sequence = cell->sequence.load(
+                    boost::memory_order_acquire);
+            const std::ptrdiff_t diff = (std::ptrdiff_t) sequence
+                    - (std::ptrdiff_t) (pos + 1);
+            if (diff == 0) {
+                if (this->dequeuePos.compare_exchange_weak(pos, pos + 1,
+                        boost::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->dequeuePos.load(boost::memory_order_relaxed);
+            }
+        }
+        message = boost::move(cell->data);
+        cell->data = M();
+        cell->sequence.store(pos + this->mask + 1,
+                boost::memory_order_release);
+        return true;
+    }
+
+    void wakeUpConsumer() {
+        // pairs with the fence in WaitingGuard so that either the consumer
+        // sees the new element or we see the consumer waiting
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (this->waiting.load(boost::memory_order_relaxed) > 0) {
+            {
+                boost::mutex::scoped_lock lock(this->mutex);
+            }
+            this->condition.notify_one();
+        }
+    }
+
+public:
+
+    /**
+     * Creates a new queue.
+     *
+     * @param capacity number of elements the queue can hold at once. Will be
+     *                 rounded up to the next power of two, but at least 2.
+     *                 If the capacity is exhausted and another element is
+     *                 added to the queue, the oldest element is removed.
+     * @param dropHandler called with each element that is removed from the
+     *                    queue because the capacity was exhausted
+     * @throw std::invalid_argument capacity is 0
+     */
+    explicit RingBufferQueue(const std::size_t& capacity,
+            dropHandlerType dropHandler = 0) :
+            mask(roundCapacity(capacity) - 1), buffer(new Cell[mask + 1]), enqueuePos(
+                    0), dequeuePos(0), interrupted(false), waiting(0), dropHandler(
+                    dropHandler) {
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            this->buffer[i].sequence.store(i, boost::memory_order_relaxed);
+        }
+    }
+
+    virtual ~RingBufferQueue() {
+    }
+
+    /**
+     * Pushes a new element on the queue and wakes up one waiting client if
+     * there is one.
+     *
+     * @param message element to push on the queue
+     */
+    void push(const M& message) {
+        while (!tryEnqueue(message)) {
+            // enqueueing also fails while a consumer has claimed the oldest
+            // element but not yet released its slot. Only drop if the queue
+            // is really full. Read dequeuePos first so that the difference
+            // cannot underflow.
+            const std::size_t dequeued = this->dequeuePos.load(
+                    boost::memory_order_acquire);
+            const std::size_t enqueued = this->enqueuePos.load(
+                    boost::memory_order_acquire);
+            M dropped;
+            if (enqueued - dequeued >= capacity() && tryDequeue(dropped)) {
+                if (this->dropHandler) {
+                    this->dropHandler(dropped);
+                }
+            } else {
+                boost::this_thread::yield();
+            }
+        }
+        wakeUpConsumer();
+    }
+
+    /**
+     * Pushes a new element on the queue unless the capacity is exhausted.
+     * Never removes elements and never blocks.
+     *
+     * @param message element to push on the queue
+     * @return @c true if the element was pushed, @c false if the queue was
+     *         full
+     */
+    bool tryPush(const M& message) {
+        if (!tryEnqueue(message)) {
+            return false;
+        }
+        wakeUpConsumer();
+        return true;
+    }
+
+    /**
+     * Returns the next element form the queue and wait until there is such an
+     * element. The returned element is removed from the queue immediately.
+     *
+     * @param timeoutMs maximum time spent waiting for a new element in
+     *                  milliseconds. Zero indicates to wait endlessly.
+     *                  Use #tryPop if you want to get a result without waiting
+     * @return next element on the queue
+     * @throw InterruptedException if #interrupt was called before a call to
+     *                             this method or while waiting for an element
+     * @throw QueueEmptyException thrown if @param timeoutMs was > 0 and no
+     *                            element was found on the queue in the
+     *                            specified time
+     */
+    M pop(const boost::uint32_t& timeoutMs = 0) {
+
+        if (this->interrupted.load(boost::memory_order_acquire)) {
+            throw InterruptedException("Queue was interrupted");
+        }
+
+        M message;
+        if (tryDequeue(message)) {
+            return message;
+        }
+
+        const boost::system_time deadline = boost::get_system_time()
+                + boost::posix_time::milliseconds(timeoutMs);
+
+        boost::mutex::scoped_lock lock(this->mutex);
+        WaitingGuard guard(this->waiting);
+        while (true) {
+            if (this->interrupted.load(boost::memory_order_acquire)) {
+                throw InterruptedException("Queue was interrupted");
+            }
+            if (tryDequeue(message)) {
+                return message;
+            }
+            if (timeoutMs == 0) {
+                this->condition.wait(lock);
+            } else if (!this->condition.timed_wait(lock, deadline)) {
+                if (tryDequeue(message)) {
+                    return message;
+                }
+                throw QueueEmptyException(boost::str(boost::format("No element available on queue within %d ms.") % timeoutMs));
+            }
+        }
+
+    }
+
+    /**
+     * Tries to pop an element from the queue but does not wait if there is no
+     * element on the queue.
+     *
+     * @return element from the queue
+     * @throw QueueEmptyException the queue was empty
+     */
+    M tryPop() {
+        M message;
+        if (!tryDequeue(message)) {
+            throw QueueEmptyException();
+        }
+        return message;
+    }
+
+    /**
+     * Tries to pop an element from the queue without waiting and without
+     * throwing an exception if there is none, e.g. to drain the queue in
+     * batches.
+     *
+     * @param message receives the element from the queue
+     * @return @c true if an element was popped, @c false if the queue was
+     *         empty
+     */
+    bool tryPop(M& message) {
+        return tryDequeue(message);
+    }
+
+    /**
+     * Checks whether this queue is empty. Is not affected by the interruption
+     * flag. With concurrent producers or consumers the result is only a
+     * snapshot.
+     *
+     * @return @c true if empty, else @c false
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * Return element count of the queue. With concurrent producers or
+     * consumers the result is only a snapshot.
+     *
+     * @return The number of elements currently stored in the queue.
+     */
+    std::size_t size() const {
+        const std::size_t dequeued = this->dequeuePos.load(
+                boost::memory_order_acquire);
+        const std::size_t enqueued = this->enqueuePos.load(
+                boost::memory_order_acquire);
+        if (enqueued <= dequeued) {
+            return 0;
+        }
+        return std::min(enqueued - dequeued, this->mask + 1);
+    }
+
+    /**
+     * Returns the number of elements this queue can hold before dropping the
+     * oldest ones.
+     *
+     * @return capacity after rounding to a power of two
+     */
+    std::size_t capacity() const {
+        return this->mask + 1;
+    }
+
+    /**
+     * Remove all elements from the queue.
+     */
+    void clear() {
+        M message;
+        while (tryDequeue(message)) {
+        }
+    }
+
+    /**
+     * Interrupts the processing on this queue for every current call
+     * to pop and any later call. All of them will return with an
+     * exception.
+     */
+    void interrupt() {
+        this->interrupted.store(true, boost::memory_order_release);
+        {
+            boost::mutex::scoped_lock lock(this->mutex);
+        }
+        this->condition.notify_all();
+    }
+
+};
+
+}
+}
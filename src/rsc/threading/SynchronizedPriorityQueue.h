@@ -0,0 +1,418 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <functional>
+#include <set>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/format.hpp>
+#include <boost/function.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "../misc/langutils.h"
+#include "InterruptedException.h"
+#include "SynchronizedQueue.h"
+#include "WaitStrategy.h"
+
+namespace rsc {
+namespace threading {
+
+/**
+ * A synchronized queue which returns elements in the order of their priority
+ * instead of their arrival. Elements with the same priority are returned in
+ * FIFO order. The priority of an element is determined by a user-supplied
+ * extractor function or passed explicitly on #push. Interruption, timeouts
+ * and waiting follow the semantics of SynchronizedQueue.
+ *
+ * If the size limit is reached, the element with the lowest priority is
+ * removed and passed to the drop handler instead of the oldest one. This may
+ * also be the element that was just pushed. Among several elements with the
+ * lowest priority the oldest one is removed.
+ *
+ * The element type needs to be default-constructible.
+ *
+ * @author jwienke
+ * @tparam M message type handled in this queue
+ * @tparam Priority type of the priority key
+ * @tparam Compare strict weak ordering on @a Priority. As for
+ *                 std::priority_queue, an element @c a has a lower priority
+ *                 than @c b if @c Compare()(a,b) holds. Hence, the default
+ *                 returns the largest priority first.
+ * @tparam WaitStrategy policy used to wait for new elements
+ */
+template<class M, class Priority = int, class Compare = std::less<Priority>,
+        class WaitStrategy = BlockingWaitStrategy>
+class SynchronizedPriorityQueue: public boost::noncopyable {
+public:
+
+    typedef boost::function<void(const M& drop)> dropHandlerType;
+    typedef boost::function<Priority(const M& message)> priorityExtractorType;
+
+private:
+
+    struct Entry {
+        Entry(const Priority& priority, const boost::uint64_t& sequence) :
+                priority(priority), sequence(sequence), message() {
+        }
+        Entry(const Priority& priority, const boost::uint64_t& sequence,
+                const M& message) :
+                priority(priority), sequence(sequence), message(message) {
+        }
+        Priority priority;
+        boost::uint64_t sequence;
+        // set elements are immutable but we want to move messages out
+        mutable M message;
+    };
+
+    /**
+     * Orders entries from the highest to the lowest priority and by arrival
+     * within the same priority.
+     */
+    class EntryCompare {
+    public:
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (compare(b.priority, a.priority)) {
+                return true;
+            }
+            if (compare(a.priority, b.priority)) {
+                return false;
+            }
+            return a.sequence < b.sequence;
+        }
+    private:
+        Compare compare;
+    };
+
+    typedef std::multiset<Entry, EntryCompare> EntrySet;
+
+    class ElementAvailable {
+    public:
+        explicit ElementAvailable(const SynchronizedPriorityQueue* queue) :
+                queue(queue) {
+        }
+        bool operator()() const {
+            return queue->interrupted.load(boost::memory_order_acquire)
+                    || queue->elementCount.load(boost::memory_order_acquire)
+                            > 0;
+        }
+    private:
+        const SynchronizedPriorityQueue* queue;
+    };
+
+    boost::atomic<bool> interrupted;
+    EntrySet entries;
+    boost::uint64_t nextSequence;
+    boost::atomic<std::size_t> elementCount;
+    mutable boost::mutex mutex;
+    boost::condition_variable condition;
+    unsigned int sizeLimit;
+    dropHandlerType dropHandler;
+    priorityExtractorType priorityExtractor;
+
+    void updateCountLocked() {
+        this->elementCount.store(this->entries.size(),
+                boost::memory_order_release);
+    }
+
+    /**
+     * Inserts a new entry and evicts the lowest priority entries if the size
+     * limit is exceeded. Acquire the lock before calling this method.
+     */
+    void pushLocked(const M& message, const Priority& priority) {
+        this->entries.insert(
+                Entry(priority, this->nextSequence++, message));
+        if (this->sizeLimit > 0) {
+            while (this->entries.size() > this->sizeLimit) {
+                typename EntrySet::iterator last = this->entries.end();
+                --last;
+                // oldest entry among the ones with the lowest priority
+                typename EntrySet::iterator lowest = this->entries.lower_bound(
+                        Entry(last->priority, 0));
+                if (this->dropHandler) {
+                    this->dropHandler(lowest->message);
+                }
+                this->entries.erase(lowest);
+            }
+        }
+        updateCountLocked();
+    }
+
+    void waitForElement(boost::mutex::scoped_lock& lock,
+            const boost::uint32_t& timeoutMs) {
+
+        bool available;
+        if (timeoutMs == 0) {
+            available = WaitStrategy::wait(lock, this->condition,
+                    ElementAvailable(this), 0);
+        } else {
+            const boost::system_time deadline = boost::get_system_time()
+                    + boost::posix_time::milliseconds(timeoutMs);
+            available = WaitStrategy::wait(lock, this->condition,
+                    ElementAvailable(this), &deadline);
+        }
+
+        if (this->interrupted.load(boost::memory_order_acquire)) {
+            throw InterruptedException("Queue was interrupted");
+        }
+        if (!available) {
+            throw QueueEmptyException(boost::str(boost::format("No element available on queue within %d ms.") % timeoutMs));
+        }
+
+    }
+
+    M popLocked() {
+        typename EntrySet::iterator first = this->entries.begin();
+        M message = boost::move(first->message);
+        this->entries.erase(first);
+        updateCountLocked();
+        return message;
+    }
+
+public:
+
+    /**
+     * Creates a new queue.
+     *
+     * @param priorityExtractor function returning the priority of a message
+     *                          passed to #push without explicit priority.
+     *                          May be empty if priorities are always passed
+     *                          explicitly.
+     * @param sizeLimit max allowed size of the queue. If the limit is reached
+     *                  and another element is added to the queue, the
+     *                  element with the lowest priority is removed. 0 means
+     *                  unlimited
+     * @param dropHandler called with each element removed because of the
+     *                    size limit
+     */
+    explicit SynchronizedPriorityQueue(
+            priorityExtractorType priorityExtractor = 0,
+            const unsigned int& sizeLimit = 0,
+            dropHandlerType dropHandler = 0) :
+            interrupted(false), nextSequence(0), elementCount(0), sizeLimit(
+                    sizeLimit), dropHandler(dropHandler), priorityExtractor(
+                    priorityExtractor) {
+    }
+
+    virtual ~SynchronizedPriorityQueue() {
+    }
+
+    /**
+     * Pushes a new element with the priority returned by the extractor
+     * function and wakes up one waiting client if there is one.
+     *
+     * @param message element to push on the queue
+     * @throw std::logic_error no priority extractor was specified
+     */
+    void push(const M& message) {
+        if (!this->priorityExtractor) {
+            throw std::logic_error(
+                    "No priority extractor specified for the queue.");
+        }
+        push(message, this->priorityExtractor(message));
+    }
+
+    /**
+     * Pushes a new element with an explicit priority and wakes up one waiting
+     * client if there is one.
+     *
+     * @param message element to push on the queue
+     * @param priority priority of the element
+     */
+    void push(const M& message, const Priority& priority) {
+        {
+            boost::mutex::scoped_lock lock(this->mutex);
+            pushLocked(message, priority);
+        }
+        WaitStrategy::notifyOne(this->condition);
+    }
+
+    /**
+     * Returns the element with the highest priority without removing it,
+     * waiting until there is such an element if necessary.
+     *
+     * @param timeoutMs maximum time spent waiting for a new element
+     *                  in milliseconds. Zero indicates to wait
+     *                  endlessly.
+     * @return element with the highest priority
+     * @throw InterruptedException if #interrupt was called before a call to
+     *                             this method or while waiting for an element
+     * @throw QueueEmptyException thrown if @param timeoutMs was > 0
+     *                            and no element was found on the
+     *                            queue in the specified time
+     */
+    M peek(const boost::uint32_t& timeoutMs = 0) {
+        boost::mutex::scoped_lock lock(this->mutex);
+        waitForElement(lock, timeoutMs);
+        return this->entries.begin()->message;
+    }
+
+    /**
+     * Removes and returns the element with the highest priority and waits
+     * until there is such an element.
+     *
+     * @param timeoutMs maximum time spent waiting for a new element in
+     *                  milliseconds. Zero indicates to wait endlessly.
+     *                  Use #tryPop if you want to get a result without waiting
+     * @return element with the highest priority
+     * @throw InterruptedException if #interrupt was called before a call to
+     *                             this method or while waiting for an element
+     * @throw QueueEmptyException thrown if @param timeoutMs was > 0 and no
+     *                            element was found on the queue in the
+     *                            specified time
+     */
+    M pop(const boost::uint32_t& timeoutMs = 0) {
+        boost::mutex::scoped_lock lock(this->mutex);
+        waitForElement(lock, timeoutMs);
+        return popLocked();
+    }
+
+    /**
+     * Tries to pop the element with the highest priority but does not wait if
+     * there is no element on the queue.
+     *
+     * @return element from the queue
+     * @throw QueueEmptyException the queue was empty
+     */
+    M tryPop() {
+        boost::mutex::scoped_lock lock(this->mutex);
+        if (this->entries.empty()) {
+            throw QueueEmptyException();
+        }
+        return popLocked();
+    }
+
+    /**
+     * Checks whether this queue is empty. Is not affected by the interruption
+     * flag and does not acquire the lock.
+     *
+     * @return @c true if empty, else @c false
+     */
+    bool empty() const {
+        return this->elementCount.load(boost::memory_order_acquire) == 0;
+    }
+
+    /**
+     * Return element count of the queue. Does not acquire the lock.
+     *
+     * @return The number of elements currently stored in the queue.
+     */
+    std::size_t size() const {
+        return this->elementCount.load(boost::memory_order_acquire);
+    }
+
+    /**
+     * Remove all elements from the queue.
+     */
+    void clear() {
+        boost::mutex::scoped_lock lock(this->mutex);
+        this->entries.clear();
+        updateCountLocked();
+    }
+
+    /**
+     * Interrupts the processing on this queue for every current call
+     * to pop and any later call. All of them will return with an
+     * exception.
+     */
+    void interrupt() {
+        {
+            boost::mutex::scoped_lock lock(this->mutex);
+            this->interrupted.store(true, boost::memory_order_release);
+        }
+        WaitStrategy::notifyAll(this->condition);
+    }
+
+};
+
+/**
+ * A SynchronizedPriorityQueue which returns elements in the order of their
+ * deadlines, earliest deadline first. Deadlines are absolute timestamps in
+ * microseconds as returned by rsc::misc::currentTimeMicros. Elements pushed
+ * without a deadline and without a deadline extractor get the current time
+ * as deadline. When the size limit is reached, the element with the latest
+ * deadline is dropped.
+ *
+ * @author jwienke
+ * @tparam M message type handled in this queue
+ * @tparam WaitStrategy policy used to wait for new elements
+ */
+template<class M, class WaitStrategy = BlockingWaitStrategy>
+class DeadlineSynchronizedQueue: public SynchronizedPriorityQueue<M,
+        boost::uint64_t, std::greater<boost::uint64_t>, WaitStrategy> {
+public:
+
+    typedef SynchronizedPriorityQueue<M, boost::uint64_t,
+            std::greater<boost::uint64_t>, WaitStrategy> BaseType;
+
+    /**
+     * Creates a new queue.
+     *
+     * @param deadlineExtractor function returning the absolute deadline of a
+     *                          message in microseconds. If empty, the time of
+     *                          pushing is used.
+     * @param sizeLimit max allowed size of the queue. 0 means unlimited
+     * @param dropHandler called with each element removed because of the
+     *                    size limit
+     */
+    explicit DeadlineSynchronizedQueue(
+            typename BaseType::priorityExtractorType deadlineExtractor = 0,
+            const unsigned int& sizeLimit = 0,
+            typename BaseType::dropHandlerType dropHandler = 0) :
+            BaseType(
+                    deadlineExtractor ?
+                            deadlineExtractor :
+                            typename BaseType::priorityExtractorType(
+                                    &DeadlineSynchronizedQueue::now),
+                    sizeLimit, dropHandler) {
+    }
+
+    /**
+     * Pushes an element which has to be processed within @a relativeMicros
+     * from now.
+     *
+     * @param message element to push on the queue
+     * @param relativeMicros time span in microseconds from now on
+     */
+    void pushWithin(const M& message, const boost::uint64_t& relativeMicros) {
+        this->push(message, rsc::misc::currentTimeMicros() + relativeMicros);
+    }
+
+private:
+
+    static boost::uint64_t now(const M& /*message*/) {
+        return rsc::misc::currentTimeMicros();
+    }
+
+};
+
+}
+}
@@ -28,13 +28,19 @@
 
 #include <queue>
 
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
 #include <boost/format.hpp>
 #include <boost/function.hpp>
+#include <boost/move/utility.hpp>
 #include <boost/noncopyable.hpp>
-#include <boost/thread/condition.hpp>
-#include <boost/thread/recursive_mutex.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include "InterruptedException.h"
+#include "WaitStrategy.h"
 #include "rsc/rscexports.h"
 
 namespace rsc {
@@ -55,10 +61,22 @@ public:
  * A queue with synchronized access and interruption support. On #push
  * operations only one waiting thread is woken up.
  *
+ * Elements are moved out of the queue when popping them. With a C++11
+ * compiler elements can also be moved into the queue or constructed in place
+ * using #emplace, which allows move-only element types as long as the
+ * copying operations #peek and #pushAll are not used.
+ *
+ * Access is guarded by a non-recursive mutex. Hence, the drop handler must
+ * not call methods of the queue it is registered at. #empty and #size do not
+ * acquire the lock at all. How consumers wait for new elements is decided by
+ * the @a WaitStrategy policy, see BlockingWaitStrategy,
+ * SpinThenBlockWaitStrategy and BusyPollWaitStrategy.
+ *
  * @author jwienke
  * @tparam M message type handled in this queue
+ * @tparam WaitStrategy policy used to wait for new elements
  */
-template<class M>
+template<class M, class WaitStrategy = BlockingWaitStrategy>
 class SynchronizedQueue: public boost::noncopyable {
 public:
 
@@ -66,13 +84,121 @@ public:
 
 private:
 
-    volatile bool interrupted;
+    boost::atomic<bool> interrupted;
     std::queue<M> queue;
-    mutable boost::recursive_mutex mutex;
-    boost::condition condition;
+    /**
+     * Mirrors the size of #queue so that it can be read without locking.
+     * Only changed while holding the lock.
+     */
+    boost::atomic<std::size_t> elementCount;
+    mutable boost::mutex mutex;
+    boost::condition_variable condition;
     unsigned int sizeLimit;
     dropHandlerType dropHandler;
 
+    /**
+     * Predicate for the WaitStrategy which can be evaluated without holding
+     * the lock.
+     */
+    class ElementAvailable {
+    public:
+        explicit ElementAvailable(const SynchronizedQueue* queue) :
+                queue(queue) {
+        }
+        bool operator()() const {
+            return queue->interrupted.load(boost::memory_order_acquire)
+                    || queue->elementCount.load(boost::memory_order_acquire)
+                            > 0;
+        }
+    private:
+        const SynchronizedQueue* queue;
+    };
+
+    /**
+     * Publishes the current size of the queue. Acquire the lock before
+     * calling this method and call it after every modification.
+     */
+    void updateCountLocked() {
+        this->elementCount.store(this->queue.size(),
+                boost::memory_order_release);
+    }
+
+    /**
+     * Evicts the oldest elements so that one more element fits into the
+     * queue without exceeding the size limit. Acquire the lock before calling
+     * this method.
+     */
+    void makeRoomLocked() {
+        if (this->sizeLimit > 0) {
+            while (this->queue.size() > this->sizeLimit - 1) {
+                if (this->dropHandler) {
+                    this->dropHandler(this->queue.front());
+                }
+                this->queue.pop();
+            }
+        }
+    }
+
+    /**
+     * Appends an element, evicting the oldest ones if the size limit would
+     * be exceeded. Acquire the lock before calling this method.
+     */
+    void pushLocked(const M& message) {
+        makeRoomLocked();
+        this->queue.push(message);
+        updateCountLocked();
+    }
+
+    /**
+     * Blocks until the queue contains at least one element.
+     *
+     * @param lock the already acquired lock on #mutex
+     * @param timeoutMs maximum time spent waiting in milliseconds. Zero
+     *                  indicates to wait endlessly.
+     * @throw InterruptedException if #interrupt was called before or while
+     *                             waiting
+     * @throw QueueEmptyException @a timeoutMs was > 0 and no element became
+     *                            available in time
+     */
+    void waitForElement(boost::mutex::scoped_lock& lock,
+            const boost::uint32_t& timeoutMs) {
+
+        bool available;
+        if (timeoutMs == 0) {
+            available = WaitStrategy::wait(lock, this->condition,
+                    ElementAvailable(this), 0);
+        } else {
+            const boost::system_time deadline = boost::get_system_time()
+                    + boost::posix_time::milliseconds(timeoutMs);
+            available = WaitStrategy::wait(lock, this->condition,
+                    ElementAvailable(this), &deadline);
+        }
+
+        if (this->interrupted.load(boost::memory_order_acquire)) {
+            throw InterruptedException("Queue was interrupted");
+        }
+        if (!available) {
+            throw QueueEmptyException(boost::str(boost::format("No element available on queue within %d ms.") % timeoutMs));
+        }
+
+    }
+
+    /**
+     * Moves up to @a n elements from the front of the queue to the end of
+     * @a out. Acquire the lock before calling this method.
+     */
+    template<class Container>
+    std::size_t popLocked(const std::size_t& n, Container& out) {
+        std::size_t count = 0;
+        while (count < n && !this->queue.empty()) {
+            out.push_back(boost::move(this->queue.front()));
+            this->queue.pop();
+            ++count;
+        }
+        updateCountLocked();
+        return count;
+    }
+
 public:
 
     /**
@@ -85,7 +211,8 @@ public:
      */
     explicit SynchronizedQueue(const unsigned int& sizeLimit = 0,
                                dropHandlerType dropHandler = 0) :
-        interrupted(false), sizeLimit(sizeLimit), dropHandler(dropHandler) {
+        interrupted(false), elementCount(0), sizeLimit(sizeLimit),
+        dropHandler(dropHandler) {
     }
 
     virtual ~SynchronizedQueue() {
@@ -103,18 +230,88 @@ public:
      */
     void push(const M& message) {
         {
-            boost::recursive_mutex::scoped_lock lock(this->mutex);
-            if (this->sizeLimit > 0) {
-                while (this->queue.size() > this->sizeLimit - 1) {
-                    if (this->dropHandler) {
-                        this->dropHandler(this->queue.front());
-                    }
-                    this->queue.pop();
-                }
+            boost::mutex::scoped_lock lock(this->mutex);
+            pushLocked(message);
+        }
+        WaitStrategy::notifyOne(this->condition);
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /**
+     * Moves a new element on the queue and wakes up one waiting client if
+     * there is one. Allows to use move-only element types.
+     *
+     * @param message element to move on the queue
+     */
+    void push(M&& message) {
+        {
+            boost::mutex::scoped_lock lock(this->mutex);
+            makeRoomLocked();
+            this->queue.push(boost::move(message));
+            updateCountLocked();
+        }
+        WaitStrategy::notifyOne(this->condition);
+    }
+#endif
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+    /**
+     * Constructs a new element in place at the end of the queue and wakes up
+     * one waiting client if there is one.
+     *
+     * @param args arguments forwarded to the constructor of M
+     */
+    template<class... Args>
+    void emplace(Args&&... args) {
+        {
+            boost::mutex::scoped_lock lock(this->mutex);
+            makeRoomLocked();
+            this->queue.emplace(boost::forward<Args>(args)...);
+            updateCountLocked();
+        }
+        WaitStrategy::notifyOne(this->condition);
+    }
+#endif
+
+    /**
+     * Pushes all elements in [@a begin, @a end) on the queue while holding
+     * the lock only once. The size limit is honored for each element, i.e.
+     * if more elements are pushed than the limit allows, the oldest ones
+     * (possibly from the pushed range itself) are passed to the drop handler.
+     * Waiting clients are woken up once after all elements were added.
+     *
+     * @param begin iterator to the first element to push
+     * @param end iterator past the last element to push
+     * @tparam Iterator input iterator with value type M
+     */
+    template<class Iterator>
+    void pushAll(Iterator begin, Iterator end) {
+        std::size_t count = 0;
+        {
+            boost::mutex::scoped_lock lock(this->mutex);
+            for (; begin != end; ++begin) {
+                pushLocked(*begin);
+                ++count;
             }
-            this->queue.push(message);
         }
-        this->condition.notify_one();
+        if (count == 1) {
+            WaitStrategy::notifyOne(this->condition);
+        } else if (count > 1) {
+            WaitStrategy::notifyAll(this->condition);
+        }
+    }
+
+    /**
+     * Pushes all elements of @a range on the queue while holding the lock
+     * only once.
+     *
+     * @param range elements to push in iteration order
+     * @tparam Range a range with value type M, e.g. a std::vector<M>
+     * @see pushAll(Iterator, Iterator)
+     */
+    template<class Range>
+    void pushAll(const Range& range) {
+        pushAll(boost::begin(range), boost::end(range));
     }
 
     /**
@@ -133,27 +330,8 @@ public:
      */
     M peek(const boost::uint32_t& timeoutMs = 0) {
 
-        boost::recursive_mutex::scoped_lock lock(this->mutex);
-
-        while (!this->interrupted && this->queue.empty()) {
-            if (timeoutMs == 0) {
-                this->condition.wait(lock);
-            } else {
-#if BOOST_VERSION >= 105000
-                if (!this->condition.timed_wait(lock, boost::posix_time::milliseconds(timeoutMs))) {
-#else
-                const boost::system_time timeout = boost::get_system_time()
-                    + boost::posix_time::milliseconds(timeoutMs);
-                if (!this->condition.timed_wait(lock, timeout)) {
-#endif
-                    throw QueueEmptyException(boost::str(boost::format("No element available on queue within %d ms.") % timeoutMs));
-                }
-            }
-        }
-
-        if (this->interrupted) {
-            throw InterruptedException("Queue was interrupted");
-        }
+        boost::mutex::scoped_lock lock(this->mutex);
+        waitForElement(lock, timeoutMs);
 
         return this->queue.front();
     }
@@ -174,30 +352,12 @@ public:
      */
     M pop(const boost::uint32_t& timeoutMs = 0) {
 
-        boost::recursive_mutex::scoped_lock lock(this->mutex);
-
-        while (!this->interrupted && this->queue.empty()) {
-            if (timeoutMs == 0) {
-                this->condition.wait(lock);
-            } else {
-#if BOOST_VERSION >= 105000
-                if (!this->condition.timed_wait(lock, boost::posix_time::milliseconds(timeoutMs))) {
-#else
-                const boost::system_time timeout = boost::get_system_time()
-                        + boost::posix_time::milliseconds(timeoutMs);
-                if (!this->condition.timed_wait(lock, timeout)) {
-#endif
-                    throw QueueEmptyException(boost::str(boost::format("No element available on queue within %d ms.") % timeoutMs));
-                }
-            }
-        }
-
-        if (this->interrupted) {
-            throw InterruptedException("Queue was interrupted");
-        }
+        boost::mutex::scoped_lock lock(this->mutex);
+        waitForElement(lock, timeoutMs);
 
-        M message = this->queue.front();
+        M message = boost::move(this->queue.front());
         this->queue.pop();
+        updateCountLocked();
         return message;
 
     }
@@ -211,47 +371,89 @@ public:
      */
     M tryPop() {
 
-        boost::recursive_mutex::scoped_lock lock(this->mutex);
+        boost::mutex::scoped_lock lock(this->mutex);
 
         if (this->queue.empty()) {
             throw QueueEmptyException();
         }
 
-        M message = this->queue.front();
+        M message = boost::move(this->queue.front());
         this->queue.pop();
+        updateCountLocked();
         return message;
 
     }
 
+    /**
+     * Removes up to @a n elements from the front of the queue and appends
+     * them to @a out in queue order while holding the lock only once. Waits
+     * until at least one element is available, exactly like #pop.
+     *
+     * @param n maximum number of elements to remove
+     * @param out container the elements are appended to using @c push_back
+     * @param timeoutMs maximum time spent waiting for the first element in
+     *                  milliseconds. Zero indicates to wait endlessly.
+     * @return number of elements appended to @a out, at least one unless
+     *         @a n is 0
+     * @throw InterruptedException if #interrupt was called before a call to
+     *                             this method or while waiting for an element
+     * @throw QueueEmptyException thrown if @param timeoutMs was > 0 and no
+     *                            element was found on the queue in the
+     *                            specified time
+     */
+    template<class Container>
+    std::size_t popUpTo(const std::size_t& n, Container& out,
+            const boost::uint32_t& timeoutMs = 0) {
+
+        boost::mutex::scoped_lock lock(this->mutex);
+        waitForElement(lock, timeoutMs);
+
+        return popLocked(n, out);
+
+    }
+
+    /**
+     * Removes all elements currently contained in the queue and appends them
+     * to @a out in queue order. Does not wait and is not affected by the
+     * interruption flag.
+     *
+     * @param out container the elements are appended to using @c push_back
+     * @return number of elements appended to @a out
+     */
+    template<class Container>
+    std::size_t drainTo(Container& out) {
+        boost::mutex::scoped_lock lock(this->mutex);
+        return popLocked(this->queue.size(), out);
+    }
+
     /**
      * Checks whether this queue is empty. Is not affected by the interruption
-     * flag.
+     * flag and does not acquire the lock.
      *
      * @return @c true if empty, else @c false
      */
     bool empty() const {
-        boost::recursive_mutex::scoped_lock lock(this->mutex);
-        return this->queue.empty();
+        return this->elementCount.load(boost::memory_order_acquire) == 0;
     }
 
     /**
-     * Return element count of the queue.
+     * Return element count of the queue. Does not acquire the lock.
      *
      * @return The number of elements currently stored in the queue.
      */
     std::size_t size() const {
-        boost::recursive_mutex::scoped_lock lock(this->mutex);
-        return this->queue.size();
+        return this->elementCount.load(boost::memory_order_acquire);
     }
 
     /**
      * Remove all elements from the queue.
      */
     void clear() {
-        boost::recursive_mutex::scoped_lock lock(this->mutex);
+        boost::mutex::scoped_lock lock(this->mutex);
         while (!this->queue.empty()) {
             this->queue.pop();
         }
+        updateCountLocked();
     }
 
     /**
@@ -261,10 +463,10 @@ public:
      */
     void interrupt() {
         {
-            boost::recursive_mutex::scoped_lock lock(this->mutex);
-            this->interrupted = true;
+            boost::mutex::scoped_lock lock(this->mutex);
+            this->interrupted.store(true, boost::memory_order_release);
         }
-        this->condition.notify_all();
+        WaitStrategy::notifyAll(this->condition);
     }
 
 };
@@ -0,0 +1,235 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include "TimerWheel.h"
+
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+
+#include "../misc/langutils.h"
+
+using namespace std;
+
+namespace rsc {
+namespace threading {
+
+const boost::uint64_t TimerWheel::DEFAULT_RESOLUTION = 1000;
+const std::size_t TimerWheel::DEFAULT_SLOTS = 64;
+const std::size_t TimerWheel::DEFAULT_LEVELS = 4;
+
+TimerWheel::TimerWheel(const boost::uint64_t& resolutionMus,
+        const std::size_t& numSlots, const std::size_t& numLevels) :
+        resolution(resolutionMus), startTime(rsc::misc::currentTimeMicros()), numSlots(
+                numSlots), pending(0), processedTick(0), wakeTick(0), stopped(
+                false) {
+    if (resolutionMus == 0 || numSlots == 0 || numLevels == 0) {
+        throw invalid_argument(
+                "Timer wheel needs a resolution, slots and levels greater than 0");
+    }
+    levels.resize(numLevels, vector<list<Timer> >(numSlots));
+    boost::uint64_t ticks = 1;
+    for (size_t i = 0; i < numLevels; ++i) {
+        slotTicks.push_back(ticks);
+        ticks *= numSlots;
+    }
+    thread = boost::thread(boost::bind(&TimerWheel::run, this));
+}
+
+TimerWheel::~TimerWheel() {
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        stopped = true;
+    }
+    condition.notify_all();
+    thread.join();
+}
+
+void TimerWheel::schedule(const Callback& callback,
+        const boost::uint64_t& delayMus) {
+
+    const boost::uint64_t nowMus = rsc::misc::currentTimeMicros();
+    const boost::uint64_t elapsed = nowMus > startTime ? nowMus - startTime : 0;
+    const boost::uint64_t now = elapsed / resolution;
+
+    boost::mutex::scoped_lock lock(mutex);
+    if (pending == 0 && processedTick < now) {
+        // nothing to expire in between
+        processedTick = now;
+    }
+    Timer timer;
+    // round up to not expire early
+    timer.tick = max((elapsed + delayMus + resolution - 1) / resolution,
+            processedTick + 1);
+    timer.callback = callback;
+    insertLocked(timer);
+    if (++pending == 1 || timer.tick < wakeTick) {
+        condition.notify_all();
+    }
+
+}
+
+void TimerWheel::insertLocked(const Timer& timer) {
+    const boost::uint64_t delta = timer.tick - processedTick;
+    size_t level = 0;
+    while (level + 1 < levels.size() && delta >= slotTicks[level + 1]) {
+        ++level;
+    }
+    levels[level][(timer.tick / slotTicks[level]) % numSlots].push_back(timer);
+}
+
+void TimerWheel::advanceLocked(vector<Callback>& expired) {
+
+    const boost::uint64_t tick = ++processedTick;
+
+    // move timers down, starting with the highest level which completed a
+    // slot so that its timers can move down several levels at once
+    size_t top = 0;
+    while (top + 1 < levels.size() && tick % slotTicks[top + 1] == 0) {
+        ++top;
+    }
+    for (size_t level = top; level > 0; --level) {
+        list<Timer> timers;
+        timers.swap(levels[level][(tick / slotTicks[level]) % numSlots]);
+        for (list<Timer>::iterator it = timers.begin(); it != timers.end();
+                ++it) {
+            if (it->tick <= tick) {
+                expired.push_back(it->callback);
+                --pending;
+            } else {
+                insertLocked(*it);
+            }
+        }
+    }
+
+    list<Timer>& slot = levels[0][tick % numSlots];
+    for (list<Timer>::iterator it = slot.begin(); it != slot.end();) {
+        if (it->tick <= tick) {
+            expired.push_back(it->callback);
+            it = slot.erase(it);
+            --pending;
+        } else {
+            // only with a single level
+            ++it;
+        }
+    }
+
+}
+
+boost::uint64_t TimerWheel::nextEventTickLocked() const {
+    const boost::uint64_t rotationEnd = (processedTick / numSlots + 1)
+            * numSlots;
+    for (boost::uint64_t tick = processedTick + 1; tick < rotationEnd;
+            ++tick) {
+        if (!levels[0][tick % numSlots].empty()) {
+            return tick;
+        }
+    }
+    return rotationEnd;
+}
+
+void TimerWheel::expireAll() {
+    vector<Callback> expired;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        for (size_t level = 0; level < levels.size(); ++level) {
+            for (size_t slot = 0; slot < numSlots; ++slot) {
+                list<Timer>& timers = levels[level][slot];
+                for (list<Timer>::iterator it = timers.begin();
+                        it != timers.end(); ++it) {
+                    expired.push_back(it->callback);
+                }
+                timers.clear();
+            }
+        }
+        pending = 0;
+    }
+    for (vector<Callback>::iterator it = expired.begin(); it != expired.end();
+            ++it) {
+        (*it)();
+    }
+}
+
+boost::uint64_t TimerWheel::getResolution() const {
+    return resolution;
+}
+
+std::size_t TimerWheel::getPendingCount() const {
+    boost::mutex::scoped_lock lock(mutex);
+    return pending;
+}
+
+void TimerWheel::run() {
+
+    boost::mutex::scoped_lock lock(mutex);
+    while (!stopped) {
+
+        if (pending == 0) {
+            wakeTick = 0;
+            condition.wait(lock);
+            continue;
+        }
+
+        const boost::uint64_t nowMus = rsc::misc::currentTimeMicros();
+        const boost::uint64_t now =
+                nowMus > startTime ? (nowMus - startTime) / resolution : 0;
+        wakeTick = nextEventTickLocked();
+        if (wakeTick > now) {
+            const boost::uint64_t wakeMus = startTime + wakeTick * resolution;
+            condition.timed_wait(lock,
+                    boost::get_system_time()
+                            + boost::posix_time::microseconds(
+                                    wakeMus > nowMus ? wakeMus - nowMus : 0));
+            continue;
+        }
+
+        // ticks before the next event have nothing to do
+        vector<Callback> expired;
+        while (processedTick < now && pending > 0) {
+            const boost::uint64_t next = nextEventTickLocked();
+            if (next > now) {
+                break;
+            }
+            processedTick = next - 1;
+            advanceLocked(expired);
+        }
+        if (pending == 0 || processedTick < now) {
+            processedTick = now;
+        }
+
+        lock.unlock();
+        for (vector<Callback>::iterator it = expired.begin();
+                it != expired.end(); ++it) {
+            (*it)();
+        }
+        lock.lock();
+
+    }
+
+}
+
+}
+}
@@ -0,0 +1,188 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <list>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "rsc/rscexports.h"
+
+namespace rsc {
+namespace threading {
+
+/**
+ * Calls functions after a delay using a single timer thread for all of them.
+ * Timers are kept in a hierarchy of wheels. The slots of the lowest level
+ * last #getResolution microseconds, each slot of a higher level covers a whole
+ * rotation of the level below. Timers move down a level whenever the lower
+ * level completed a rotation, so that scheduling and expiring a timer takes
+ * constant time independent of the number of pending timers and their delays.
+ * Timers expire at most one resolution step late, apart from scheduling
+ * latencies. The timer thread only wakes up for slots with timers and for
+ * moving timers down.
+ *
+ * Callbacks are executed by the timer thread and must hence be short, e.g.
+ * handing the real work over to another thread.
+ *
+ * @author jwienke
+ */
+class RSC_EXPORT TimerWheel: private boost::noncopyable {
+public:
+
+    typedef boost::function<void()> Callback;
+
+    /**
+     * Default duration of a slot in microseconds.
+     */
+    static const boost::uint64_t DEFAULT_RESOLUTION;
+
+    /**
+     * Default number of slots per level.
+     */
+    static const std::size_t DEFAULT_SLOTS;
+
+    /**
+     * Default number of levels.
+     */
+    static const std::size_t DEFAULT_LEVELS;
+
+    /**
+     * Creates a wheel and starts its timer thread.
+     *
+     * @param resolutionMus duration of a slot of the lowest level in
+     *                      microseconds
+     * @param numSlots number of slots per level
+     * @param numLevels number of levels. Timers further in the future than
+     *                  the range of all levels stay in the highest level for
+     *                  several rotations
+     * @throw std::invalid_argument if one of the arguments is 0
+     */
+    explicit TimerWheel(const boost::uint64_t& resolutionMus =
+            DEFAULT_RESOLUTION, const std::size_t& numSlots = DEFAULT_SLOTS,
+            const std::size_t& numLevels = DEFAULT_LEVELS);
+
+    /**
+     * Stops the timer thread. Pending callbacks are not called.
+     */
+    virtual ~TimerWheel();
+
+    /**
+     * Calls @a callback after @a delayMus microseconds.
+     *
+     * @param callback function to call from the timer thread
+     * @param delayMus delay in microseconds
+     */
+    void schedule(const Callback& callback, const boost::uint64_t& delayMus);
+
+    /**
+     * Calls all pending callbacks right away from the calling thread, e.g.
+     * to release resources held by them on shutdown.
+     */
+    void expireAll();
+
+    /**
+     * Returns the duration of a slot.
+     *
+     * @return resolution in microseconds
+     */
+    boost::uint64_t getResolution() const;
+
+    /**
+     * Returns the number of callbacks which are not called yet.
+     *
+     * @return pending callbacks
+     */
+    std::size_t getPendingCount() const;
+
+private:
+
+    struct Timer {
+        boost::uint64_t tick;
+        Callback callback;
+    };
+
+    /**
+     * Puts @a timer into the slot of the lowest level which covers its tick.
+     * Acquire #mutex before calling this method.
+     */
+    void insertLocked(const Timer& timer);
+
+    /**
+     * Advances #processedTick by one, moves timers down and collects the
+     * expired ones. Acquire #mutex before calling this method.
+     */
+    void advanceLocked(std::vector<Callback>& expired);
+
+    /**
+     * Returns the next tick which has timers in the lowest level or at which
+     * timers are moved down. Acquire #mutex before calling this method.
+     */
+    boost::uint64_t nextEventTickLocked() const;
+
+    void run();
+
+    const boost::uint64_t resolution;
+    const boost::uint64_t startTime;
+    const std::size_t numSlots;
+
+    mutable boost::mutex mutex;
+    boost::condition condition;
+    /**
+     * Slots indexed by level and slot number.
+     */
+    std::vector<std::vector<std::list<Timer> > > levels;
+    /**
+     * Number of ticks covered by a slot of each level.
+     */
+    std::vector<boost::uint64_t> slotTicks;
+    std::size_t pending;
+    /**
+     * All timers up to this tick have expired.
+     */
+    boost::uint64_t processedTick;
+    /**
+     * Tick the timer thread sleeps until.
+     */
+    boost::uint64_t wakeTick;
+    bool stopped;
+
+    boost::thread thread;
+
+};
+
+typedef boost::shared_ptr<TimerWheel> TimerWheelPtr;
+
+}
+}
@@ -0,0 +1,185 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#pragma once
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/thread_time.hpp>
+
+namespace rsc {
+namespace threading {
+
+/**
+ * @name waiting strategies
+ *
+ * Policies used by SynchronizedQueue to wait for new elements. Each strategy
+ * provides a static method @c wait which blocks until a predicate becomes
+ * true or an optional deadline expires. It is entered and left with the lock
+ * held. The predicate may also be evaluated while the lock is released, hence
+ * it must only read state that can be accessed without locking. The static
+ * methods @c notifyOne and @c notifyAll are used to wake up waiting threads.
+ */
+//@{
+
+/**
+ * Hints the processor that the calling thread is spinning.
+ */
+inline void cpuRelax() {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#endif
+}
+
+/**
+ * Parks waiting threads on the condition variable immediately. This is the
+ * most CPU-friendly strategy and the default.
+ *
+ * @author jwienke
+ */
+struct BlockingWaitStrategy {
+
+    /**
+     * Waits until @a ready returns @c true or @a deadline expires.
+     *
+     * @param lock acquired lock protecting the state @a ready depends on
+     * @param condition condition variable notified on state changes
+     * @param ready predicate to wait for
+     * @param deadline absolute time to wait for at most or @c NULL to wait
+     *                 endlessly
+     * @return result of the last evaluation of @a ready
+     * @tparam Predicate nullary function object returning @c bool
+     */
+    template<class Predicate>
+    static bool wait(boost::mutex::scoped_lock& lock,
+            boost::condition_variable& condition, Predicate ready,
+            const boost::system_time* deadline) {
+        while (!ready()) {
+            if (!deadline) {
+                condition.wait(lock);
+            } else if (!condition.timed_wait(lock, *deadline)) {
+                return ready();
+            }
+        }
+        return true;
+    }
+
+    static void notifyOne(boost::condition_variable& condition) {
+        condition.notify_one();
+    }
+
+    static void notifyAll(boost::condition_variable& condition) {
+        condition.notify_all();
+    }
+
+};
+
+/**
+ * Spins for a bounded number of iterations with the lock released before
+ * parking on the condition variable. Reduces the wake-up latency for
+ * elements arriving shortly after a consumer started to wait at the cost of
+ * some CPU time.
+ *
+ * @author jwienke
+ * @tparam SPINS number of spin iterations before parking
+ */
+template<unsigned int SPINS = 4000>
+struct SpinThenBlockWaitStrategy {
+
+    /**
+     * @see BlockingWaitStrategy::wait
+     */
+    template<class Predicate>
+    static bool wait(boost::mutex::scoped_lock& lock,
+            boost::condition_variable& condition, Predicate ready,
+            const boost::system_time* deadline) {
+        if (ready()) {
+            return true;
+        }
+        lock.unlock();
+        for (unsigned int i = 0; i < SPINS && !ready(); ++i) {
+            cpuRelax();
+        }
+        lock.lock();
+        return BlockingWaitStrategy::wait(lock, condition, ready, deadline);
+    }
+
+    static void notifyOne(boost::condition_variable& condition) {
+        condition.notify_one();
+    }
+
+    static void notifyAll(boost::condition_variable& condition) {
+        condition.notify_all();
+    }
+
+};
+
+/**
+ * Never parks waiting threads but polls the predicate with the lock released
+ * and yields the processor between polls. Gives the lowest wake-up latency
+ * and avoids the cost of notifications, but keeps a core busy for every
+ * waiting thread. Only use this for latency-critical pipelines with
+ * dedicated cores.
+ *
+ * @author jwienke
+ */
+struct BusyPollWaitStrategy {
+
+    /**
+     * @see BlockingWaitStrategy::wait
+     */
+    template<class Predicate>
+    static bool wait(boost::mutex::scoped_lock& lock,
+            boost::condition_variable& /*condition*/, Predicate ready,
+            const boost::system_time* deadline) {
+        while (!ready()) {
+            if (deadline && boost::get_system_time() >= *deadline) {
+                return false;
+            }
+            lock.unlock();
+            while (!ready()
+                    && (!deadline || boost::get_system_time() < *deadline)) {
+                cpuRelax();
+                boost::this_thread::yield();
+            }
+            lock.lock();
+        }
+        return true;
+    }
+
+    static void notifyOne(boost::condition_variable& /*condition*/) {
+    }
+
+    static void notifyAll(boost::condition_variable& /*condition*/) {
+    }
+
+};
+
+//@}
+
+}
+}
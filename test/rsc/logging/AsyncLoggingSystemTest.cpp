@@ -0,0 +1,299 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/logging/AsyncLoggingSystem.h"
+#include "rsc/logging/LoggingSystemFactory.h"
+#include "rsc/patterns/Factory.h"
+
+using namespace std;
+using namespace rsc;
+using namespace rsc::logging;
+
+/**
+ * A stream buffer collecting its output which blocks writes while closed,
+ * e.g. to simulate a stalled terminal.
+ *
+ * @author jwienke
+ */
+class GatedBuffer: public streambuf {
+public:
+
+    GatedBuffer() :
+            open(true), writing(false) {
+    }
+
+    void close() {
+        boost::mutex::scoped_lock lock(mutex);
+        open = false;
+    }
+
+    void release() {
+        boost::mutex::scoped_lock lock(mutex);
+        open = true;
+        condition.notify_all();
+    }
+
+    void waitForBlockedWrite() {
+        boost::mutex::scoped_lock lock(mutex);
+        while (!writing) {
+            condition.wait(lock);
+        }
+    }
+
+    string str() {
+        boost::mutex::scoped_lock lock(mutex);
+        return output;
+    }
+
+protected:
+
+    streamsize xsputn(const char* s, streamsize n) {
+        boost::mutex::scoped_lock lock(mutex);
+        writing = true;
+        condition.notify_all();
+        while (!open) {
+            condition.wait(lock);
+        }
+        writing = false;
+        output.append(s, n);
+        return n;
+    }
+
+    int overflow(int c) {
+        if (c != EOF) {
+            char ch = c;
+            xsputn(&ch, 1);
+        }
+        return c;
+    }
+
+private:
+    boost::mutex mutex;
+    boost::condition condition;
+    bool open;
+    bool writing;
+    string output;
+};
+
+size_t countLines(const string& text) {
+    size_t lines = 0;
+    for (string::const_iterator it = text.begin(); it != text.end(); ++it) {
+        if (*it == '\n') {
+            ++lines;
+        }
+    }
+    return lines;
+}
+
+TEST(AsyncLoggingSystemTest, testLog)
+{
+
+    GatedBuffer buffer;
+    ostream stream(&buffer);
+    AsyncLoggingSystem system(16, AsyncLoggingSystem::OVERFLOW_BLOCK, stream);
+    EXPECT_EQ("AsyncLoggingSystem", system.getName());
+
+    LoggerPtr logger = system.createLogger("a.test");
+    EXPECT_EQ("a.test", logger->getName());
+    EXPECT_EQ(Logger::LEVEL_INFO, logger->getLevel());
+
+    logger->debug("invisible");
+    for (unsigned int i = 0; i < 100; ++i) {
+        logger->info(boost::lexical_cast<string>(i));
+    }
+    system.flush();
+
+    const string output = buffer.str();
+    EXPECT_EQ(size_t(100), countLines(output));
+    EXPECT_EQ(string::npos, output.find("invisible"));
+    size_t position = 0;
+    for (unsigned int i = 0; i < 100; ++i) {
+        position = output.find(
+                "a.test [INFO]: " + boost::lexical_cast<string>(i) + "\n",
+                position);
+        ASSERT_NE(string::npos, position) << "Missing or reordered record "
+                << i;
+    }
+    EXPECT_EQ(boost::uint64_t(0), system.getDroppedCount());
+
+}
+
+TEST(AsyncLoggingSystemTest, testFatalIsFlushed)
+{
+
+    GatedBuffer buffer;
+    ostream stream(&buffer);
+    AsyncLoggingSystem system(16, AsyncLoggingSystem::OVERFLOW_DROP, stream);
+    LoggerPtr logger = system.createLogger("a.test");
+
+    logger->info("before");
+    logger->fatal("fatal");
+    const string output = buffer.str();
+    EXPECT_NE(string::npos, output.find("[INFO]: before"));
+    EXPECT_NE(string::npos, output.find("[FATAL]: fatal"));
+
+}
+
+TEST(AsyncLoggingSystemTest, testRecordsKeepLoggerName)
+{
+
+    GatedBuffer buffer;
+    ostream stream(&buffer);
+    AsyncLoggingSystem system(16, AsyncLoggingSystem::OVERFLOW_BLOCK, stream);
+    LoggerPtr logger = system.createLogger("a.test");
+
+    // records are formatted by the writer thread after the rename
+    buffer.close();
+    logger->info("stall");
+    buffer.waitForBlockedWrite();
+    logger->info("old");
+    logger->setName("b.test");
+    logger->info("new");
+    buffer.release();
+    system.flush();
+
+    const string output = buffer.str();
+    EXPECT_NE(string::npos, output.find("a.test [INFO]: old\n"));
+    EXPECT_NE(string::npos, output.find("b.test [INFO]: new\n"));
+
+}
+
+void logMany(LoggerPtr logger, const unsigned int& count) {
+    for (unsigned int i = 0; i < count; ++i) {
+        logger->info("record");
+    }
+}
+
+TEST(AsyncLoggingSystemTest, testOverflowBlock)
+{
+
+    GatedBuffer buffer;
+    ostream stream(&buffer);
+    boost::shared_ptr<AsyncLoggingSystem> system(
+            new AsyncLoggingSystem(4, AsyncLoggingSystem::OVERFLOW_BLOCK,
+                    stream));
+    LoggerPtr logger = system->createLogger("a.test");
+
+    buffer.close();
+    logger->info("stall");
+    buffer.waitForBlockedWrite();
+
+    boost::thread producer(boost::bind(&logMany, logger, 20));
+    EXPECT_FALSE(
+            producer.timed_join(boost::posix_time::milliseconds(200))) << "Producer must block while the queue is full";
+
+    buffer.release();
+    producer.join();
+    system->flush();
+    EXPECT_EQ(size_t(21), countLines(buffer.str()));
+    EXPECT_EQ(boost::uint64_t(0), system->getDroppedCount());
+
+}
+
+TEST(AsyncLoggingSystemTest, testOverflowDrop)
+{
+
+    AsyncLoggingSystem::OverflowPolicy policies[] = {
+            AsyncLoggingSystem::OVERFLOW_DROP,
+            AsyncLoggingSystem::OVERFLOW_COUNT_AND_DROP };
+    for (unsigned int p = 0; p < 2; ++p) {
+
+        GatedBuffer buffer;
+        ostream stream(&buffer);
+        AsyncLoggingSystem system(4, policies[p], stream);
+        LoggerPtr logger = system.createLogger("a.test");
+
+        buffer.close();
+        logger->info("stall");
+        buffer.waitForBlockedWrite();
+
+        // returns although the queue is full
+        logMany(logger, 20);
+        EXPECT_EQ(boost::uint64_t(16), system.getDroppedCount());
+
+        buffer.release();
+        system.flush();
+        const string output = buffer.str();
+        if (policies[p] == AsyncLoggingSystem::OVERFLOW_COUNT_AND_DROP) {
+            EXPECT_NE(string::npos, output.find("Dropped 16 log records"));
+            EXPECT_EQ(size_t(6), countLines(output));
+        } else {
+            EXPECT_EQ(string::npos, output.find("Dropped"));
+            EXPECT_EQ(size_t(5), countLines(output));
+        }
+
+    }
+
+}
+
+TEST(AsyncLoggingSystemTest, testDestructionDrains)
+{
+
+    GatedBuffer buffer;
+    {
+        ostream stream(&buffer);
+        AsyncLoggingSystem system(1024, AsyncLoggingSystem::OVERFLOW_BLOCK,
+                stream);
+        logMany(system.createLogger("a.test"), 100);
+    }
+    EXPECT_EQ(size_t(100), countLines(buffer.str()));
+
+}
+
+TEST(AsyncLoggingSystemTest, testFactory)
+{
+
+    boost::shared_ptr<LoggingSystem> system(
+            LoggingSystemFactory::getInstance().createInst("async"));
+    EXPECT_EQ("AsyncLoggingSystem", system->getName());
+
+    runtime::Properties properties;
+    properties.set<string>("capacity", "64");
+    properties.set<string>("overflow", "count");
+    system.reset(
+            LoggingSystemFactory::getInstance().createInst("async",
+                    properties));
+    EXPECT_EQ("AsyncLoggingSystem", system->getName());
+
+    runtime::Properties invalid;
+    invalid.set<string>("overflow", "explode");
+    EXPECT_THROW(
+            LoggingSystemFactory::getInstance().createInst("async", invalid),
+            patterns::ConstructError);
+
+}
@@ -0,0 +1,259 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/logging/BinaryLogFormat.h"
+#include "rsc/logging/BinaryLogReader.h"
+#include "rsc/logging/BinaryLoggingSystem.h"
+#include "rsc/logging/LoggingSystemFactory.h"
+
+using namespace std;
+using namespace rsc;
+using namespace rsc::logging;
+
+class BinaryLoggingSystemTest: public testing::Test {
+public:
+
+    void SetUp() {
+        fileName = (boost::filesystem::temp_directory_path()
+                / boost::filesystem::unique_path(
+                        "rsc-binary-log-%%%%-%%%%-%%%%.bin")).string();
+    }
+
+    void TearDown() {
+        boost::filesystem::remove(fileName);
+    }
+
+    vector<BinaryLogReader::Entry> read() {
+        vector<BinaryLogReader::Entry> entries;
+        BinaryLogReader reader(fileName);
+        BinaryLogReader::Entry entry;
+        while (reader.next(entry)) {
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    string fileName;
+
+};
+
+TEST_F(BinaryLoggingSystemTest, testRoundTrip) {
+
+    unsigned int line;
+    {
+        BinaryLoggingSystem system(fileName);
+        LoggerPtr logger = system.createLogger("a.test");
+        logger->setLevel(Logger::LEVEL_DEBUG);
+
+        line = __LINE__ + 1;
+        RSCINFO(logger, "message " << 42);
+        logger->log(Logger::LEVEL_WARN, "plain");
+        RSCTRACE(logger, "disabled");
+        logger->setName("renamed");
+        RSCERROR(logger, string(1000, 'x'));
+
+        EXPECT_EQ(boost::uint64_t(0), system.getDroppedCount());
+    }
+
+    // the file is truncated to the written data
+    EXPECT_GT(boost::filesystem::file_size(fileName), boost::uintmax_t(1000));
+    EXPECT_LT(boost::filesystem::file_size(fileName), boost::uintmax_t(2000));
+
+    vector<BinaryLogReader::Entry> entries = read();
+    ASSERT_EQ(size_t(3), entries.size());
+
+    EXPECT_EQ("a.test", entries[0].logger);
+    EXPECT_EQ(Logger::LEVEL_INFO, entries[0].level);
+    EXPECT_EQ("message 42", entries[0].message);
+    EXPECT_EQ(string(__FILE__), entries[0].file);
+    EXPECT_EQ(line, entries[0].line);
+    EXPECT_GT(entries[0].timestamp, boost::uint64_t(0));
+
+    EXPECT_EQ("a.test", entries[1].logger);
+    EXPECT_EQ(Logger::LEVEL_WARN, entries[1].level);
+    EXPECT_EQ("plain", entries[1].message);
+    EXPECT_EQ("", entries[1].file);
+    EXPECT_EQ(0u, entries[1].line);
+    EXPECT_LE(entries[0].timestamp, entries[1].timestamp);
+
+    EXPECT_EQ("renamed", entries[2].logger);
+    EXPECT_EQ(Logger::LEVEL_ERROR, entries[2].level);
+    EXPECT_EQ(string(1000, 'x'), entries[2].message);
+
+}
+
+TEST_F(BinaryLoggingSystemTest, testDropsWhenFull) {
+
+    const unsigned int messages = 100;
+    boost::uint64_t dropped;
+    {
+        BinaryLoggingSystem system(fileName, 1024);
+        LoggerPtr logger = system.createLogger("full");
+        for (unsigned int i = 0; i < messages; ++i) {
+            logger->log(Logger::LEVEL_INFO, "message");
+        }
+        dropped = system.getDroppedCount();
+    }
+
+    EXPECT_GT(dropped, boost::uint64_t(0));
+    EXPECT_EQ(messages, read().size() + dropped);
+
+}
+
+TEST_F(BinaryLoggingSystemTest, testSkipsPendingRecords) {
+
+    {
+        BinaryLoggingSystem system(fileName);
+        LoggerPtr logger = system.createLogger("pending");
+        logger->log(Logger::LEVEL_INFO, "first");
+        logger->log(Logger::LEVEL_INFO, "unfinished");
+        logger->log(Logger::LEVEL_INFO, "last");
+    }
+
+    // emulate a writer which crashed after reserving the second message
+    {
+        fstream file(fileName.c_str(),
+                ios_base::in | ios_base::out | ios_base::binary);
+        binarylog::FileHeader fileHeader;
+        file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+        streamoff position = fileHeader.headerSize;
+        unsigned int messages = 0;
+        while (messages < 2) {
+            binarylog::RecordHeader header;
+            file.seekg(position);
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            ASSERT_TRUE(file.good());
+            ASSERT_GT(header.size, boost::uint32_t(0));
+            if (header.type == binarylog::RECORD_MESSAGE && ++messages == 2) {
+                header.type = binarylog::RECORD_PENDING;
+                file.seekp(position);
+                file.write(reinterpret_cast<const char*>(&header),
+                        sizeof(header));
+            } else {
+                position += header.size;
+            }
+        }
+    }
+
+    vector<BinaryLogReader::Entry> entries = read();
+    ASSERT_EQ(size_t(2), entries.size());
+    EXPECT_EQ("first", entries[0].message);
+    EXPECT_EQ("last", entries[1].message);
+
+}
+
+void logMessages(LoggerPtr logger, const unsigned int& count) {
+    for (unsigned int i = 0; i < count; ++i) {
+        RSCINFO(logger, i);
+    }
+}
+
+TEST_F(BinaryLoggingSystemTest, testConcurrentLoggers) {
+
+    const unsigned int threadCount = 4;
+    const unsigned int count = 2000;
+    {
+        BinaryLoggingSystem system(fileName);
+        boost::thread_group threads;
+        for (unsigned int i = 0; i < threadCount; ++i) {
+            LoggerPtr logger = system.createLogger(
+                    "thread" + boost::lexical_cast<string>(i));
+            threads.create_thread(boost::bind(&logMessages, logger, count));
+        }
+        threads.join_all();
+    }
+
+    vector<BinaryLogReader::Entry> entries = read();
+    ASSERT_EQ(size_t(threadCount * count), entries.size());
+
+    // messages of each logger appear in order
+    map<string, unsigned int> expected;
+    for (vector<BinaryLogReader::Entry>::const_iterator it = entries.begin();
+            it != entries.end(); ++it) {
+        EXPECT_EQ(boost::lexical_cast<string>(expected[it->logger]),
+                it->message);
+        ++expected[it->logger];
+        EXPECT_FALSE(it->file.empty());
+    }
+    EXPECT_EQ(size_t(threadCount), expected.size());
+
+}
+
+TEST_F(BinaryLoggingSystemTest, testLoggerOutlivesSystem) {
+
+    LoggerPtr logger;
+    {
+        BinaryLoggingSystem system(fileName);
+        logger = system.createLogger("survivor");
+    }
+    logger->log(Logger::LEVEL_FATAL, "still there");
+    logger.reset();
+
+    vector<BinaryLogReader::Entry> entries = read();
+    ASSERT_EQ(size_t(1), entries.size());
+    EXPECT_EQ("still there", entries[0].message);
+
+}
+
+TEST_F(BinaryLoggingSystemTest, testInvalidFile) {
+
+    EXPECT_THROW(BinaryLoggingSystem(fileName, 4), invalid_argument);
+    EXPECT_THROW(BinaryLogReader reader(fileName), runtime_error);
+
+    {
+        ofstream file(fileName.c_str());
+        file << "this is not a binary log file";
+    }
+    EXPECT_THROW(BinaryLogReader reader(fileName), runtime_error);
+
+}
+
+TEST_F(BinaryLoggingSystemTest, testFactory) {
+
+    runtime::Properties properties;
+    properties.set<string>("file", fileName);
+    properties.set<string>("size", "4096");
+    boost::shared_ptr<LoggingSystem> system(
+            LoggingSystemFactory::getInstance().createInst("binary",
+                    properties));
+    EXPECT_EQ("BinaryLoggingSystem", system->getName());
+    EXPECT_EQ(boost::uintmax_t(4096),
+            boost::filesystem::file_size(fileName));
+
+}
@@ -237,6 +237,48 @@ TEST(LoggerFactoryTest, testReconfigureSameSemantics) {
 
 }
 
+TEST(LoggerFactoryTest, testCachedLevelChecks) {
+
+    LoggerFactory::killInstance();
+    LoggerFactory& factory = LoggerFactory::getInstance();
+
+    LoggerPtr rootLogger = factory.getLogger();
+    LoggerPtr child = factory.getLogger("cached.child");
+    LoggerPtr grandChild = factory.getLogger("cached.child.grand");
+
+    ASSERT_FALSE(grandChild->isLevelEnabled(Logger::LEVEL_DEBUG));
+
+    // level changes propagated through the tree
+    rootLogger->setLevel(Logger::LEVEL_DEBUG);
+    EXPECT_TRUE(grandChild->isLevelEnabled(Logger::LEVEL_DEBUG));
+    EXPECT_FALSE(grandChild->isLevelEnabled(Logger::LEVEL_TRACE));
+
+    child->setLevel(Logger::LEVEL_ERROR);
+    EXPECT_TRUE(rootLogger->isLevelEnabled(Logger::LEVEL_DEBUG));
+    EXPECT_FALSE(child->isLevelEnabled(Logger::LEVEL_WARN));
+    EXPECT_FALSE(grandChild->isLevelEnabled(Logger::LEVEL_WARN));
+    EXPECT_TRUE(grandChild->isLevelEnabled(Logger::LEVEL_ERROR));
+
+    // reconfiguration
+    factory.reconfigure(Logger::LEVEL_TRACE);
+    EXPECT_TRUE(child->isLevelEnabled(Logger::LEVEL_TRACE));
+    EXPECT_TRUE(grandChild->isLevelEnabled(Logger::LEVEL_TRACE));
+
+    // new loggers inherit the cached level of their parent
+    EXPECT_TRUE(factory.getLogger("cached.child.grand.new")->isLevelEnabled(
+            Logger::LEVEL_TRACE));
+
+    // reselection keeps the levels
+    factory.reconfigure(Logger::LEVEL_INFO);
+    factory.reselectLoggingSystem(LoggerFactory::DEFAULT_LOGGING_SYSTEM);
+    EXPECT_TRUE(grandChild->isLevelEnabled(Logger::LEVEL_INFO));
+    EXPECT_FALSE(grandChild->isLevelEnabled(Logger::LEVEL_DEBUG));
+    EXPECT_EQ(Logger::LEVEL_INFO,
+            boost::dynamic_pointer_cast<LoggerProxy>(grandChild)->getLogger()
+                    ->getLevel());
+
+}
+
 TEST(LoggerFactoryTest, testCaseInsensitiveNames) {
 
     LoggerFactory::killInstance();
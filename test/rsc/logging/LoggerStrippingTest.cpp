@@ -0,0 +1,90 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+// strip everything more verbose than INFO in this translation unit
+#define RSC_LOGGING_MIN_LEVEL RSC_LOGGING_LEVEL_INFO
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "rsc/logging/Logger.h"
+
+#include "mocks.h"
+
+using namespace std;
+using namespace rsc;
+using namespace rsc::logging;
+using namespace testing;
+
+namespace {
+
+int evaluations = 0;
+
+int countEvaluation() {
+    ++evaluations;
+    return evaluations;
+}
+
+}
+
+TEST(LoggerStrippingTest, testStrippedStatements) {
+
+    boost::shared_ptr<StubLogger> logger(new StubLogger("stripped"));
+    logger->setLevel(Logger::LEVEL_ALL);
+    evaluations = 0;
+
+    RSCTRACE(logger, "trace " << countEvaluation());
+    RSCDEBUG(logger, "debug " << countEvaluation());
+    RSCTRACE_EXPECT(false, logger, "trace " << countEvaluation());
+    RSCDEBUG_EXPECT(countEvaluation() < 0, logger, "debug");
+
+    EXPECT_EQ(0, evaluations);
+    EXPECT_TRUE(logger->logs.empty());
+
+}
+
+TEST(LoggerStrippingTest, testRemainingStatements) {
+
+    boost::shared_ptr<StubLogger> logger(new StubLogger("stripped"));
+    logger->setLevel(Logger::LEVEL_ALL);
+
+    RSCINFO(logger, "info");
+    RSCWARN(logger, "warn");
+    RSCERROR_EXPECT(false, logger, "error");
+    RSCFATAL(logger, "fatal");
+
+    ASSERT_EQ(size_t(4), logger->logs.size());
+    EXPECT_EQ(Logger::LEVEL_INFO, logger->logs[0].first);
+    EXPECT_EQ("info", logger->logs[0].second);
+    EXPECT_EQ(Logger::LEVEL_WARN, logger->logs[1].first);
+    EXPECT_EQ(Logger::LEVEL_ERROR, logger->logs[2].first);
+    EXPECT_EQ(Logger::LEVEL_FATAL, logger->logs[3].first);
+
+}
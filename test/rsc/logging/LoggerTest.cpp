@@ -24,6 +24,7 @@
  *
  * ============================================================ */
 
+#include <iomanip>
 #include <stdexcept>
 #include <vector>
 
@@ -149,3 +150,141 @@ TEST(LoggerTest, testAssertionMacros) {
     EXPECT_EQ("false6\nfailed condition: false", logger->logCalls[5].second);
 
 }
+
+TEST(LoggerTest, testMessageBufferSpillOver) {
+
+    boost::shared_ptr<StoringLogger> logger(new StoringLogger);
+
+    const string longMessage(3 * MessageBuffer::CAPACITY + 17, 'x');
+    RSCINFO(logger, "a" << longMessage << "b");
+    RSCINFO(logger, "short " << 42);
+
+    ASSERT_EQ(size_t(2), logger->logCalls.size());
+    EXPECT_EQ("a" + longMessage + "b", logger->logCalls[0].second);
+    EXPECT_EQ("short 42", logger->logCalls[1].second);
+
+}
+
+/**
+ * Logs while being formatted into a log message.
+ */
+struct SelfLogging {
+    boost::shared_ptr<StoringLogger> logger;
+};
+
+ostream& operator<<(ostream& stream, const SelfLogging& object) {
+    RSCINFO(object.logger, "nested " << 1);
+    return stream << "outer";
+}
+
+TEST(LoggerTest, testMessageBufferNested) {
+
+    SelfLogging object;
+    object.logger.reset(new StoringLogger);
+
+    RSCINFO(object.logger, "before " << object << " after");
+
+    ASSERT_EQ(size_t(2), object.logger->logCalls.size());
+    EXPECT_EQ("nested 1", object.logger->logCalls[0].second);
+    EXPECT_EQ("before outer after", object.logger->logCalls[1].second);
+
+}
+
+TEST(LoggerTest, testMessageBufferResetsFormat) {
+
+    boost::shared_ptr<StoringLogger> logger(new StoringLogger);
+
+    RSCINFO(logger, hex << setfill('0') << setw(4) << 255);
+    RSCINFO(logger, 255 << " " << 1.23456789);
+
+    ASSERT_EQ(size_t(2), logger->logCalls.size());
+    EXPECT_EQ("00ff", logger->logCalls[0].second);
+    EXPECT_EQ("255 1.23457", logger->logCalls[1].second);
+
+}
+
+/**
+ * Records the call sites passed by the logging macros.
+ *
+ * @author jwienke
+ */
+class CallSiteRecordingLogger: public StubLogger {
+public:
+
+    CallSiteRecordingLogger() :
+            StubLogger("sites") {
+        setLevel(LEVEL_ALL);
+    }
+
+    void logAt(const Level& level, const CallSite& site, const char* msg,
+            const size_t& length) {
+        sites.push_back(&site);
+        logView(level, msg, length);
+    }
+
+    vector<const CallSite*> sites;
+
+};
+
+TEST(LoggerTest, testCallSites) {
+
+    boost::shared_ptr<CallSiteRecordingLogger> logger(
+            new CallSiteRecordingLogger);
+
+    const unsigned int line = __LINE__ + 2;
+    for (unsigned int i = 0; i < 2; ++i) {
+        RSCINFO(logger, "first");
+        RSCDEBUG_EXPECT(false, logger, "second");
+    }
+
+    ASSERT_EQ(size_t(4), logger->sites.size());
+    EXPECT_EQ(size_t(4), logger->logs.size());
+    EXPECT_EQ(logger->sites[0], logger->sites[2]);
+    EXPECT_EQ(logger->sites[1], logger->sites[3]);
+    EXPECT_NE(logger->sites[0]->getId(), logger->sites[1]->getId());
+    EXPECT_NE(CallSite::UNKNOWN_ID, logger->sites[0]->getId());
+    EXPECT_LE(logger->sites[1]->getId(), CallSite::getMaxId());
+
+    EXPECT_EQ(string(__FILE__), logger->sites[0]->getFile());
+    EXPECT_EQ(line, logger->sites[0]->getLine());
+    EXPECT_EQ(line + 1, logger->sites[1]->getLine());
+    EXPECT_EQ(make_pair(string(__FILE__), line + 1),
+            CallSite::getLocation(logger->sites[1]->getId()));
+    EXPECT_THROW(CallSite::getLocation(CallSite::UNKNOWN_ID), out_of_range);
+
+}
+
+/**
+ * Overrides only level-based functions and level checks like loggers
+ * written before the macros used #logAt.
+ */
+class LevelMethodLogger: public StoringLogger {
+public:
+
+    virtual void info(const string& msg) {
+        infos.push_back(msg);
+    }
+
+    virtual bool isDebugEnabled() const {
+        return false;
+    }
+
+    vector<string> infos;
+
+};
+
+TEST(LoggerTest, testMacrosUseLevelMethods) {
+
+    boost::shared_ptr<LevelMethodLogger> logger(new LevelMethodLogger);
+
+    RSCINFO(logger, "info " << 1);
+    RSCDEBUG(logger, "debug");
+    RSCWARN(logger, "warn");
+
+    ASSERT_EQ(size_t(1), logger->infos.size());
+    EXPECT_EQ("info 1", logger->infos[0]);
+    ASSERT_EQ(size_t(1), logger->logCalls.size());
+    EXPECT_EQ(Logger::LEVEL_WARN, logger->logCalls[0].first);
+    EXPECT_EQ("warn", logger->logCalls[0].second);
+
+}
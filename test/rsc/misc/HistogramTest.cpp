@@ -0,0 +1,157 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "rsc/misc/Histogram.h"
+
+using namespace std;
+using namespace rsc::misc;
+
+TEST(HistogramTest, testEmpty)
+{
+    Histogram histogram;
+    EXPECT_EQ((boost::uint64_t) 0, histogram.getCount());
+    EXPECT_EQ((boost::uint64_t) 0, histogram.getMin());
+    EXPECT_EQ((boost::uint64_t) 0, histogram.getMax());
+    EXPECT_EQ(0.0, histogram.getMean());
+    EXPECT_EQ((boost::uint64_t) 0, histogram.getQuantile(0.5));
+}
+
+TEST(HistogramTest, testBuckets)
+{
+    EXPECT_EQ(0u, Histogram::bucketFor(0));
+    EXPECT_EQ(1u, Histogram::bucketFor(1));
+    EXPECT_EQ(2u, Histogram::bucketFor(2));
+    EXPECT_EQ(2u, Histogram::bucketFor(3));
+    EXPECT_EQ(3u, Histogram::bucketFor(4));
+    EXPECT_EQ(11u, Histogram::bucketFor(1024));
+    EXPECT_EQ(Histogram::BUCKETS - 1,
+            Histogram::bucketFor(~boost::uint64_t(0)));
+
+    for (unsigned int i = 1; i < Histogram::BUCKETS - 1; ++i) {
+        EXPECT_EQ(i, Histogram::bucketFor(Histogram::getBucketUpperBound(i)));
+        EXPECT_EQ(i + 1,
+                Histogram::bucketFor(Histogram::getBucketUpperBound(i) + 1));
+    }
+
+    EXPECT_THROW(Histogram::getBucketUpperBound(Histogram::BUCKETS),
+            out_of_range);
+    Histogram histogram;
+    EXPECT_THROW(histogram.getBucketCount(Histogram::BUCKETS), out_of_range);
+}
+
+TEST(HistogramTest, testRecord)
+{
+    Histogram histogram;
+    for (boost::uint64_t i = 1; i <= 100; ++i) {
+        histogram.record(i);
+    }
+    EXPECT_EQ((boost::uint64_t) 100, histogram.getCount());
+    EXPECT_EQ((boost::uint64_t) 1, histogram.getMin());
+    EXPECT_EQ((boost::uint64_t) 100, histogram.getMax());
+    EXPECT_DOUBLE_EQ(50.5, histogram.getMean());
+    EXPECT_EQ((boost::uint64_t) 1, histogram.getBucketCount(1));
+    EXPECT_EQ((boost::uint64_t) 2, histogram.getBucketCount(2));
+    EXPECT_EQ((boost::uint64_t) 37, histogram.getBucketCount(7));
+
+    // quantiles are bucket upper bounds
+    EXPECT_EQ((boost::uint64_t) 63, histogram.getQuantile(0.5));
+    EXPECT_EQ((boost::uint64_t) 100, histogram.getQuantile(0.99));
+    EXPECT_EQ((boost::uint64_t) 100, histogram.getQuantile(1.0));
+    EXPECT_EQ((boost::uint64_t) 1, histogram.getQuantile(0.0));
+
+    histogram.clear();
+    EXPECT_EQ((boost::uint64_t) 0, histogram.getCount());
+    EXPECT_EQ((boost::uint64_t) 0, histogram.getBucketCount(7));
+}
+
+TEST(HistogramTest, testMerge)
+{
+    Histogram a;
+    Histogram b;
+    a.record(10);
+    a.record(20);
+    b.record(5);
+    b.record(1000);
+
+    Histogram empty;
+    a.merge(empty);
+    EXPECT_EQ((boost::uint64_t) 2, a.getCount());
+
+    a.merge(b);
+    EXPECT_EQ((boost::uint64_t) 4, a.getCount());
+    EXPECT_EQ((boost::uint64_t) 5, a.getMin());
+    EXPECT_EQ((boost::uint64_t) 1000, a.getMax());
+    EXPECT_DOUBLE_EQ(1035.0 / 4, a.getMean());
+
+    empty.merge(b);
+    EXPECT_EQ((boost::uint64_t) 5, empty.getMin());
+}
+
+TEST(HistogramTest, testPrecision)
+{
+    const unsigned int precision = 2;
+    const unsigned int subBuckets = 1 << precision;
+
+    // exact buckets for small values
+    for (unsigned int i = 0; i < subBuckets; ++i) {
+        EXPECT_EQ(i, Histogram::bucketFor(i, precision));
+        EXPECT_EQ((boost::uint64_t) i,
+                Histogram::getBucketUpperBound(i, precision));
+    }
+
+    // every value lies within its bucket and the relative error is bounded
+    boost::uint64_t previousBound = subBuckets - 1;
+    for (unsigned int i = subBuckets; i < Histogram::numBuckets(precision);
+            ++i) {
+        const boost::uint64_t bound = Histogram::getBucketUpperBound(i,
+                precision);
+        const boost::uint64_t lower = previousBound + 1;
+        EXPECT_EQ(i, Histogram::bucketFor(lower, precision));
+        EXPECT_EQ(i, Histogram::bucketFor(bound, precision));
+        EXPECT_LE(double(bound - lower), double(lower) / subBuckets);
+        previousBound = bound;
+    }
+    EXPECT_EQ(Histogram::numBuckets(precision) - 1,
+            Histogram::bucketFor(~boost::uint64_t(0), precision));
+
+    Histogram histogram(precision);
+    EXPECT_EQ(precision, histogram.getPrecision());
+    for (boost::uint64_t i = 1; i <= 100; ++i) {
+        histogram.record(i);
+    }
+    // 48 .. 55 share a bucket
+    EXPECT_EQ((boost::uint64_t) 55, histogram.getQuantile(0.5));
+    EXPECT_THROW(histogram.getBucketCount(Histogram::numBuckets(precision)),
+            out_of_range);
+
+    Histogram coarse;
+    EXPECT_THROW(coarse.merge(histogram), invalid_argument);
+    EXPECT_THROW(Histogram(Histogram::MAX_PRECISION + 1), invalid_argument);
+}
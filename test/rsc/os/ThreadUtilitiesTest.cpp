@@ -0,0 +1,120 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/misc/UnsupportedOperationException.h"
+#include "rsc/os/ThreadUtilities.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace rsc::os;
+
+class WaitingThread {
+public:
+
+    WaitingThread() :
+            released(false) {
+    }
+
+    void run() {
+        boost::mutex::scoped_lock lock(mutex);
+        while (!released) {
+            condition.wait(lock);
+        }
+#ifdef __linux__
+        cpu = sched_getcpu();
+        char buffer[16];
+        pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+        name = buffer;
+#endif
+    }
+
+    void release() {
+        boost::mutex::scoped_lock lock(mutex);
+        released = true;
+        condition.notify_all();
+    }
+
+    boost::mutex mutex;
+    boost::condition_variable condition;
+    bool released;
+    int cpu;
+    string name;
+
+};
+
+TEST(ThreadUtilitiesTest, testAffinity)
+{
+    WaitingThread waiting;
+    boost::thread thread(boost::bind(&WaitingThread::run, &waiting));
+
+    EXPECT_THROW(setThreadAffinity(thread, vector<unsigned int>()),
+            invalid_argument);
+
+    try {
+        setThreadAffinity(thread, vector<unsigned int>(1, 0));
+        waiting.release();
+        thread.join();
+#ifdef __linux__
+        EXPECT_EQ(0, waiting.cpu);
+#endif
+    } catch (const rsc::misc::UnsupportedOperationException& e) {
+        // not available on all platforms
+        waiting.release();
+        thread.join();
+    }
+}
+
+TEST(ThreadUtilitiesTest, testName)
+{
+    WaitingThread waiting;
+    boost::thread thread(boost::bind(&WaitingThread::run, &waiting));
+
+    setThreadName(thread, "a-very-long-thread-name");
+    waiting.release();
+    thread.join();
+#ifdef __linux__
+    EXPECT_EQ("a-very-long-thr", waiting.name);
+#endif
+}
+
+TEST(ThreadUtilitiesTest, testNumaNode)
+{
+    // every machine has at least one node
+    EXPECT_EQ(0u, numaNodeOfCpu(0));
+}
@@ -0,0 +1,150 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/threading/CycleStatistics.h"
+
+using namespace std;
+using namespace rsc::threading;
+using namespace testing;
+
+TEST(CycleStatisticsTest, testEmpty)
+{
+    CycleStatisticsRecorder recorder;
+    CycleStatistics statistics = recorder.snapshot();
+    EXPECT_EQ(boost::uint64_t(0), statistics.getCount());
+    EXPECT_EQ(boost::uint64_t(0), statistics.getLast());
+    EXPECT_EQ(boost::uint64_t(0), statistics.getMin());
+    EXPECT_EQ(boost::uint64_t(0), statistics.getMax());
+    EXPECT_EQ(0.0, statistics.getMean());
+    EXPECT_EQ(boost::uint64_t(0), statistics.getOverruns());
+    EXPECT_EQ(boost::uint64_t(0), statistics.getQuantile(0.5));
+}
+
+TEST(CycleStatisticsTest, testBuckets)
+{
+
+    // exact buckets for small values
+    for (unsigned int i = 0; i < CycleStatistics::SUB_BUCKETS; ++i) {
+        EXPECT_EQ(i, CycleStatistics::bucketFor(i));
+        EXPECT_EQ(boost::uint64_t(i), CycleStatistics::getBucketUpperBound(i));
+    }
+
+    // every value lies within its bucket and the relative error is bounded
+    boost::uint64_t previousBound = CycleStatistics::SUB_BUCKETS - 1;
+    for (unsigned int i = CycleStatistics::SUB_BUCKETS;
+            i < CycleStatistics::BUCKETS; ++i) {
+        const boost::uint64_t bound = CycleStatistics::getBucketUpperBound(i);
+        const boost::uint64_t lower = previousBound + 1;
+        EXPECT_EQ(i, CycleStatistics::bucketFor(lower));
+        EXPECT_EQ(i, CycleStatistics::bucketFor(bound));
+        EXPECT_LE(double(bound - lower),
+                double(lower) / CycleStatistics::SUB_BUCKETS);
+        previousBound = bound;
+    }
+
+    EXPECT_EQ(CycleStatistics::BUCKETS - 1,
+            CycleStatistics::bucketFor(~boost::uint64_t(0)));
+    EXPECT_THROW(CycleStatistics::getBucketUpperBound(CycleStatistics::BUCKETS),
+            std::out_of_range);
+
+}
+
+TEST(CycleStatisticsTest, testRecord)
+{
+
+    CycleStatisticsRecorder recorder;
+    recorder.setBudget(1000);
+    EXPECT_EQ(boost::uint64_t(1000), recorder.getBudget());
+
+    for (unsigned int i = 1; i <= 100; ++i) {
+        recorder.record(i * 20);
+    }
+    recorder.record(500);
+
+    CycleStatistics statistics = recorder.snapshot();
+    EXPECT_EQ(boost::uint64_t(101), statistics.getCount());
+    EXPECT_EQ(boost::uint64_t(500), statistics.getLast());
+    EXPECT_EQ(boost::uint64_t(20), statistics.getMin());
+    EXPECT_EQ(boost::uint64_t(2000), statistics.getMax());
+    EXPECT_DOUBLE_EQ((101000.0 + 500.0) / 101.0, statistics.getMean());
+    // 1020 .. 2000
+    EXPECT_EQ(boost::uint64_t(50), statistics.getOverruns());
+    // 480 and twice 500 share a bucket of width 32
+    EXPECT_EQ(boost::uint64_t(3),
+            statistics.getBucketCount(CycleStatistics::bucketFor(500)));
+
+    EXPECT_EQ(boost::uint64_t(2000), statistics.getQuantile(1.0));
+    EXPECT_EQ(boost::uint64_t(21), statistics.getQuantile(0.0));
+    const boost::uint64_t median = statistics.getQuantile(0.5);
+    EXPECT_GE(median, boost::uint64_t(1000));
+    EXPECT_LE(median,
+            boost::uint64_t(1000 + 1000 / CycleStatistics::SUB_BUCKETS));
+
+}
+
+TEST(CycleStatisticsTest, testNoOverrunsWithoutBudget)
+{
+    CycleStatisticsRecorder recorder;
+    recorder.record(1000000);
+    EXPECT_EQ(boost::uint64_t(0), recorder.snapshot().getOverruns());
+}
+
+/**
+ * Records the same value until @a stop is set.
+ */
+void recordConstantly(CycleStatisticsRecorder& recorder,
+        volatile bool& stop) {
+    while (!stop) {
+        recorder.record(42);
+    }
+}
+
+TEST(CycleStatisticsTest, testConsistentSnapshots)
+{
+
+    CycleStatisticsRecorder recorder;
+    volatile bool stop = false;
+    boost::thread writer(
+            boost::bind(&recordConstantly, boost::ref(recorder),
+                    boost::ref(stop)));
+
+    for (unsigned int i = 0; i < 1000; ++i) {
+        CycleStatistics statistics = recorder.snapshot();
+        ASSERT_EQ(statistics.getCount(),
+                statistics.getBucketCount(CycleStatistics::bucketFor(42)));
+        ASSERT_EQ(statistics.getCount() * 42, statistics.getMean()
+                * statistics.getCount());
+    }
+
+    stop = true;
+    writer.join();
+
+}
@@ -27,12 +27,16 @@
 #include <iostream>
 
 #include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/move/unique_ptr.hpp>
 #include <boost/thread.hpp>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "rsc/misc/IllegalStateException.h"
 #include "rsc/threading/Future.h"
+#include "rsc/threading/ThreadedTaskExecutor.h"
 
 using namespace std;
 using namespace rsc::threading;
@@ -114,3 +118,202 @@ TEST(FutureTest, testTimeout)
     Future<int> f;
     EXPECT_THROW(f.get(0.3), FutureTimeoutException);
 }
+
+TEST(FutureTest, testFractionalTimeout)
+{
+    Future<int> f;
+    boost::posix_time::ptime start =
+            boost::posix_time::microsec_clock::universal_time();
+    EXPECT_THROW(f.get(0.2), FutureTimeoutException);
+    EXPECT_GE(boost::posix_time::microsec_clock::universal_time() - start,
+            boost::posix_time::milliseconds(190));
+}
+
+TEST(FutureTest, testCompleteOnlyOnce)
+{
+    Future<int> f;
+    f.set(1);
+    EXPECT_THROW(f.set(2), rsc::misc::IllegalStateException);
+    EXPECT_THROW(f.setError("damn"), rsc::misc::IllegalStateException);
+    EXPECT_EQ(1, f.get());
+}
+
+TEST(FutureTest, testOriginalException)
+{
+    Future<int> f;
+    f.setError(boost::copy_exception(invalid_argument("bad")));
+    EXPECT_TRUE(f.isDone());
+    EXPECT_THROW(f.get(), invalid_argument);
+    EXPECT_THROW(f.get(1.0), invalid_argument);
+}
+
+TEST(FutureTest, testMoveOnlyResult)
+{
+    typedef boost::movelib::unique_ptr<int> Pointer;
+    Future<Pointer> f;
+    Pointer value(new int(42));
+    f.set(boost::move(value));
+    Pointer result = f.take();
+    ASSERT_TRUE(bool(result));
+    EXPECT_EQ(42, *result);
+    EXPECT_THROW(f.take(), rsc::misc::IllegalStateException);
+}
+
+/**
+ * Records the outcome of completed futures.
+ *
+ * @author jwienke
+ */
+class CallbackRecorder {
+public:
+
+    CallbackRecorder() :
+            calls(0), value(0), failed(false) {
+    }
+
+    void completed(Future<int>& future) {
+        boost::mutex::scoped_lock lock(mutex);
+        try {
+            value = future.get();
+        } catch (const FutureTaskExecutionException& e) {
+            failed = true;
+        }
+        thread = boost::this_thread::get_id();
+        ++calls;
+        condition.notify_all();
+    }
+
+    void waitForCalls(const unsigned int& count) {
+        boost::mutex::scoped_lock lock(mutex);
+        while (calls < count) {
+            condition.wait(lock);
+        }
+    }
+
+    boost::mutex mutex;
+    boost::condition condition;
+    unsigned int calls;
+    int value;
+    bool failed;
+    boost::thread::id thread;
+
+};
+
+TEST(FutureTest, testCallback)
+{
+
+    CallbackRecorder before;
+    CallbackRecorder after;
+    {
+        Future<int> f;
+        f.addCallback(boost::bind(&CallbackRecorder::completed, &before, _1));
+        EXPECT_EQ(0u, before.calls);
+        f.set(42);
+        f.addCallback(boost::bind(&CallbackRecorder::completed, &after, _1));
+    }
+    EXPECT_EQ(1u, before.calls);
+    EXPECT_EQ(42, before.value);
+    EXPECT_EQ(1u, after.calls);
+    EXPECT_EQ(42, after.value);
+
+    CallbackRecorder error;
+    Future<int> f;
+    f.addCallback(boost::bind(&CallbackRecorder::completed, &error, _1));
+    f.setError("damn");
+    EXPECT_TRUE(error.failed);
+
+}
+
+TEST(FutureTest, testCallbackOnExecutor)
+{
+
+    TaskExecutorPtr executor(new ThreadedTaskExecutor);
+    CallbackRecorder recorder;
+    {
+        Future<int> f;
+        f.addCallback(boost::bind(&CallbackRecorder::completed, &recorder, _1),
+                executor);
+        f.set(42);
+        // the future may be gone before the callback runs
+    }
+    recorder.waitForCalls(1);
+    EXPECT_EQ(42, recorder.value);
+    EXPECT_NE(boost::this_thread::get_id(), recorder.thread);
+
+}
+
+int increment(Future<int>& future) {
+    return future.get() + 1;
+}
+
+string describe(Future<int>& future) {
+    return boost::lexical_cast<string>(future.get());
+}
+
+TEST(FutureTest, testThen)
+{
+
+    TaskExecutorPtr executor(new ThreadedTaskExecutor);
+    boost::shared_ptr<Future<int> > f(new Future<int>);
+    boost::shared_ptr<Future<string> > chained = f->then<int>(&increment,
+            executor)->then<string>(&describe);
+    EXPECT_FALSE(chained->isDone());
+    f->set(41);
+    EXPECT_EQ("42", chained->get(1.0));
+
+    boost::shared_ptr<Future<int> > failing(new Future<int>);
+    boost::shared_ptr<Future<int> > next = failing->then<int>(&increment,
+            executor);
+    failing->setError(boost::copy_exception(out_of_range("damn")));
+    EXPECT_THROW(next->get(1.0), out_of_range);
+
+}
+
+TEST(FutureTest, testWhenAll)
+{
+
+    vector<boost::shared_ptr<Future<int> > > futures;
+    for (int i = 0; i < 3; ++i) {
+        futures.push_back(boost::shared_ptr<Future<int> >(new Future<int>));
+    }
+    boost::shared_ptr<Future<vector<int> > > all = whenAll(futures);
+    futures[2]->set(2);
+    futures[0]->set(0);
+    EXPECT_FALSE(all->isDone());
+    futures[1]->set(1);
+    vector<int> results = all->get(1.0);
+    ASSERT_EQ(size_t(3), results.size());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(i, results[i]);
+    }
+
+    EXPECT_TRUE(whenAll(vector<boost::shared_ptr<Future<int> > >())->isDone());
+
+    futures.clear();
+    for (int i = 0; i < 2; ++i) {
+        futures.push_back(boost::shared_ptr<Future<int> >(new Future<int>));
+    }
+    all = whenAll(futures);
+    futures[0]->setError("damn");
+    EXPECT_THROW(all->get(1.0), FutureTaskExecutionException);
+    futures[1]->setError("again");
+
+}
+
+TEST(FutureTest, testWhenAny)
+{
+
+    EXPECT_THROW(whenAny(vector<boost::shared_ptr<Future<int> > >()),
+            invalid_argument);
+
+    vector<boost::shared_ptr<Future<int> > > futures;
+    for (int i = 0; i < 3; ++i) {
+        futures.push_back(boost::shared_ptr<Future<int> >(new Future<int>));
+    }
+    boost::shared_ptr<Future<size_t> > any = whenAny(futures);
+    EXPECT_FALSE(any->isDone());
+    futures[1]->setError("damn");
+    futures[2]->set(2);
+    EXPECT_EQ(size_t(1), any->get(1.0));
+
+}
@@ -32,11 +32,15 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <boost/atomic.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/thread.hpp>
+#include <boost/weak_ptr.hpp>
 
 #include <gtest/gtest.h>
 
+#include "rsc/misc/UnsupportedOperationException.h"
+#include "rsc/misc/langutils.h"
 #include "rsc/threading/OrderedQueueDispatcherPool.h"
 
 using namespace std;
@@ -489,3 +493,1221 @@ TEST(OrderedQueueDispatcherPoolTest, testSequencedDispatchToOneReceiver)
     EXPECT_FALSE(receiver->calledInParallel);
 
 }
+
+TEST(OrderedQueueDispatcherPoolTest, testManyReceivers)
+{
+
+    const unsigned int numMessages = 20;
+    OrderedQueueDispatcherPool<int, StubReceiver> pool(
+            4,
+            OrderedQueueDispatcherPool<int, StubReceiver>::DeliveryHandlerPtr(
+                    new DeliveryHandler));
+
+    const unsigned int numReceivers = 1000;
+    vector<boost::shared_ptr<StubReceiver> > receivers;
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        boost::shared_ptr<StubReceiver> r(new StubReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    pool.start();
+
+    for (unsigned int i = 0; i < numMessages; ++i) {
+        pool.push(i);
+    }
+
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->messages.size() < numMessages) {
+            receivers[i]->condition.wait(lock);
+        }
+    }
+
+    pool.stop();
+
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        ASSERT_EQ(numMessages, receivers[i]->messages.size());
+        for (unsigned int expected = 0; expected < numMessages; ++expected) {
+            EXPECT_EQ((int) expected, receivers[i]->messages[expected]) << "Receiver " << i << " unordered";
+        }
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testWorkStealingOrdering)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    const unsigned int numMessages = 50;
+    Pool pool(4, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    pool.setSchedulingMode(Pool::SCHEDULING_WORK_STEALING);
+    EXPECT_EQ(Pool::SCHEDULING_WORK_STEALING, pool.getSchedulingMode());
+
+    // receivers registered before and after the scheduling mode was set
+    const unsigned int numReceivers = 100;
+    vector<boost::shared_ptr<StubReceiver> > receivers;
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        boost::shared_ptr<StubReceiver> r(new StubReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    pool.start();
+    EXPECT_THROW(pool.setSchedulingMode(Pool::SCHEDULING_SHARED),
+            ::rsc::misc::IllegalStateException);
+
+    for (unsigned int i = 0; i < numMessages; ++i) {
+        pool.push(i);
+    }
+
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->messages.size() < numMessages) {
+            receivers[i]->condition.wait(lock);
+        }
+    }
+
+    pool.stop();
+
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        ASSERT_EQ(numMessages, receivers[i]->messages.size());
+        for (unsigned int expected = 0; expected < numMessages; ++expected) {
+            EXPECT_EQ((int) expected, receivers[i]->messages[expected]) << "Receiver " << i << " unordered";
+        }
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testWorkStealingSequencedDispatch)
+{
+
+    OrderedQueueDispatcherPool<int, ParallelReceiver> pool(2,
+                boost::bind(parallelDeliver, _1, _2));
+    pool.setSchedulingMode(
+            OrderedQueueDispatcherPool<int, ParallelReceiver>::SCHEDULING_WORK_STEALING);
+
+    pool.start();
+
+    boost::shared_ptr<ParallelReceiver> receiver(new ParallelReceiver);
+    pool.registerReceiver(receiver);
+
+    pool.push(42);
+    pool.push(43);
+
+    boost::this_thread::sleep(boost::posix_time::seconds(4));
+
+    pool.stop();
+
+    EXPECT_FALSE(receiver->calledInParallel);
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testSharedLogOrdering)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    // spans several segments of the log
+    const unsigned int numMessages = 1000;
+    Pool pool(4, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    pool.setMessageStorage(Pool::STORAGE_SHARED_LOG);
+    EXPECT_EQ(Pool::STORAGE_SHARED_LOG, pool.getMessageStorage());
+
+    const unsigned int numReceivers = 50;
+    vector<boost::shared_ptr<StubReceiver> > receivers;
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        boost::shared_ptr<StubReceiver> r(new StubReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    pool.start();
+    EXPECT_THROW(pool.setMessageStorage(Pool::STORAGE_PER_RECEIVER),
+            ::rsc::misc::IllegalStateException);
+
+    for (unsigned int i = 0; i < numMessages; ++i) {
+        pool.push(i);
+    }
+
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->messages.size() < numMessages) {
+            receivers[i]->condition.wait(lock);
+        }
+    }
+
+    // a receiver registered now only gets new messages
+    boost::shared_ptr<StubReceiver> late(new StubReceiver);
+    pool.registerReceiver(late);
+    pool.push(numMessages);
+    {
+        boost::mutex::scoped_lock lock(late->mutex);
+        while (late->messages.size() < 1) {
+            late->condition.wait(lock);
+        }
+    }
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->messages.size() < numMessages + 1) {
+            receivers[i]->condition.wait(lock);
+        }
+    }
+
+    pool.stop();
+
+    ASSERT_EQ((size_t) 1, late->messages.size());
+    EXPECT_EQ((int) numMessages, late->messages[0]);
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        ASSERT_EQ(numMessages + 1, receivers[i]->messages.size());
+        for (unsigned int expected = 0; expected <= numMessages; ++expected) {
+            EXPECT_EQ((int) expected, receivers[i]->messages[expected]) << "Receiver " << i << " unordered";
+        }
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testSharedLogStorageSwitch)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(2, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+    pool.registerReceiver(receiver);
+
+    // messages pushed before any switch must keep their order
+    const int messagesPerPhase = 300;
+    int next = 0;
+    for (int phase = 0; phase < 4; ++phase) {
+        pool.setMessageStorage(
+                phase % 2 == 0 ? Pool::STORAGE_SHARED_LOG
+                        : Pool::STORAGE_PER_RECEIVER);
+        for (int i = 0; i < messagesPerPhase; ++i) {
+            pool.push(next++);
+        }
+    }
+
+    pool.start();
+    {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        while (receiver->messages.size() < (size_t) next) {
+            receiver->condition.wait(lock);
+        }
+    }
+    pool.stop();
+
+    ASSERT_EQ((size_t) next, receiver->messages.size());
+    for (int expected = 0; expected < next; ++expected) {
+        EXPECT_EQ(expected, receiver->messages[expected]);
+    }
+
+}
+
+class SharedMessageReceiver {
+public:
+    boost::mutex mutex;
+    boost::condition condition;
+    unsigned int count;
+    SharedMessageReceiver() :
+            count(0) {
+    }
+};
+
+void sharedMessageDeliver(boost::shared_ptr<SharedMessageReceiver>& receiver,
+        const boost::shared_ptr<int>& /*message*/) {
+    boost::mutex::scoped_lock lock(receiver->mutex);
+    ++receiver->count;
+    receiver->condition.notify_all();
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testSharedLogReleasesMessages)
+{
+
+    typedef OrderedQueueDispatcherPool<boost::shared_ptr<int>,
+            SharedMessageReceiver> Pool;
+
+    Pool pool(2, boost::bind(sharedMessageDeliver, _1, _2));
+    pool.setMessageStorage(Pool::STORAGE_SHARED_LOG);
+
+    vector<boost::shared_ptr<SharedMessageReceiver> > receivers;
+    for (unsigned int i = 0; i < 10; ++i) {
+        boost::shared_ptr<SharedMessageReceiver> r(new SharedMessageReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    boost::weak_ptr<int> first;
+    {
+        boost::shared_ptr<int> message(new int(42));
+        first = message;
+        pool.push(message);
+    }
+    EXPECT_FALSE(first.expired());
+
+    // enough messages to move all receivers past the first segment
+    const unsigned int numMessages = 1000;
+    for (unsigned int i = 1; i < numMessages; ++i) {
+        pool.push(boost::shared_ptr<int>(new int(i)));
+    }
+
+    pool.start();
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->count < numMessages) {
+            receivers[i]->condition.wait(lock);
+        }
+    }
+    pool.stop();
+
+    EXPECT_TRUE(first.expired());
+
+}
+
+/**
+ * A message without default constructor which counts how often it is
+ * copied.
+ */
+class CountedMessage {
+public:
+
+    static boost::atomic<unsigned int> copies;
+
+    explicit CountedMessage(const int& value) :
+            value(value) {
+    }
+
+    CountedMessage(const CountedMessage& other) :
+            value(other.value) {
+        ++copies;
+    }
+
+    CountedMessage& operator=(const CountedMessage& other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    CountedMessage(CountedMessage&& other) :
+            value(other.value) {
+    }
+
+    CountedMessage& operator=(CountedMessage&& other) {
+        value = other.value;
+        return *this;
+    }
+#endif
+
+    int value;
+
+};
+
+boost::atomic<unsigned int> CountedMessage::copies(0);
+
+class CountedMessageHandler: public OrderedQueueDispatcherPool<CountedMessage,
+        StubReceiver>::DeliveryHandler {
+public:
+    void deliver(boost::shared_ptr<StubReceiver>& receiver,
+            const CountedMessage& message) {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        receiver->messages.push_back(message.value);
+        receiver->condition.notify_all();
+    }
+};
+
+class CountedBatchHandler: public OrderedQueueDispatcherPool<CountedMessage,
+        StubReceiver>::BatchDeliveryHandler {
+public:
+    void deliver(boost::shared_ptr<StubReceiver>& receiver,
+            const OrderedQueueDispatcherPool<CountedMessage,
+                    StubReceiver>::Batch& messages) {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        for (size_t i = 0; i < messages.size(); ++i) {
+            receiver->messages.push_back(messages[i].value);
+        }
+        receiver->condition.notify_all();
+    }
+};
+
+TEST(OrderedQueueDispatcherPoolTest, testMessagesAreNotCopiedInternally)
+{
+
+    typedef OrderedQueueDispatcherPool<CountedMessage, StubReceiver> Pool;
+
+    for (int batching = 0; batching <= 1; ++batching) {
+        for (int storage = Pool::STORAGE_PER_RECEIVER;
+                storage <= Pool::STORAGE_SHARED_LOG; ++storage) {
+
+            boost::shared_ptr<Pool> poolPtr;
+            if (batching) {
+                poolPtr.reset(new Pool(2,
+                        Pool::BatchDeliveryHandlerPtr(new CountedBatchHandler)));
+                poolPtr->setMaxBatchDelay(5);
+            } else {
+                poolPtr.reset(new Pool(2,
+                        Pool::DeliveryHandlerPtr(new CountedMessageHandler)));
+            }
+            Pool& pool = *poolPtr;
+            pool.setMessageStorage((Pool::MessageStorage) storage);
+            const unsigned int numReceivers = 3;
+            vector<boost::shared_ptr<StubReceiver> > receivers;
+            for (unsigned int i = 0; i < numReceivers; ++i) {
+                boost::shared_ptr<StubReceiver> r(new StubReceiver);
+                pool.registerReceiver(r);
+                receivers.push_back(r);
+            }
+            pool.start();
+
+            CountedMessage::copies = 0;
+            const int numMessages = 100;
+            for (int i = 0; i < numMessages; ++i) {
+                pool.push(CountedMessage(i));
+            }
+            for (unsigned int i = 0; i < receivers.size(); ++i) {
+                boost::mutex::scoped_lock lock(receivers[i]->mutex);
+                while (receivers[i]->messages.size() < (size_t) numMessages) {
+                    receivers[i]->condition.wait(lock);
+                }
+            }
+            pool.stop();
+
+            // one stored copy per receiver or one for all of them
+            EXPECT_EQ(storage == Pool::STORAGE_SHARED_LOG ?
+                            unsigned(numMessages) : numReceivers * numMessages,
+                    CountedMessage::copies.load());
+            for (unsigned int i = 0; i < receivers.size(); ++i) {
+                for (int expected = 0; expected < numMessages; ++expected) {
+                    EXPECT_EQ(expected, receivers[i]->messages[expected]);
+                }
+            }
+
+        }
+    }
+
+}
+
+class BatchReceiver {
+public:
+    boost::mutex mutex;
+    boost::condition condition;
+    vector<int> messages;
+    vector<size_t> batchSizes;
+};
+
+class BatchHandler: public OrderedQueueDispatcherPool<int, BatchReceiver>::BatchDeliveryHandler {
+public:
+    void deliver(boost::shared_ptr<BatchReceiver>& receiver,
+            const OrderedQueueDispatcherPool<int,
+                    BatchReceiver>::Batch& messages) {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        receiver->messages.insert(receiver->messages.end(), messages.begin(),
+                messages.end());
+        receiver->batchSizes.push_back(messages.size());
+        receiver->condition.notify_all();
+    }
+};
+
+class OddBatchFilter: public OrderedQueueDispatcherPool<int, BatchReceiver>::FilterHandler {
+public:
+    bool filter(boost::shared_ptr<BatchReceiver>& /*receiver*/,
+            const int& message) {
+        return message % 2 == 1;
+    }
+};
+
+void waitForBatchMessages(boost::shared_ptr<BatchReceiver> receiver,
+        const size_t& count) {
+    boost::mutex::scoped_lock lock(receiver->mutex);
+    while (receiver->messages.size() < count) {
+        receiver->condition.wait(lock);
+    }
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testBatchDelivery)
+{
+
+    typedef OrderedQueueDispatcherPool<int, BatchReceiver> Pool;
+
+    for (int storage = Pool::STORAGE_PER_RECEIVER;
+            storage <= Pool::STORAGE_SHARED_LOG; ++storage) {
+
+        Pool pool(2, Pool::BatchDeliveryHandlerPtr(new BatchHandler));
+        pool.setMessageStorage((Pool::MessageStorage) storage);
+        EXPECT_THROW(pool.setMaxBatchSize(0), std::invalid_argument);
+        const size_t maxBatchSize = 7;
+        pool.setMaxBatchSize(maxBatchSize);
+
+        vector<boost::shared_ptr<BatchReceiver> > receivers;
+        for (unsigned int i = 0; i < 5; ++i) {
+            boost::shared_ptr<BatchReceiver> r(new BatchReceiver);
+            pool.registerReceiver(r);
+            receivers.push_back(r);
+        }
+
+        // pending before the start so that full batches can be formed
+        const int numMessages = 600;
+        for (int i = 0; i < numMessages; ++i) {
+            pool.push(i);
+        }
+        pool.start();
+
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            waitForBatchMessages(receivers[i], numMessages);
+        }
+        pool.stop();
+
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            ASSERT_EQ((size_t) numMessages, receivers[i]->messages.size());
+            for (int expected = 0; expected < numMessages; ++expected) {
+                EXPECT_EQ(expected, receivers[i]->messages[expected]);
+            }
+            EXPECT_EQ(maxBatchSize, receivers[i]->batchSizes.front());
+            for (unsigned int b = 0; b < receivers[i]->batchSizes.size(); ++b) {
+                EXPECT_LE(receivers[i]->batchSizes[b], maxBatchSize);
+                EXPECT_GT(receivers[i]->batchSizes[b], (size_t) 0);
+            }
+        }
+
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testBatchDeliveryDelay)
+{
+
+    typedef OrderedQueueDispatcherPool<int, BatchReceiver> Pool;
+
+    for (int storage = Pool::STORAGE_PER_RECEIVER;
+            storage <= Pool::STORAGE_SHARED_LOG; ++storage) {
+
+        Pool pool(1, Pool::BatchDeliveryHandlerPtr(new BatchHandler));
+        pool.setMessageStorage((Pool::MessageStorage) storage);
+        pool.setMaxBatchSize(4);
+        pool.setMaxBatchDelay(10000);
+
+        boost::shared_ptr<BatchReceiver> receiver(new BatchReceiver);
+        pool.registerReceiver(receiver);
+        pool.start();
+
+        // a full batch is delivered before the delay elapsed
+        for (int i = 0; i < 4; ++i) {
+            pool.push(i);
+            boost::this_thread::sleep(boost::posix_time::millisec(20));
+        }
+        waitForBatchMessages(receiver, 4);
+        EXPECT_EQ((size_t) 1, receiver->batchSizes.size());
+
+        // stopping does not wait for the delay to elapse
+        pool.push(4);
+        boost::this_thread::sleep(boost::posix_time::millisec(50));
+        const boost::uint64_t start = rsc::misc::currentTimeMillis();
+        pool.stop();
+        EXPECT_LT(rsc::misc::currentTimeMillis() - start, (boost::uint64_t) 5000);
+        waitForBatchMessages(receiver, 5);
+
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testBatchDeliveryFilter)
+{
+
+    typedef OrderedQueueDispatcherPool<int, BatchReceiver> Pool;
+
+    Pool pool(2, Pool::BatchDeliveryHandlerPtr(new BatchHandler),
+            Pool::FilterHandlerPtr(new OddBatchFilter));
+    boost::shared_ptr<BatchReceiver> receiver(new BatchReceiver);
+    pool.registerReceiver(receiver);
+
+    for (int i = 0; i < 100; ++i) {
+        pool.push(i);
+    }
+    pool.start();
+    waitForBatchMessages(receiver, 50);
+    pool.stop();
+
+    ASSERT_EQ((size_t) 50, receiver->messages.size());
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(2 * i + 1, receiver->messages[i]);
+    }
+
+}
+
+class OverflowRecorder {
+public:
+    boost::mutex mutex;
+    vector<int> messages;
+    void record(boost::shared_ptr<StubReceiver>& /*receiver*/,
+            const int& message) {
+        boost::mutex::scoped_lock lock(mutex);
+        messages.push_back(message);
+    }
+};
+
+TEST(OrderedQueueDispatcherPoolTest, testBoundedReceiverDropPolicies)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    for (int storage = Pool::STORAGE_PER_RECEIVER;
+            storage <= Pool::STORAGE_SHARED_LOG; ++storage) {
+
+        Pool pool(2, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+        pool.setMessageStorage((Pool::MessageStorage) storage);
+
+        const size_t capacity = 5;
+        boost::shared_ptr<StubReceiver> unbounded(new StubReceiver);
+        boost::shared_ptr<StubReceiver> dropOldest(new StubReceiver);
+        boost::shared_ptr<StubReceiver> dropNewest(new StubReceiver);
+        boost::shared_ptr<StubReceiver> callback(new StubReceiver);
+        OverflowRecorder recorder;
+        pool.registerReceiver(unbounded);
+        pool.registerReceiver(dropOldest, capacity, Pool::OVERFLOW_DROP_OLDEST);
+        pool.registerReceiver(dropNewest, capacity, Pool::OVERFLOW_DROP_NEWEST);
+        EXPECT_THROW(pool.registerReceiver(callback, capacity, Pool::OVERFLOW_CALLBACK),
+                std::invalid_argument);
+        pool.registerReceiver(callback, capacity, Pool::OVERFLOW_CALLBACK,
+                boost::bind(&OverflowRecorder::record, &recorder, _1, _2));
+
+        // not started, hence nothing is processed while pushing
+        const int numMessages = 20;
+        for (int i = 0; i < numMessages; ++i) {
+            pool.push(i);
+        }
+        pool.start();
+
+        for (unsigned int n = 0; n < 4; ++n) {
+            boost::shared_ptr<StubReceiver> r[] = { unbounded, dropOldest,
+                    dropNewest, callback };
+            const size_t expected = n == 0 ? numMessages : capacity;
+            boost::mutex::scoped_lock lock(r[n]->mutex);
+            while (r[n]->messages.size() < expected) {
+                r[n]->condition.wait(lock);
+            }
+        }
+        pool.stop();
+
+        ASSERT_EQ((size_t) numMessages, unbounded->messages.size());
+        ASSERT_EQ(capacity, dropOldest->messages.size());
+        ASSERT_EQ(capacity, dropNewest->messages.size());
+        ASSERT_EQ(capacity, callback->messages.size());
+        ASSERT_EQ(numMessages - capacity, recorder.messages.size());
+        for (int i = 0; i < (int) capacity; ++i) {
+            EXPECT_EQ(numMessages - (int) capacity + i, dropOldest->messages[i]);
+            EXPECT_EQ(i, dropNewest->messages[i]);
+            EXPECT_EQ(i, callback->messages[i]);
+        }
+        for (int i = 0; i < numMessages - (int) capacity; ++i) {
+            EXPECT_EQ((int) capacity + i, recorder.messages[i]);
+        }
+
+        EXPECT_EQ((boost::uint64_t) 0, pool.getReceiverStatistics(unbounded).dropped);
+        EXPECT_EQ((boost::uint64_t) numMessages - capacity,
+                pool.getReceiverStatistics(dropOldest).dropped);
+        EXPECT_EQ((boost::uint64_t) numMessages - capacity,
+                pool.getReceiverStatistics(dropNewest).dropped);
+        EXPECT_EQ((boost::uint64_t) numMessages - capacity,
+                pool.getReceiverStatistics(callback).dropped);
+        EXPECT_EQ((boost::uint64_t) 0, pool.getReceiverStatistics(callback).blocked);
+
+        EXPECT_TRUE(pool.unregisterReceiver(callback));
+        EXPECT_THROW(pool.getReceiverStatistics(callback), std::invalid_argument);
+
+    }
+
+}
+
+void pushRange(OrderedQueueDispatcherPool<int, StubReceiver>* pool,
+        const int from, const int to, volatile bool* done) {
+    for (int i = from; i < to; ++i) {
+        pool->push(i);
+    }
+    *done = true;
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testBoundedReceiverBlocks)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(2, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+    const size_t capacity = 3;
+    pool.registerReceiver(receiver, capacity, Pool::OVERFLOW_BLOCK);
+
+    const int numMessages = 50;
+    volatile bool done = false;
+    boost::thread pusher(boost::bind(pushRange, &pool, 0, numMessages, &done));
+
+    // the pool is not started, so the pusher cannot finish
+    boost::this_thread::sleep(boost::posix_time::millisec(200));
+    EXPECT_FALSE(done);
+    EXPECT_EQ((boost::uint64_t) 1, pool.getReceiverStatistics(receiver).blocked);
+
+    pool.start();
+    pusher.join();
+    EXPECT_TRUE(done);
+    {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        while (receiver->messages.size() < (size_t) numMessages) {
+            receiver->condition.wait(lock);
+        }
+    }
+    pool.stop();
+
+    for (int i = 0; i < numMessages; ++i) {
+        EXPECT_EQ(i, receiver->messages[i]);
+    }
+    EXPECT_EQ((boost::uint64_t) 0, pool.getReceiverStatistics(receiver).dropped);
+    EXPECT_GE(pool.getReceiverStatistics(receiver).blocked, (boost::uint64_t) 1);
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testBoundedReceiverUnregisterUnblocks)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(1, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+    pool.registerReceiver(receiver, 1, Pool::OVERFLOW_BLOCK);
+
+    volatile bool done = false;
+    boost::thread pusher(boost::bind(pushRange, &pool, 0, 10, &done));
+    boost::this_thread::sleep(boost::posix_time::millisec(100));
+    EXPECT_FALSE(done);
+
+    EXPECT_TRUE(pool.unregisterReceiver(receiver));
+    pusher.join();
+    EXPECT_TRUE(done);
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testBoundedReceiverBlockedPushersKeepOrder)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(1, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+    pool.registerReceiver(receiver, 1, Pool::OVERFLOW_BLOCK);
+    pool.push(0);
+
+    // block several pushers one after another on the full receiver
+    const int numPushers = 3;
+    volatile bool done[numPushers] = { false };
+    boost::thread_group pushers;
+    for (int i = 0; i < numPushers; ++i) {
+        pushers.create_thread(
+                boost::bind(pushRange, &pool, i + 1, i + 2, &done[i]));
+        boost::this_thread::sleep(boost::posix_time::millisec(50));
+    }
+    EXPECT_EQ((boost::uint64_t) numPushers,
+            pool.getReceiverStatistics(receiver).blocked);
+
+    // whenever space becomes available, the pusher which blocked first must
+    // get it
+    pool.start();
+    pushers.join_all();
+    {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        while (receiver->messages.size() < (size_t) numPushers + 1) {
+            receiver->condition.wait(lock);
+        }
+    }
+    pool.stop();
+
+    for (int i = 0; i <= numPushers; ++i) {
+        EXPECT_EQ(i, receiver->messages[i]);
+    }
+    EXPECT_EQ((boost::uint64_t) 0, pool.getReceiverStatistics(receiver).dropped);
+
+}
+
+bool oddFilter(boost::shared_ptr<StubReceiver>& /*receiver*/,
+        const int& message) {
+    return message % 2 == 1;
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testStatistics)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    for (int storage = Pool::STORAGE_PER_RECEIVER;
+            storage <= Pool::STORAGE_SHARED_LOG; ++storage) {
+
+        const unsigned int numWorkers = 2;
+        Pool pool(numWorkers, boost::bind(deliver, _1, _2),
+                boost::bind(oddFilter, _1, _2));
+        pool.setMessageStorage((Pool::MessageStorage) storage);
+        EXPECT_FALSE(pool.isStatisticsEnabled());
+        pool.setStatisticsEnabled(true);
+        EXPECT_TRUE(pool.isStatisticsEnabled());
+
+        StubReceiver::nextReceiverNum = 1;
+        boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+        pool.registerReceiver(receiver);
+
+        // pending before the start, hence the high-water mark is known
+        const int numMessages = 10;
+        for (int i = 0; i < numMessages; ++i) {
+            pool.push(i);
+        }
+        boost::this_thread::sleep(boost::posix_time::millisec(20));
+        pool.start();
+
+        {
+            boost::mutex::scoped_lock lock(receiver->mutex);
+            while (receiver->messages.size() < (size_t) numMessages / 2) {
+                receiver->condition.wait(lock);
+            }
+        }
+        pool.stop();
+
+        Pool::ReceiverStatistics statistics = pool.getReceiverStatistics(
+                receiver);
+        EXPECT_EQ((size_t) numMessages, statistics.highWaterMark);
+        EXPECT_EQ((boost::uint64_t) numMessages / 2, statistics.delivered);
+        EXPECT_EQ((boost::uint64_t) numMessages / 2, statistics.rejected);
+        EXPECT_EQ((boost::uint64_t) numMessages, statistics.latency.getCount());
+        EXPECT_GE(statistics.latency.getMin(), (boost::uint64_t) 20000);
+        EXPECT_EQ((boost::uint64_t) numMessages,
+                statistics.deliveryDuration.getCount());
+
+        vector<Pool::WorkerStatistics> workers = pool.getWorkerStatistics();
+        ASSERT_EQ((size_t) numWorkers, workers.size());
+        boost::uint64_t jobs = 0;
+        boost::uint64_t busy = 0;
+        for (unsigned int i = 0; i < workers.size(); ++i) {
+            jobs += workers[i].jobs;
+            busy += workers[i].busyMicros;
+        }
+        EXPECT_EQ((boost::uint64_t) numMessages, jobs);
+        EXPECT_GT(busy, (boost::uint64_t) 0);
+
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testStatisticsDisabled)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(1, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+    pool.registerReceiver(receiver);
+    pool.start();
+    for (int i = 0; i < 10; ++i) {
+        pool.push(i);
+    }
+    {
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        while (receiver->messages.size() < 10) {
+            receiver->condition.wait(lock);
+        }
+    }
+    pool.stop();
+
+    Pool::ReceiverStatistics statistics = pool.getReceiverStatistics(receiver);
+    EXPECT_EQ((size_t) 0, statistics.highWaterMark);
+    EXPECT_EQ((boost::uint64_t) 0, statistics.delivered);
+    EXPECT_EQ((boost::uint64_t) 0, statistics.latency.getCount());
+    EXPECT_EQ((boost::uint64_t) 0, pool.getWorkerStatistics()[0].jobs);
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testWorkerPlacement)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    for (int mode = Pool::SCHEDULING_SHARED;
+            mode <= Pool::SCHEDULING_WORK_STEALING; ++mode) {
+
+        Pool pool(3, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+        pool.setSchedulingMode((Pool::SchedulingMode) mode);
+        pool.setWorkerNamePrefix("dispatcher-");
+        pool.setNumaAware(true);
+
+        // CPU 0 exists everywhere
+        const vector<unsigned int> cpus(1, 0);
+        pool.setWorkerAffinity(cpus);
+        EXPECT_EQ(cpus, pool.getWorkerAffinity());
+
+        const unsigned int numReceivers = 20;
+        vector<boost::shared_ptr<StubReceiver> > receivers;
+        for (unsigned int i = 0; i < numReceivers; ++i) {
+            boost::shared_ptr<StubReceiver> r(new StubReceiver);
+            pool.registerReceiver(r);
+            receivers.push_back(r);
+        }
+
+        try {
+            pool.start();
+        } catch (const rsc::misc::UnsupportedOperationException& e) {
+            // affinity is not available on all platforms
+            return;
+        }
+        EXPECT_THROW(pool.setWorkerAffinity(vector<unsigned int>()),
+                rsc::misc::IllegalStateException);
+        EXPECT_THROW(pool.setNumaAware(false),
+                rsc::misc::IllegalStateException);
+
+        const int numMessages = 50;
+        for (int i = 0; i < numMessages; ++i) {
+            pool.push(i);
+        }
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            boost::mutex::scoped_lock lock(receivers[i]->mutex);
+            while (receivers[i]->messages.size() < (size_t) numMessages) {
+                receivers[i]->condition.wait(lock);
+            }
+        }
+        pool.stop();
+
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            for (int expected = 0; expected < numMessages; ++expected) {
+                EXPECT_EQ(expected, receivers[i]->messages[expected]);
+            }
+        }
+
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testResize)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    for (int mode = Pool::SCHEDULING_SHARED;
+            mode <= Pool::SCHEDULING_WORK_STEALING; ++mode) {
+
+        Pool pool(2, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+        pool.setSchedulingMode((Pool::SchedulingMode) mode);
+        EXPECT_THROW(pool.resize(0), std::invalid_argument);
+
+        const unsigned int numReceivers = 50;
+        vector<boost::shared_ptr<StubReceiver> > receivers;
+        for (unsigned int i = 0; i < numReceivers; ++i) {
+            boost::shared_ptr<StubReceiver> r(new StubReceiver);
+            pool.registerReceiver(r);
+            receivers.push_back(r);
+        }
+
+        pool.start();
+
+        // grow and shrink while messages are processed
+        const unsigned int sizes[] = { 6, 1, 4, 2 };
+        const int messagesPerSize = 25;
+        int numMessages = 0;
+        for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+            for (int i = 0; i < messagesPerSize; ++i) {
+                pool.push(numMessages++);
+            }
+            pool.resize(sizes[s]);
+            EXPECT_EQ(sizes[s], pool.getWorkerCount());
+        }
+
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            boost::mutex::scoped_lock lock(receivers[i]->mutex);
+            while (receivers[i]->messages.size() < (size_t) numMessages) {
+                receivers[i]->condition.wait(lock);
+            }
+        }
+        EXPECT_EQ(size_t(6), pool.getWorkerStatistics().size());
+        pool.stop();
+
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            ASSERT_EQ(size_t(numMessages), receivers[i]->messages.size());
+            for (int expected = 0; expected < numMessages; ++expected) {
+                EXPECT_EQ(expected, receivers[i]->messages[expected]);
+            }
+        }
+
+        // resizing a stopped pool takes effect on start
+        pool.resize(3);
+        EXPECT_EQ(3u, pool.getWorkerCount());
+        pool.start();
+        pool.push(numMessages);
+        boost::mutex::scoped_lock lock(receivers[0]->mutex);
+        while (receivers[0]->messages.size() <= (size_t) numMessages) {
+            receivers[0]->condition.wait(lock);
+        }
+        lock.unlock();
+        pool.stop();
+
+    }
+
+}
+
+/**
+ * A delivery handler which takes some time per message.
+ *
+ * @author jwienke
+ */
+class SlowDeliveryHandler: public OrderedQueueDispatcherPool<int, StubReceiver>::DeliveryHandler {
+public:
+    void deliver(boost::shared_ptr<StubReceiver>& receiver, const int& message) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+        boost::mutex::scoped_lock lock(receiver->mutex);
+        receiver->messages.push_back(message);
+        receiver->condition.notify_all();
+    }
+};
+
+TEST(OrderedQueueDispatcherPoolTest, testResizeSpreadsLoadAfterGrowing)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    for (int mode = Pool::SCHEDULING_SHARED;
+            mode <= Pool::SCHEDULING_WORK_STEALING; ++mode) {
+
+        Pool pool(1, Pool::DeliveryHandlerPtr(new SlowDeliveryHandler));
+        pool.setSchedulingMode((Pool::SchedulingMode) mode);
+        pool.setStatisticsEnabled(true);
+
+        const unsigned int numReceivers = 8;
+        vector<boost::shared_ptr<StubReceiver> > receivers;
+        for (unsigned int i = 0; i < numReceivers; ++i) {
+            boost::shared_ptr<StubReceiver> r(new StubReceiver);
+            pool.registerReceiver(r);
+            receivers.push_back(r);
+        }
+
+        pool.start();
+
+        // grow beyond the size the ready queues were laid out for while
+        // messages are pending
+        const int numMessages = 40;
+        for (int i = 0; i < numMessages / 2; ++i) {
+            pool.push(i);
+        }
+        const unsigned int size = 4;
+        pool.resize(size);
+        for (int i = numMessages / 2; i < numMessages; ++i) {
+            pool.push(i);
+        }
+
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            boost::mutex::scoped_lock lock(receivers[i]->mutex);
+            while (receivers[i]->messages.size() < (size_t) numMessages) {
+                receivers[i]->condition.wait(lock);
+            }
+        }
+        pool.stop();
+
+        const vector<Pool::WorkerStatistics> statistics =
+                pool.getWorkerStatistics();
+        ASSERT_EQ(size_t(size), statistics.size());
+        for (unsigned int i = 0; i < size; ++i) {
+            EXPECT_GT(statistics[i].jobs, 0u) << "worker " << i;
+        }
+        for (unsigned int i = 0; i < receivers.size(); ++i) {
+            ASSERT_EQ(size_t(numMessages), receivers[i]->messages.size());
+            for (int expected = 0; expected < numMessages; ++expected) {
+                EXPECT_EQ(expected, receivers[i]->messages[expected]);
+            }
+        }
+
+    }
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testAutoScaling)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(1, Pool::DeliveryHandlerPtr(new SlowDeliveryHandler));
+    pool.setSchedulingMode(Pool::SCHEDULING_WORK_STEALING);
+
+    Pool::AutoScalingPolicy policy;
+    policy.minWorkers = 2;
+    policy.maxWorkers = 1;
+    EXPECT_THROW(pool.setAutoScaling(policy), std::invalid_argument);
+    policy.minWorkers = 0;
+    EXPECT_THROW(pool.setAutoScaling(policy), std::invalid_argument);
+
+    policy.minWorkers = 1;
+    policy.maxWorkers = 4;
+    policy.backlogThreshold = 2;
+    policy.idleTimeout = 100;
+    policy.checkInterval = 10;
+    pool.setAutoScaling(policy);
+    EXPECT_TRUE(pool.isAutoScaling());
+    EXPECT_EQ(1u, pool.getWorkerCount());
+
+    const unsigned int numReceivers = 20;
+    vector<boost::shared_ptr<StubReceiver> > receivers;
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        boost::shared_ptr<StubReceiver> r(new StubReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    pool.start();
+    EXPECT_THROW(pool.disableAutoScaling(), rsc::misc::IllegalStateException);
+
+    // a backlog adds workers
+    const int numMessages = 20;
+    for (int i = 0; i < numMessages; ++i) {
+        pool.push(i);
+    }
+    unsigned int maxWorkers = pool.getWorkerCount();
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->messages.size() < (size_t) numMessages) {
+            receivers[i]->condition.timed_wait(lock,
+                    boost::posix_time::milliseconds(5));
+            maxWorkers = max(maxWorkers, pool.getWorkerCount());
+        }
+    }
+    EXPECT_GT(maxWorkers, 1u);
+    EXPECT_LE(maxWorkers, policy.maxWorkers);
+
+    // idle workers are removed again
+    for (unsigned int i = 0; i < 200 && pool.getWorkerCount() > 1; ++i) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+    }
+    EXPECT_EQ(policy.minWorkers, pool.getWorkerCount());
+
+    pool.stop();
+
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        for (int expected = 0; expected < numMessages; ++expected) {
+            EXPECT_EQ(expected, receivers[i]->messages[expected]);
+        }
+    }
+
+    pool.disableAutoScaling();
+    EXPECT_FALSE(pool.isAutoScaling());
+
+}
+
+void pushConstantly(OrderedQueueDispatcherPool<int, StubReceiver>* pool,
+        const int count) {
+    for (int i = 0; i < count; ++i) {
+        pool->push(i);
+    }
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testAutoScalingBacklogUnderLoad)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(2, Pool::DeliveryHandlerPtr(new DeliveryHandler));
+    pool.setSchedulingMode(Pool::SCHEDULING_WORK_STEALING);
+
+    const unsigned int numReceivers = 20;
+    vector<boost::shared_ptr<StubReceiver> > receivers;
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        boost::shared_ptr<StubReceiver> r(new StubReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    // each receiver is ready at most once, hence the backlog can never
+    // exceed the threshold unless the ready count is broken
+    Pool::AutoScalingPolicy policy;
+    policy.minWorkers = 2;
+    policy.maxWorkers = 4;
+    policy.backlogThreshold = numReceivers;
+    policy.latencyThreshold = 0;
+    policy.checkInterval = 1;
+    pool.setAutoScaling(policy);
+    pool.start();
+
+    const int numMessages = 5000;
+    boost::thread_group pushers;
+    pushers.create_thread(boost::bind(pushConstantly, &pool, numMessages));
+    pushers.create_thread(boost::bind(pushConstantly, &pool, numMessages));
+    unsigned int maxWorkers = pool.getWorkerCount();
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        boost::mutex::scoped_lock lock(receivers[i]->mutex);
+        while (receivers[i]->messages.size() < (size_t) 2 * numMessages) {
+            receivers[i]->condition.timed_wait(lock,
+                    boost::posix_time::milliseconds(1));
+            maxWorkers = max(maxWorkers, pool.getWorkerCount());
+        }
+    }
+    pushers.join_all();
+    pool.stop();
+
+    EXPECT_EQ(policy.minWorkers, maxWorkers);
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testDrain)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(2, Pool::DeliveryHandlerPtr(new SlowDeliveryHandler));
+
+    const unsigned int numReceivers = 5;
+    vector<boost::shared_ptr<StubReceiver> > receivers;
+    for (unsigned int i = 0; i < numReceivers; ++i) {
+        boost::shared_ptr<StubReceiver> r(new StubReceiver);
+        pool.registerReceiver(r);
+        receivers.push_back(r);
+    }
+
+    pool.start();
+    const int numMessages = 20;
+    for (int i = 0; i < numMessages; ++i) {
+        pool.push(i);
+    }
+
+    EXPECT_EQ(size_t(0), pool.drain());
+    EXPECT_THROW(pool.push(numMessages), rsc::misc::IllegalStateException);
+
+    for (unsigned int i = 0; i < receivers.size(); ++i) {
+        ASSERT_EQ(size_t(numMessages), receivers[i]->messages.size());
+        for (int expected = 0; expected < numMessages; ++expected) {
+            EXPECT_EQ(expected, receivers[i]->messages[expected]);
+        }
+    }
+
+    // the pool accepts messages again after a restart
+    pool.start();
+    pool.push(numMessages);
+    EXPECT_EQ(size_t(0), pool.drain());
+    EXPECT_EQ(size_t(numMessages + 1), receivers[0]->messages.size());
+
+}
+
+TEST(OrderedQueueDispatcherPoolTest, testDrainTimeout)
+{
+
+    typedef OrderedQueueDispatcherPool<int, StubReceiver> Pool;
+
+    Pool pool(1, Pool::DeliveryHandlerPtr(new SlowDeliveryHandler));
+    boost::shared_ptr<StubReceiver> receiver(new StubReceiver);
+    pool.registerReceiver(receiver);
+
+    pool.start();
+    const int numMessages = 500;
+    for (int i = 0; i < numMessages; ++i) {
+        pool.push(i);
+    }
+
+    const size_t left = pool.drain(20);
+    EXPECT_GT(left, size_t(0));
+    EXPECT_EQ(size_t(numMessages), receiver->messages.size() + left);
+
+    // remaining messages are delivered after a restart
+    pool.start();
+    EXPECT_EQ(size_t(0), pool.drain());
+    ASSERT_EQ(size_t(numMessages), receiver->messages.size());
+    for (int expected = 0; expected < numMessages; ++expected) {
+        EXPECT_EQ(expected, receiver->messages[expected]);
+    }
+
+}
@@ -0,0 +1,381 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/misc/langutils.h"
+#include "rsc/threading/PeriodicTask.h"
+#include "rsc/threading/SimpleTask.h"
+#include "rsc/threading/PooledTaskExecutor.h"
+
+using namespace std;
+using namespace rsc::threading;
+using namespace rsc::misc;
+using namespace testing;
+
+class RecordingTask: public SimpleTask {
+public:
+    boost::uint64_t runTime;
+    bool canceledWhenRun;
+    RecordingTask() :
+            runTime(0), canceledWhenRun(false) {
+    }
+    void run() {
+        runTime = currentTimeMicros();
+        canceledWhenRun = isCancelRequested();
+        markDone();
+    }
+};
+
+/**
+ * A task which runs until it is canceled.
+ *
+ * @author jwienke
+ */
+class BlockingTask: public SimpleTask {
+public:
+    void run() {
+        while (!isCancelRequested()) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+        }
+        markDone();
+    }
+};
+
+TEST(PooledTaskExecutorTest, testInvalidSizes) {
+
+    EXPECT_THROW(PooledTaskExecutor(0), invalid_argument);
+    EXPECT_THROW(PooledTaskExecutor(0, 0), invalid_argument);
+    EXPECT_THROW(PooledTaskExecutor(3, 2), invalid_argument);
+
+}
+
+TEST(PooledTaskExecutorTest, testScheduleExceptionCanceled) {
+
+    PooledTaskExecutor executor(2);
+    TaskPtr t(new RecordingTask);
+    t->cancel();
+    EXPECT_THROW(executor.schedule(t), invalid_argument);
+    EXPECT_THROW(executor.schedule(t, 320), invalid_argument);
+
+}
+
+TEST(PooledTaskExecutorTest, testScheduleMany) {
+
+    PooledTaskExecutor executor(3);
+    EXPECT_EQ(3u, executor.getThreadCount());
+
+    vector<boost::shared_ptr<RecordingTask> > tasks;
+    for (unsigned int i = 0; i < 1000; ++i) {
+        boost::shared_ptr<RecordingTask> t(new RecordingTask);
+        executor.schedule(t);
+        tasks.push_back(t);
+    }
+    for (unsigned int i = 0; i < tasks.size(); ++i) {
+        tasks[i]->waitDone();
+        EXPECT_FALSE(tasks[i]->canceledWhenRun);
+    }
+    EXPECT_EQ(3u, executor.getThreadCount());
+    EXPECT_EQ(size_t(0), executor.getPendingCount());
+
+}
+
+TEST(PooledTaskExecutorTest, testScheduleDelayed) {
+
+    PooledTaskExecutor executor(1);
+
+    const boost::uint64_t delay = 237048;
+    boost::shared_ptr<RecordingTask> t(new RecordingTask);
+    boost::uint64_t scheduleTime = currentTimeMicros();
+    executor.schedule(t, delay);
+    EXPECT_EQ(size_t(1), executor.getPendingCount());
+    t->waitDone();
+    const boost::uint64_t allowedPrecision = 200000;
+    EXPECT_GE(t->runTime, scheduleTime + delay);
+    EXPECT_LE(t->runTime, scheduleTime + delay + allowedPrecision);
+
+}
+
+TEST(PooledTaskExecutorTest, testScheduleDelayedAfterCancel) {
+
+    PooledTaskExecutor executor(1);
+    boost::shared_ptr<RecordingTask> t(new RecordingTask);
+    executor.schedule(t, 100000);
+    t->cancel();
+    EXPECT_FALSE(t->isDone());
+    t->waitDone();
+    EXPECT_TRUE(t->isDone());
+    EXPECT_TRUE(t->canceledWhenRun);
+
+}
+
+TEST(PooledTaskExecutorTest, testDelayedTasksDoNotBlockWorkers) {
+
+    PooledTaskExecutor executor(1);
+    boost::shared_ptr<RecordingTask> delayed(new RecordingTask);
+    executor.schedule(delayed, 5000000);
+    boost::shared_ptr<RecordingTask> immediate(new RecordingTask);
+    executor.schedule(immediate);
+    immediate->waitDone();
+    EXPECT_FALSE(delayed->isDone());
+
+}
+
+TEST(PooledTaskExecutorTest, testElastic) {
+
+    PooledTaskExecutor executor(1, 3, 50);
+    EXPECT_EQ(1u, executor.getThreadCount());
+
+    // long running tasks make the pool grow up to its maximum
+    vector<boost::shared_ptr<BlockingTask> > blocking;
+    for (unsigned int i = 0; i < 3; ++i) {
+        boost::shared_ptr<BlockingTask> t(new BlockingTask);
+        executor.schedule(t);
+        blocking.push_back(t);
+    }
+    EXPECT_EQ(3u, executor.getThreadCount());
+
+    // further tasks wait for a free worker
+    boost::shared_ptr<RecordingTask> waiting(new RecordingTask);
+    executor.schedule(waiting);
+    EXPECT_EQ(3u, executor.getThreadCount());
+    boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+    EXPECT_FALSE(waiting->isDone());
+
+    blocking[0]->cancel();
+    waiting->waitDone();
+
+    // idle workers exit after the keep-alive time
+    for (unsigned int i = 1; i < blocking.size(); ++i) {
+        blocking[i]->cancel();
+        blocking[i]->waitDone();
+    }
+    for (unsigned int i = 0; i < 100 && executor.getThreadCount() > 1; ++i) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+    EXPECT_EQ(1u, executor.getThreadCount());
+
+}
+
+TEST(PooledTaskExecutorTest, testDestructionCancelsTasks) {
+
+    boost::shared_ptr<BlockingTask> running(new BlockingTask);
+    boost::shared_ptr<RecordingTask> queued(new RecordingTask);
+    boost::shared_ptr<RecordingTask> delayed(new RecordingTask);
+    {
+        PooledTaskExecutor executor(1);
+        executor.schedule(running);
+        executor.schedule(queued);
+        executor.schedule(delayed, 10000000);
+    }
+    EXPECT_TRUE(running->isDone());
+    EXPECT_TRUE(queued->isDone());
+    EXPECT_TRUE(queued->canceledWhenRun);
+    EXPECT_TRUE(delayed->isDone());
+    EXPECT_TRUE(delayed->canceledWhenRun);
+
+}
+
+/**
+ * A task which schedules a delayed follow-up task once it is canceled.
+ *
+ * @author jwienke
+ */
+class SchedulingOnCancelTask: public SimpleTask {
+public:
+
+    SchedulingOnCancelTask(PooledTaskExecutor& executor, TaskPtr followUp) :
+            executor(executor), followUp(followUp) {
+    }
+
+    void run() {
+        while (!isCancelRequested()) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+        }
+        // the executor is being destroyed at this point
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        executor.schedule(followUp, 10000000);
+        markDone();
+    }
+
+private:
+    PooledTaskExecutor& executor;
+    TaskPtr followUp;
+
+};
+
+TEST(PooledTaskExecutorTest, testScheduleDelayedDuringDestruction) {
+
+    boost::shared_ptr<RecordingTask> followUp(new RecordingTask);
+    {
+        PooledTaskExecutor executor(1);
+        executor.schedule(
+                TaskPtr(new SchedulingOnCancelTask(executor, followUp)));
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+    EXPECT_TRUE(followUp->isDone());
+    EXPECT_TRUE(followUp->canceledWhenRun);
+
+}
+
+/**
+ * A periodic task recording the start of its iterations.
+ *
+ * @author jwienke
+ */
+class CountingPeriodicTask: public PeriodicTask {
+public:
+
+    CountingPeriodicTask(const unsigned int& ms, bool accountProcTime,
+            const unsigned int& workMs = 0) :
+            PeriodicTask(ms, accountProcTime), workMs(workMs) {
+    }
+
+    void execute() {
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            starts.push_back(currentTimeMicros());
+            condition.notify_all();
+        }
+        if (workMs > 0) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(workMs));
+        }
+    }
+
+    void waitForIterations(const size_t& count) {
+        boost::mutex::scoped_lock lock(mutex);
+        while (starts.size() < count) {
+            condition.wait(lock);
+        }
+    }
+
+    vector<boost::uint64_t> getStarts() {
+        boost::mutex::scoped_lock lock(mutex);
+        return starts;
+    }
+
+private:
+
+    const unsigned int workMs;
+    boost::mutex mutex;
+    boost::condition condition;
+    vector<boost::uint64_t> starts;
+
+};
+
+TEST(PooledTaskExecutorTest, testPeriodicTasksShareWorkers) {
+
+    PooledTaskExecutor executor(1, 2);
+
+    vector<boost::shared_ptr<CountingPeriodicTask> > tasks;
+    for (unsigned int i = 0; i < 50; ++i) {
+        boost::shared_ptr<CountingPeriodicTask> t(
+                new CountingPeriodicTask(10, true));
+        executor.schedule(t);
+        tasks.push_back(t);
+    }
+    for (unsigned int i = 0; i < tasks.size(); ++i) {
+        tasks[i]->waitForIterations(5);
+    }
+    EXPECT_LE(executor.getThreadCount(), 2u);
+
+    for (unsigned int i = 0; i < tasks.size(); ++i) {
+        tasks[i]->cancel();
+    }
+    for (unsigned int i = 0; i < tasks.size(); ++i) {
+        tasks[i]->waitDone();
+        EXPECT_TRUE(tasks[i]->isDone());
+        EXPECT_GE(tasks[i]->getJitter().getCount(), boost::uint64_t(5));
+    }
+
+}
+
+TEST(PooledTaskExecutorTest, testPeriodicSchedulingModes) {
+
+    PooledTaskExecutor executor(2);
+
+    // 10 ms cycle with 6 ms of work per iteration
+    boost::shared_ptr<CountingPeriodicTask> fixedRate(
+            new CountingPeriodicTask(10, true, 6));
+    boost::shared_ptr<CountingPeriodicTask> fixedDelay(
+            new CountingPeriodicTask(10, false, 6));
+    executor.schedule(fixedRate);
+    executor.schedule(fixedDelay);
+
+    const size_t iterations = 11;
+    fixedRate->waitForIterations(iterations);
+    fixedDelay->waitForIterations(iterations);
+    fixedRate->cancel();
+    fixedDelay->cancel();
+    fixedRate->waitDone();
+    fixedDelay->waitDone();
+
+    const vector<boost::uint64_t> rateStarts = fixedRate->getStarts();
+    const vector<boost::uint64_t> delayStarts = fixedDelay->getStarts();
+    const boost::uint64_t rateDuration = rateStarts[iterations - 1]
+            - rateStarts[0];
+    const boost::uint64_t delayDuration = delayStarts[iterations - 1]
+            - delayStarts[0];
+    EXPECT_GE(rateDuration, boost::uint64_t(100000));
+    EXPECT_LT(rateDuration, boost::uint64_t(150000));
+    EXPECT_GE(delayDuration, boost::uint64_t(160000));
+
+}
+
+TEST(PooledTaskExecutorTest, testCancelWakesWait) {
+
+    PooledTaskExecutor executor(1);
+    boost::shared_ptr<CountingPeriodicTask> t(
+            new CountingPeriodicTask(60000, true));
+    executor.schedule(t);
+    t->waitForIterations(1);
+    // give the task time to wait for the next iteration
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+
+    const boost::uint64_t start = currentTimeMicros();
+    t->cancel();
+    t->waitDone();
+    EXPECT_LT(currentTimeMicros() - start, boost::uint64_t(1000000));
+    EXPECT_EQ(size_t(1), t->getStarts().size());
+
+}
+
+TEST(PooledTaskExecutorTest, testDelayedPeriodicTask) {
+
+    PooledTaskExecutor executor(1);
+    boost::shared_ptr<CountingPeriodicTask> t(
+            new CountingPeriodicTask(10, true));
+    const boost::uint64_t scheduled = currentTimeMicros();
+    executor.schedule(t, 50000);
+    t->waitForIterations(1);
+    EXPECT_GE(t->getStarts()[0], scheduled + 50000);
+    t->cancel();
+    t->waitDone();
+
+}
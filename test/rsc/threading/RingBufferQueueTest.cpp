@@ -0,0 +1,394 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/threading/RingBufferQueue.h"
+#include "rsc/misc/langutils.h"
+
+using namespace std;
+using namespace rsc;
+using namespace rsc::threading;
+using namespace rsc::misc;
+
+void waitOnRingBufferElement(RingBufferQueue<int>* queue, int* resultVar,
+        bool* interrupted) {
+    try {
+        *resultVar = queue->pop();
+    } catch (InterruptedException& e) {
+        *interrupted = true;
+    }
+}
+
+TEST(RingBufferQueueTest, testCapacity)
+{
+
+    EXPECT_THROW(RingBufferQueue<int>(0), invalid_argument);
+    EXPECT_EQ((size_t) 2, RingBufferQueue<int>(1).capacity());
+    EXPECT_EQ((size_t) 8, RingBufferQueue<int>(8).capacity());
+    EXPECT_EQ((size_t) 16, RingBufferQueue<int>(9).capacity());
+
+}
+
+/**
+ * An element whose assignment blocks while the gate is closed if its value is
+ * BLOCKING. Used to keep a consumer between claiming and releasing a slot.
+ */
+struct GatedElement {
+
+    static const int BLOCKING = -1;
+
+    GatedElement(const int& value = 0) :
+            value(value) {
+    }
+
+    GatedElement(const GatedElement& other) :
+            value(other.value) {
+    }
+
+    GatedElement& operator=(const GatedElement& other) {
+        if (other.value == BLOCKING) {
+            boost::mutex::scoped_lock lock(mutex);
+            assigning = true;
+            condition.notify_all();
+            while (closed) {
+                condition.wait(lock);
+            }
+        }
+        value = other.value;
+        return *this;
+    }
+
+    int value;
+
+    static boost::mutex mutex;
+    static boost::condition condition;
+    static bool closed;
+    static bool assigning;
+
+};
+
+const int GatedElement::BLOCKING;
+boost::mutex GatedElement::mutex;
+boost::condition GatedElement::condition;
+bool GatedElement::closed = false;
+bool GatedElement::assigning = false;
+
+void popGatedElement(RingBufferQueue<GatedElement>* queue, int* result) {
+    *result = queue->pop().value;
+}
+
+void countDrop(unsigned int* drops, const GatedElement& /*element*/) {
+    ++*drops;
+}
+
+TEST(RingBufferQueueTest, testPushDoesNotDropWhileHeadIsClaimed)
+{
+
+    unsigned int drops = 0;
+    RingBufferQueue<GatedElement> queue(2,
+            boost::bind(&countDrop, &drops, _1));
+    queue.push(GatedElement(GatedElement::BLOCKING));
+    queue.push(GatedElement(2));
+
+    {
+        boost::mutex::scoped_lock lock(GatedElement::mutex);
+        GatedElement::closed = true;
+        GatedElement::assigning = false;
+    }
+
+    // the consumer claims the first slot and blocks before releasing it
+    int popped = 0;
+    boost::thread consumer(boost::bind(&popGatedElement, &queue, &popped));
+    {
+        boost::mutex::scoped_lock lock(GatedElement::mutex);
+        while (!GatedElement::assigning) {
+            GatedElement::condition.wait(lock);
+        }
+    }
+
+    // the queue is not full anymore, so push must wait instead of dropping
+    boost::thread producer(
+            boost::bind(&RingBufferQueue<GatedElement>::push, &queue,
+                    GatedElement(3)));
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    EXPECT_EQ(0u, drops);
+
+    {
+        boost::mutex::scoped_lock lock(GatedElement::mutex);
+        GatedElement::closed = false;
+        GatedElement::condition.notify_all();
+    }
+    consumer.join();
+    producer.join();
+
+    EXPECT_EQ(0u, drops);
+    EXPECT_EQ(GatedElement::BLOCKING, popped);
+    EXPECT_EQ(2, queue.pop().value);
+    EXPECT_EQ(3, queue.pop().value);
+
+}
+
+TEST(RingBufferQueueTest, testBasicPushPopSingleThreaded)
+{
+
+    RingBufferQueue<int> queue(16);
+
+    const int first = 12;
+    const int second = 24;
+    const int third = 36;
+
+    queue.push(first);
+    queue.push(second);
+    queue.push(third);
+    EXPECT_EQ((size_t) 3, queue.size());
+
+    EXPECT_EQ(first, queue.pop());
+    EXPECT_EQ(second, queue.pop());
+    EXPECT_EQ(third, queue.pop());
+
+}
+
+TEST(RingBufferQueueTest, testTryPop)
+{
+
+    RingBufferQueue<int> queue(4);
+
+    EXPECT_THROW(queue.tryPop(), QueueEmptyException);
+
+    const int i = 3;
+    queue.push(i);
+    EXPECT_EQ(i, queue.tryPop());
+
+    EXPECT_THROW(queue.tryPop(), QueueEmptyException);
+
+}
+
+TEST(RingBufferQueueTest, testTryPushTryPop)
+{
+
+    RingBufferQueue<int> queue(2);
+
+    int value = 0;
+    EXPECT_FALSE(queue.tryPop(value));
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3)) << "Must not drop elements";
+    EXPECT_EQ(size_t(2), queue.size());
+
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_FALSE(queue.tryPop(value));
+
+}
+
+TEST(RingBufferQueueTest, testBasicPushPopMultiThreaded)
+{
+
+    RingBufferQueue<int> queue(16);
+
+    int waiter1Result;
+    bool waiter1Interrupted = false;
+    boost::function<void()> waiter1 = boost::bind(waitOnRingBufferElement,
+            &queue, &waiter1Result, &waiter1Interrupted);
+    int waiter2Result;
+    bool waiter2Interrupted = false;
+    boost::function<void()> waiter2 = boost::bind(waitOnRingBufferElement,
+            &queue, &waiter2Result, &waiter2Interrupted);
+
+    boost::thread w1(waiter1);
+    boost::thread w2(waiter2);
+
+    int first = 12;
+    int second = 24;
+
+    queue.push(first);
+    queue.push(second);
+
+    w1.join();
+    w2.join();
+
+    EXPECT_TRUE((waiter1Result == first && waiter2Result == second) ||
+            (waiter1Result == second && waiter2Result == first));
+    EXPECT_FALSE(waiter1Interrupted);
+    EXPECT_FALSE(waiter2Interrupted);
+
+}
+
+TEST(RingBufferQueueTest, testPopTimeout)
+{
+
+    RingBufferQueue<int> queue(4);
+    boost::uint64_t before = currentTimeMillis();
+    EXPECT_THROW(queue.pop(500), QueueEmptyException);
+    boost::uint64_t after = currentTimeMillis();
+    EXPECT_GE(after - before, 500);
+
+}
+
+TEST(RingBufferQueueTest, testInterruption)
+{
+
+    RingBufferQueue<int> queue(4);
+
+    int waiter1Result;
+    bool waiter1Interrupted = false;
+    boost::function<void()> waiter1 = boost::bind(waitOnRingBufferElement,
+            &queue, &waiter1Result, &waiter1Interrupted);
+    int waiter2Result;
+    bool waiter2Interrupted = false;
+    boost::function<void()> waiter2 = boost::bind(waitOnRingBufferElement,
+            &queue, &waiter2Result, &waiter2Interrupted);
+
+    boost::thread w1(waiter1);
+    boost::thread w2(waiter2);
+
+    queue.interrupt();
+
+    w1.join();
+    w2.join();
+
+    EXPECT_TRUE(waiter1Interrupted);
+    EXPECT_TRUE(waiter2Interrupted);
+
+    EXPECT_THROW(queue.pop(), InterruptedException) << "Even new calls to pop must throw after interruption";
+
+}
+
+TEST(RingBufferQueueTest, testEmpty)
+{
+
+    RingBufferQueue<int> queue(4);
+
+    EXPECT_TRUE(queue.empty());
+    queue.push(12);
+    EXPECT_FALSE(queue.empty());
+    queue.interrupt();
+    EXPECT_FALSE(queue.empty());
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+
+}
+
+void dropRingBufferElement(const int& dropped, vector<int>* results) {
+    results->push_back(dropped);
+}
+
+TEST(RingBufferQueueTest, testDropHandler)
+{
+
+    vector<int> dropped;
+    RingBufferQueue<int> queue(2,
+            boost::bind(&dropRingBufferElement, _1, &dropped));
+
+    unsigned int elems = 5;
+    for (unsigned int i = 0; i < elems; ++i) {
+        queue.push(i);
+    }
+
+    ASSERT_EQ((size_t) 3, dropped.size());
+    EXPECT_EQ(0, dropped[0]);
+    EXPECT_EQ(1, dropped[1]);
+    EXPECT_EQ(2, dropped[2]);
+
+    EXPECT_EQ(3, queue.pop());
+    EXPECT_EQ(4, queue.pop());
+    EXPECT_TRUE(queue.empty());
+
+}
+
+TEST(RingBufferQueueTest, testReleasesPoppedElements)
+{
+
+    RingBufferQueue<boost::shared_ptr<int> > queue(4);
+
+    boost::shared_ptr<int> element(new int(42));
+    queue.push(element);
+    EXPECT_EQ(2, element.use_count());
+    queue.pop();
+    EXPECT_EQ(1, element.use_count()) << "The ring buffer must not keep a reference to popped elements";
+
+}
+
+void produceRingBufferElements(RingBufferQueue<int>* queue, int first,
+        int count) {
+    for (int i = first; i < first + count; ++i) {
+        queue->push(i);
+    }
+}
+
+void consumeRingBufferElements(RingBufferQueue<int>* queue, int count,
+        vector<int>* results) {
+    for (int i = 0; i < count; ++i) {
+        results->push_back(queue->pop());
+    }
+}
+
+TEST(RingBufferQueueTest, testMultipleProducersAndConsumers)
+{
+
+    const int threads = 4;
+    const int elements = 20000;
+
+    RingBufferQueue<int> queue(threads * elements);
+
+    vector<vector<int> > results(threads);
+    boost::thread_group group;
+    for (int i = 0; i < threads; ++i) {
+        group.create_thread(
+                boost::bind(&consumeRingBufferElements, &queue, elements,
+                        &results[i]));
+    }
+    for (int i = 0; i < threads; ++i) {
+        group.create_thread(
+                boost::bind(&produceRingBufferElements, &queue, i * elements,
+                        elements));
+    }
+    group.join_all();
+
+    vector<bool> seen(threads * elements, false);
+    for (int i = 0; i < threads; ++i) {
+        ASSERT_EQ((size_t) elements, results[i].size());
+        for (vector<int>::const_iterator it = results[i].begin();
+                it != results[i].end(); ++it) {
+            EXPECT_FALSE(seen[*it]) << "Element " << *it << " received twice";
+            seen[*it] = true;
+        }
+    }
+    EXPECT_TRUE(queue.empty());
+
+}
@@ -0,0 +1,165 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/threading/SynchronizedPriorityQueue.h"
+#include "rsc/misc/langutils.h"
+
+using namespace std;
+using namespace rsc;
+using namespace rsc::threading;
+using namespace rsc::misc;
+
+typedef pair<int, string> PriorityMessage;
+
+int extractPriority(const PriorityMessage& message) {
+    return message.first;
+}
+
+void dropPriorityMessage(const PriorityMessage& dropped,
+        vector<PriorityMessage>* results) {
+    results->push_back(dropped);
+}
+
+TEST(SynchronizedPriorityQueueTest, testPriorityOrder)
+{
+
+    SynchronizedPriorityQueue<PriorityMessage> queue(&extractPriority);
+
+    queue.push(make_pair(1, string("bulk1")));
+    queue.push(make_pair(10, string("control")));
+    queue.push(make_pair(1, string("bulk2")));
+    queue.push(make_pair(5, string("heartbeat")));
+
+    EXPECT_EQ((size_t) 4, queue.size());
+    EXPECT_EQ("control", queue.peek().second);
+    EXPECT_EQ("control", queue.pop().second);
+    EXPECT_EQ("heartbeat", queue.pop().second);
+    EXPECT_EQ("bulk1", queue.tryPop().second);
+    EXPECT_EQ("bulk2", queue.pop().second);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_THROW(queue.tryPop(), QueueEmptyException);
+
+}
+
+TEST(SynchronizedPriorityQueueTest, testExplicitPriority)
+{
+
+    SynchronizedPriorityQueue<string> queue;
+
+    EXPECT_THROW(queue.push("no extractor"), logic_error);
+    queue.push("low", 1);
+    queue.push("high", 2);
+    EXPECT_EQ("high", queue.pop());
+    EXPECT_EQ("low", queue.pop());
+
+}
+
+TEST(SynchronizedPriorityQueueTest, testDropsLowestPriority)
+{
+
+    vector<PriorityMessage> dropped;
+    SynchronizedPriorityQueue<PriorityMessage> queue(&extractPriority, 2,
+            boost::bind(&dropPriorityMessage, _1, &dropped));
+
+    queue.push(make_pair(5, string("a")));
+    queue.push(make_pair(1, string("b")));
+    queue.push(make_pair(1, string("c")));
+    queue.push(make_pair(0, string("d")));
+    queue.push(make_pair(7, string("e")));
+
+    ASSERT_EQ((size_t) 3, dropped.size());
+    EXPECT_EQ("b", dropped[0].second) << "Oldest of the lowest priority elements must be dropped";
+    EXPECT_EQ("d", dropped[1].second) << "A new element with the lowest priority must be dropped";
+    EXPECT_EQ("c", dropped[2].second);
+
+    EXPECT_EQ("e", queue.pop().second);
+    EXPECT_EQ("a", queue.pop().second);
+
+}
+
+TEST(SynchronizedPriorityQueueTest, testDeadlineOrder)
+{
+
+    DeadlineSynchronizedQueue<string> queue;
+
+    queue.pushWithin("late", 1000000);
+    queue.pushWithin("early", 1000);
+    queue.push("now");
+    queue.push("explicit", 0);
+
+    EXPECT_EQ("explicit", queue.pop());
+    EXPECT_EQ("now", queue.pop());
+    EXPECT_EQ("early", queue.pop());
+    EXPECT_EQ("late", queue.pop());
+
+}
+
+void waitOnPriorityQueue(SynchronizedPriorityQueue<string>* queue,
+        string* result, bool* interrupted) {
+    try {
+        *result = queue->pop();
+    } catch (InterruptedException& e) {
+        *interrupted = true;
+    }
+}
+
+TEST(SynchronizedPriorityQueueTest, testWaitAndInterrupt)
+{
+
+    SynchronizedPriorityQueue<string> queue;
+
+    string result;
+    bool interrupted = false;
+    boost::thread waiter(
+            boost::bind(&waitOnPriorityQueue, &queue, &result, &interrupted));
+    queue.push("test", 1);
+    waiter.join();
+    EXPECT_EQ("test", result);
+    EXPECT_FALSE(interrupted);
+
+    boost::uint64_t before = currentTimeMillis();
+    EXPECT_THROW(queue.pop(200), QueueEmptyException);
+    EXPECT_GE(currentTimeMillis() - before, 200);
+
+    boost::thread waiter2(
+            boost::bind(&waitOnPriorityQueue, &queue, &result, &interrupted));
+    queue.interrupt();
+    waiter2.join();
+    EXPECT_TRUE(interrupted);
+    EXPECT_THROW(queue.pop(), InterruptedException);
+
+}
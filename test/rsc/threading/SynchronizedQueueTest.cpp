@@ -24,9 +24,11 @@
  *
  * ============================================================ */
 
+#include <memory>
 #include <stdexcept>
 
 #include <boost/bind.hpp>
+#include <boost/config.hpp>
 #include <boost/function.hpp>
 #include <boost/thread.hpp>
 
@@ -207,3 +209,253 @@ TEST(SynchronizedQueueTest, testDropHandler)
     EXPECT_EQ(2, dropped[2]);
 
 }
+
+TEST(SynchronizedQueueTest, testPushAll)
+{
+
+    SynchronizedQueue<int> queue;
+
+    vector<int> elements;
+    elements.push_back(1);
+    elements.push_back(2);
+    elements.push_back(3);
+    queue.pushAll(elements);
+    queue.pushAll(elements.begin(), elements.begin() + 1);
+
+    EXPECT_EQ((size_t) 4, queue.size());
+    EXPECT_EQ(1, queue.pop());
+    EXPECT_EQ(2, queue.pop());
+    EXPECT_EQ(3, queue.pop());
+    EXPECT_EQ(1, queue.pop());
+
+}
+
+TEST(SynchronizedQueueTest, testPushAllDropHandler)
+{
+
+    vector<int> dropped;
+    SynchronizedQueue<int> queue(2, boost::bind(&drop, _1, &dropped));
+    queue.push(0);
+
+    vector<int> elements;
+    for (int i = 1; i < 5; ++i) {
+        elements.push_back(i);
+    }
+    queue.pushAll(elements);
+
+    ASSERT_EQ((size_t) 3, dropped.size());
+    EXPECT_EQ(0, dropped[0]);
+    EXPECT_EQ(1, dropped[1]);
+    EXPECT_EQ(2, dropped[2]);
+    EXPECT_EQ(3, queue.pop());
+    EXPECT_EQ(4, queue.pop());
+
+}
+
+TEST(SynchronizedQueueTest, testPopUpTo)
+{
+
+    SynchronizedQueue<int> queue;
+    for (int i = 0; i < 5; ++i) {
+        queue.push(i);
+    }
+
+    vector<int> result;
+    EXPECT_EQ((size_t) 3, queue.popUpTo(3, result));
+    EXPECT_EQ((size_t) 2, queue.popUpTo(3, result));
+    ASSERT_EQ((size_t) 5, result.size());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i, result[i]);
+    }
+
+    EXPECT_THROW(queue.popUpTo(3, result, 100), QueueEmptyException);
+    queue.interrupt();
+    EXPECT_THROW(queue.popUpTo(3, result), InterruptedException);
+
+}
+
+void waitOnQueueBatch(SynchronizedQueue<int>* queue, vector<int>* result) {
+    queue->popUpTo(10, *result);
+}
+
+TEST(SynchronizedQueueTest, testPopUpToWaits)
+{
+
+    SynchronizedQueue<int> queue;
+
+    vector<int> result;
+    boost::thread waiter(boost::bind(&waitOnQueueBatch, &queue, &result));
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+
+    vector<int> elements(3, 42);
+    queue.pushAll(elements);
+    waiter.join();
+
+    EXPECT_FALSE(result.empty());
+    EXPECT_LE(result.size(), (size_t) 3);
+
+}
+
+TEST(SynchronizedQueueTest, testDrainTo)
+{
+
+    SynchronizedQueue<int> queue;
+
+    vector<int> result;
+    EXPECT_EQ((size_t) 0, queue.drainTo(result));
+
+    queue.push(1);
+    queue.push(2);
+    queue.interrupt();
+    EXPECT_EQ((size_t) 2, queue.drainTo(result));
+    ASSERT_EQ((size_t) 2, result.size());
+    EXPECT_EQ(1, result[0]);
+    EXPECT_EQ(2, result[1]);
+    EXPECT_TRUE(queue.empty());
+
+}
+
+/**
+ * Counts how often instances are copied.
+ */
+class CopyCounter {
+public:
+
+    explicit CopyCounter(int* copies = 0) :
+            copies(copies) {
+    }
+
+    CopyCounter(const CopyCounter& other) :
+            copies(other.copies) {
+        if (copies) {
+            ++*copies;
+        }
+    }
+
+    CopyCounter& operator=(const CopyCounter& other) {
+        copies = other.copies;
+        if (copies) {
+            ++*copies;
+        }
+        return *this;
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    CopyCounter(CopyCounter&& other) :
+            copies(other.copies) {
+    }
+
+    CopyCounter& operator=(CopyCounter&& other) {
+        copies = other.copies;
+        return *this;
+    }
+#endif
+
+private:
+    int* copies;
+};
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+TEST(SynchronizedQueueTest, testMoveOnlyElements)
+{
+
+    SynchronizedQueue<std::unique_ptr<int> > queue(2);
+
+    queue.push(std::unique_ptr<int>(new int(1)));
+    queue.emplace(new int(2));
+    queue.emplace(new int(3));
+
+    EXPECT_EQ((size_t) 2, queue.size());
+    EXPECT_EQ(2, *queue.pop());
+    EXPECT_EQ(3, *queue.tryPop());
+
+    queue.emplace(new int(4));
+    queue.emplace(new int(5));
+    vector<std::unique_ptr<int> > result;
+    EXPECT_EQ((size_t) 2, queue.drainTo(result));
+    EXPECT_EQ(4, *result[0]);
+    EXPECT_EQ(5, *result[1]);
+
+}
+
+TEST(SynchronizedQueueTest, testNoCopiesOnHandoff)
+{
+
+    int copies = 0;
+    SynchronizedQueue<CopyCounter> queue;
+
+    queue.push(CopyCounter(&copies));
+    queue.emplace(&copies);
+    queue.pop();
+    queue.pop(10);
+
+    queue.emplace(&copies);
+    vector<CopyCounter> result;
+    queue.popUpTo(1, result);
+
+    EXPECT_EQ(0, copies);
+
+}
+
+#endif
+
+template<class Queue>
+void waitOnStrategyQueue(Queue* queue, int* resultVar, bool* interrupted) {
+    try {
+        *resultVar = queue->pop();
+    } catch (InterruptedException& e) {
+        *interrupted = true;
+    }
+}
+
+template<class WaitStrategy>
+void checkWaitStrategy() {
+
+    typedef SynchronizedQueue<int, WaitStrategy> Queue;
+
+    {
+        Queue queue;
+        int result = 0;
+        bool interrupted = false;
+        boost::thread waiter(
+                boost::bind(&waitOnStrategyQueue<Queue>, &queue, &result,
+                        &interrupted));
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        queue.push(42);
+        waiter.join();
+        EXPECT_EQ(42, result);
+        EXPECT_FALSE(interrupted);
+    }
+
+    {
+        Queue queue;
+        boost::uint64_t before = currentTimeMillis();
+        EXPECT_THROW(queue.pop(100), QueueEmptyException);
+        EXPECT_GE(currentTimeMillis() - before, 100);
+    }
+
+    {
+        Queue queue;
+        int result = 0;
+        bool interrupted = false;
+        boost::thread waiter(
+                boost::bind(&waitOnStrategyQueue<Queue>, &queue, &result,
+                        &interrupted));
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        queue.interrupt();
+        waiter.join();
+        EXPECT_TRUE(interrupted);
+    }
+
+}
+
+TEST(SynchronizedQueueTest, testSpinThenBlockWaitStrategy)
+{
+    checkWaitStrategy<SpinThenBlockWaitStrategy<> >();
+}
+
+TEST(SynchronizedQueueTest, testBusyPollWaitStrategy)
+{
+    checkWaitStrategy<BusyPollWaitStrategy>();
+}
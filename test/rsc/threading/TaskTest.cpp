@@ -120,3 +120,142 @@ TEST(TaskTest, testExecution)
     }
     //cerr << "main finished" << endl;
 }
+
+class CountingTask: public PeriodicTask {
+public:
+    CountingTask(const unsigned int& ms, bool accountProcTime,
+            const OverrunPolicy& overrunPolicy = OVERRUN_CATCH_UP) :
+        PeriodicTask(ms, accountProcTime, overrunPolicy), iterations(0) {
+    }
+    void execute() {
+        ++iterations;
+    }
+    volatile int iterations;
+};
+
+TEST(TaskTest, testJitter)
+{
+
+    boost::shared_ptr<CountingTask> p(new CountingTask(10, false));
+    EXPECT_EQ(10u, p->getCycleTime());
+    EXPECT_FALSE(p->isFixedScheduling());
+    EXPECT_EQ(boost::uint64_t(0), p->getJitter().getCount());
+
+    ThreadedTaskExecutor executor;
+    executor.schedule(p);
+    while (p->iterations < 5) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+    }
+    p->cancel();
+    p->waitDone();
+
+    // all but the first iteration waited
+    EXPECT_GE(p->getJitter().getCount(), boost::uint64_t(4));
+
+}
+
+class SleepingTask: public PeriodicTask {
+public:
+    SleepingTask(const unsigned int& ms, const unsigned int& sleepMs) :
+        PeriodicTask(ms, false), sleepMs(sleepMs), iterations(0) {
+    }
+    void execute() {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(sleepMs));
+        ++iterations;
+    }
+    unsigned int sleepMs;
+    volatile int iterations;
+};
+
+TEST(TaskTest, testCycleStatistics)
+{
+
+    boost::shared_ptr<SleepingTask> p(new SleepingTask(1, 5));
+    EXPECT_EQ(boost::uint64_t(0), p->getCycleStatistics().getCount());
+
+    ThreadedTaskExecutor executor;
+    executor.schedule(p);
+    while (p->iterations < 5) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+    }
+    p->cancel();
+    p->waitDone();
+
+    CycleStatistics statistics = p->getCycleStatistics();
+    EXPECT_EQ(boost::uint64_t(p->iterations), statistics.getCount());
+    // wall clock time, not cpu time
+    EXPECT_GE(statistics.getMin(), boost::uint64_t(5000));
+    EXPECT_LE(statistics.getMin(), statistics.getMean());
+    EXPECT_LE(statistics.getMean(), statistics.getMax());
+    EXPECT_GE(statistics.getQuantile(0.5), boost::uint64_t(5000));
+    // each iteration exceeds the cycle time of 1 ms
+    EXPECT_EQ(statistics.getCount(), statistics.getOverruns());
+
+}
+
+TEST(TaskTest, testOverrunPolicies)
+{
+
+    // 10 ms cycle, previous iteration planned for 1000 us
+    PeriodicTask::OverrunPolicy policies[] = { PeriodicTask::OVERRUN_SKIP,
+            PeriodicTask::OVERRUN_CATCH_UP, PeriodicTask::OVERRUN_SHIFT };
+    for (unsigned int i = 0; i < 3; ++i) {
+        CountingTask task(10, true);
+        EXPECT_EQ(PeriodicTask::OVERRUN_CATCH_UP, task.getOverrunPolicy());
+        CountingTask fixed(10, true, policies[i]);
+        EXPECT_EQ(policies[i], fixed.getOverrunPolicy());
+        // in time
+        EXPECT_EQ(boost::uint64_t(11000), fixed.nextStart(1000, 5000));
+        EXPECT_EQ(boost::uint64_t(11000), fixed.nextStart(1000, 11000));
+    }
+
+    // late by 2.5 cycles
+    EXPECT_EQ(boost::uint64_t(41000),
+            CountingTask(10, true, PeriodicTask::OVERRUN_SKIP).nextStart(1000,
+                    36000));
+    EXPECT_EQ(boost::uint64_t(11000),
+            CountingTask(10, true, PeriodicTask::OVERRUN_CATCH_UP).nextStart(
+                    1000, 36000));
+    EXPECT_EQ(boost::uint64_t(36000),
+            CountingTask(10, true, PeriodicTask::OVERRUN_SHIFT).nextStart(1000,
+                    36000));
+
+    // fixed delay ignores the policy
+    EXPECT_EQ(boost::uint64_t(46000),
+            CountingTask(10, false, PeriodicTask::OVERRUN_SKIP).nextStart(1000,
+                    36000));
+
+}
+
+TEST(TaskTest, testCancelWakesWait)
+{
+
+    boost::shared_ptr<CountingTask> p(new CountingTask(60000, true));
+    ThreadedTaskExecutor executor;
+    executor.schedule(p);
+    while (p->iterations < 1) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+    }
+    // give the task time to start waiting for the next iteration
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+
+    const boost::uint64_t start = rsc::misc::currentTimeMicros();
+    p->cancel();
+    p->waitDone();
+    EXPECT_LT(rsc::misc::currentTimeMicros() - start, boost::uint64_t(1000000));
+    EXPECT_EQ(1, p->iterations);
+
+}
+
+TEST(TaskTest, testFirstIterationWaits)
+{
+
+    boost::shared_ptr<CountingTask> p(new CountingTask(200, true));
+    ThreadedTaskExecutor executor;
+    executor.schedule(p);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+    EXPECT_EQ(1, p->iterations);
+    p->cancel();
+    p->waitDone();
+
+}
@@ -0,0 +1,152 @@
+/* ============================================================
+ *
+ * This file is a part of RSC project
+ *
+ * Copyright (C) 2026 by Johannes Wienke <jwienke at techfak dot uni-bielefeld dot de>
+ *
+ * This file may be licensed under the terms of the
+ * GNU Lesser General Public License Version 3 (the ``LGPL''),
+ * or (at your option) any later version.
+ *
+ * Software distributed under the License is distributed
+ * on an ``AS IS'' basis, WITHOUT WARRANTY OF ANY KIND, either
+ * express or implied. See the LGPL for the specific language
+ * governing rights and limitations.
+ *
+ * You should have received a copy of the LGPL along with this
+ * program. If not, go to http://www.gnu.org/licenses/lgpl.html
+ * or write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The development of this software was supported by:
+ *   CoR-Lab, Research Institute for Cognition and Robotics
+ *     Bielefeld University
+ *
+ * ============================================================ */
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include "rsc/misc/langutils.h"
+#include "rsc/threading/TimerWheel.h"
+
+using namespace std;
+using namespace rsc::threading;
+using namespace rsc::misc;
+using namespace testing;
+
+/**
+ * Records when timers expired.
+ *
+ * @author jwienke
+ */
+class ExpiryRecorder {
+public:
+
+    void expired(const int& id) {
+        boost::mutex::scoped_lock lock(mutex);
+        ids.push_back(id);
+        times.push_back(currentTimeMicros());
+        condition.notify_all();
+    }
+
+    void waitFor(const size_t& count) {
+        boost::mutex::scoped_lock lock(mutex);
+        while (ids.size() < count) {
+            condition.wait(lock);
+        }
+    }
+
+    boost::mutex mutex;
+    boost::condition condition;
+    vector<int> ids;
+    vector<boost::uint64_t> times;
+
+};
+
+TEST(TimerWheelTest, testInvalidArguments) {
+
+    EXPECT_THROW(TimerWheel(0, 10), invalid_argument);
+    EXPECT_THROW(TimerWheel(10, 0), invalid_argument);
+
+}
+
+TEST(TimerWheelTest, testOrderAndPrecision) {
+
+    // few slots so that timers wrap around the wheel
+    TimerWheel wheel(2000, 8);
+    EXPECT_EQ(boost::uint64_t(2000), wheel.getResolution());
+    ExpiryRecorder recorder;
+
+    const boost::uint64_t start = currentTimeMicros();
+    const boost::uint64_t delays[] = { 90000, 10000, 50000, 0, 30000 };
+    const int expectedOrder[] = { 3, 1, 4, 2, 0 };
+    for (int i = 0; i < 5; ++i) {
+        wheel.schedule(boost::bind(&ExpiryRecorder::expired, &recorder, i),
+                delays[i]);
+    }
+    EXPECT_EQ(size_t(5), wheel.getPendingCount());
+
+    recorder.waitFor(5);
+    EXPECT_EQ(size_t(0), wheel.getPendingCount());
+    for (int i = 0; i < 5; ++i) {
+        const int id = expectedOrder[i];
+        EXPECT_EQ(id, recorder.ids[i]);
+        EXPECT_GE(recorder.times[i], start + delays[id]);
+        EXPECT_LE(recorder.times[i], start + delays[id] + 100000);
+    }
+
+}
+
+TEST(TimerWheelTest, testExpireAll) {
+
+    ExpiryRecorder recorder;
+    {
+        TimerWheel wheel;
+        wheel.schedule(boost::bind(&ExpiryRecorder::expired, &recorder, 1),
+                10000000);
+        wheel.schedule(boost::bind(&ExpiryRecorder::expired, &recorder, 2),
+                20000000);
+        wheel.expireAll();
+        EXPECT_EQ(size_t(0), wheel.getPendingCount());
+        EXPECT_EQ(size_t(2), recorder.ids.size());
+
+        // destruction drops pending timers
+        wheel.schedule(boost::bind(&ExpiryRecorder::expired, &recorder, 3),
+                10000000);
+    }
+    EXPECT_EQ(size_t(2), recorder.ids.size());
+
+}
+
+TEST(TimerWheelTest, testLevels) {
+
+    // three levels of four slots cover 64 ticks, longer delays stay in the
+    // highest level for several rotations
+    TimerWheel wheel(1000, 4, 3);
+    ExpiryRecorder recorder;
+
+    srand(42);
+    const int numTimers = 100;
+    vector<boost::uint64_t> delays;
+    const boost::uint64_t start = currentTimeMicros();
+    for (int i = 0; i < numTimers; ++i) {
+        delays.push_back((rand() % 300) * 1000);
+        wheel.schedule(boost::bind(&ExpiryRecorder::expired, &recorder, i),
+                delays.back());
+    }
+
+    recorder.waitFor(numTimers);
+    for (int i = 0; i < numTimers; ++i) {
+        const int id = recorder.ids[i];
+        EXPECT_GE(recorder.times[i], start + delays[id]) << "timer " << id;
+        EXPECT_LE(recorder.times[i], start + delays[id] + 100000)
+                << "timer " << id;
+    }
+
+}